@@ -6,7 +6,9 @@
 
 #pragma once
 
+#include <algorithm>
 #include <any>
+#include <charconv>
 #include <cstddef>
 #include <cstdint>
 #include <cstring>
@@ -15,6 +17,7 @@
 #include <iostream>
 #include <memory>
 #include <string>
+#include <string_view>
 #include <map>
 #include <stack>
 #include <fstream>
@@ -29,6 +32,8 @@
 #include "expected.hpp"
 #include "concepts.hpp"
 #include "error.hpp"
+#include "inline_storage.hpp"
+#include "ordered_map.hpp"
 
 /**
  * @brief the namespace for luco
@@ -51,6 +56,25 @@ namespace luco
 		unknown,
 	};
 
+	/**
+	 * @struct fixed_string
+	 * @brief a string literal usable as a template argument
+	 */
+	template<size_t size>
+	struct fixed_string {
+			char data[size] = {};
+
+			consteval fixed_string(const char (&text)[size]) noexcept
+			{
+				std::copy_n(text, size, data);
+			}
+
+			constexpr std::string_view view() const noexcept
+			{
+				return std::string_view(data, size - 1);
+			}
+	};
+
 	/**
 	 * @enum node_type
 	 * @brief this enum can be used to explicitly make a node that's either an object, array or value
@@ -92,6 +116,11 @@ namespace luco
 	 */
 	class value {
 		private:
+			friend class schema;
+
+			template<typename visitor_t>
+			friend decltype(auto) visit(visitor_t&& visitor, const class node& node);
+
 			using value_type_variant  = std::variant<std::string, double, int64_t, bool, null_type, monostate>;
 			value_type_variant _value = monostate();
 			value_type	   _type  = value_type::none;
@@ -146,11 +175,31 @@ namespace luco
 				{
 					case value_type::double_t:
 					case value_type::number:
-						_value = std::stod(val);
+					{
+						double number  = 0;
+						auto [ptr, ec] = std::from_chars(val.data(), val.data() + val.size(), number);
+						if (ec != std::errc() || ptr != val.data() + val.size() || val.empty())
+						{
+							_type  = value_type::none;
+							_value = monostate();
+							return unexpected(error(error_type::wrong_type, "'{}' isn't a double", val));
+						}
+						_value = number;
 						break;
+					}
 					case value_type::integer:
-						_value = std::stoll(val);
+					{
+						int64_t integer = 0;
+						auto [ptr, ec]	= std::from_chars(val.data(), val.data() + val.size(), integer);
+						if (ec != std::errc() || ptr != val.data() + val.size() || val.empty())
+						{
+							_type  = value_type::none;
+							_value = monostate();
+							return unexpected(error(error_type::wrong_type, "'{}' isn't an integer", val));
+						}
+						_value = integer;
 						break;
+					}
 					case value_type::string:
 						_value = val;
 						break;
@@ -174,6 +223,66 @@ namespace luco
 				return monostate();
 			}
 
+			static constexpr size_t double_chars = 400;
+
+			/**
+			 * @brief writes a double as stringify() does: the shortest digits that read back as the same double,
+			 * without an exponent since the parser reads '1e+20' as a string, and with a '.' so it stays a double
+			 * @return the text written at the start of buffer
+			 */
+			static std::string_view write_double(double number, char (&buffer)[double_chars]) noexcept
+			{
+				auto [end, ec] = std::to_chars(buffer, buffer + double_chars - 2, number, std::chars_format::fixed);
+				if (ec != std::errc())
+				{
+					end = std::to_chars(buffer, buffer + double_chars - 2, number).ptr;
+				}
+				if (std::string_view(buffer, end).find_first_of(".en") == std::string_view::npos)
+				{
+					*end++ = '.';
+					*end++ = '0';
+				}
+
+				return std::string_view(buffer, end);
+			}
+
+			/**
+			 * @brief the error of casting the value to another type, the value is written inline without
+			 * allocating
+			 */
+			error cast_error(const char* expected) const noexcept
+			{
+				const char* found = this->is_string()	 ? "string"
+						    : this->is_boolean() ? "boolean"
+						    : this->is_null()	 ? "null"
+						    : this->is_double()	 ? "double"
+						    : this->is_integer() ? "integer"
+						    : this->is_empty()	 ? "none"
+									 : "unknown";
+				if (this->is_string())
+				{
+					return error::value_cast(std::get<std::string>(_value), found, expected);
+				}
+
+				// the same text as stringify()
+				char		 text[double_chars];
+				std::string_view written;
+				if (this->is_double())
+				{
+					written = value::write_double(std::get<double>(_value), text);
+				}
+				else if (this->is_integer())
+				{
+					written = std::string_view(text, std::to_chars(text, text + sizeof(text), std::get<int64_t>(_value)).ptr);
+				}
+				else if (this->is_boolean() || this->is_null())
+				{
+					written = this->is_null() ? "null" : std::get<bool>(_value) ? "true" : "false";
+				}
+
+				return error::value_cast(written, found, expected);
+			}
+
 		public:
 			/**
 			 * @brief constructor for luco::value
@@ -186,6 +295,14 @@ namespace luco
 				this->set_state(val);
 			}
 
+			/**
+			 * @brief constructor for luco::value that takes the string without copying it
+			 * @param val luco string value to be set
+			 */
+			value(std::string&& val) noexcept : _value(std::move(val)), _type(value_type::string)
+			{
+			}
+
 			/**
 			 * @brief copy constructor for luco::value
 			 * @param other luco::value to be copied
@@ -349,9 +466,7 @@ namespace luco
 			{
 				if (not this->is_string())
 				{
-					return unexpected(error(error_type::wrong_type,
-								"wrong type: trying to cast the value '{}' which is a '{}' to 'string'",
-								this->stringify(), this->type_name()));
+					return unexpected(this->cast_error("string"));
 				}
 
 				return std::get<std::string>(_value);
@@ -366,9 +481,7 @@ namespace luco
 			{
 				if (not this->is_number())
 				{
-					return unexpected(error(error_type::wrong_type,
-								"wrong type: trying to cast the value '{}' which is a '{}' to 'number'",
-								this->stringify(), this->type_name()));
+					return unexpected(this->cast_error("number"));
 				}
 
 				if (this->is_double())
@@ -390,9 +503,7 @@ namespace luco
 			{
 				if (not this->is_integer())
 				{
-					return unexpected(error(error_type::wrong_type,
-								"wrong type: trying to cast the value '{}' which is a '{}' to 'integer'",
-								this->stringify(), this->type_name()));
+					return unexpected(this->cast_error("integer"));
 				}
 
 				return std::get<int64_t>(_value);
@@ -407,9 +518,7 @@ namespace luco
 			{
 				if (not this->is_double())
 				{
-					return unexpected(error(error_type::wrong_type,
-								"wrong type: trying to cast the value '{}' which is a '{}' to 'double'",
-								this->stringify(), this->type_name()));
+					return unexpected(this->cast_error("double"));
 				}
 
 				return std::get<double>(_value);
@@ -424,9 +533,7 @@ namespace luco
 			{
 				if (not this->is_boolean())
 				{
-					return unexpected(error(error_type::wrong_type,
-								"wrong type: trying to cast the value '{}' which is a '{}' to 'boolean'",
-								this->stringify(), this->type_name()));
+					return unexpected(this->cast_error("boolean"));
 				}
 
 				return std::get<bool>(_value);
@@ -441,9 +548,7 @@ namespace luco
 			{
 				if (not this->is_null())
 				{
-					return unexpected(error(error_type::wrong_type,
-								"wrong type: trying to cast the value '{}' which is a '{}' to 'null'",
-								this->stringify(), this->type_name()));
+					return unexpected(this->cast_error("null"));
 				}
 
 				return std::get<null_type>(_value);
@@ -460,7 +565,7 @@ namespace luco
 				auto ok = this->try_as_string();
 				if (not ok)
 				{
-					throw ok.error();
+					raise_error(ok.error());
 				}
 
 				return ok.value();
@@ -477,7 +582,7 @@ namespace luco
 				auto ok = this->try_as_number();
 				if (not ok)
 				{
-					throw ok.error();
+					raise_error(ok.error());
 				}
 
 				return ok.value();
@@ -494,7 +599,7 @@ namespace luco
 				auto ok = this->try_as_integer();
 				if (not ok)
 				{
-					throw ok.error();
+					raise_error(ok.error());
 				}
 
 				return ok.value();
@@ -511,7 +616,7 @@ namespace luco
 				auto ok = this->try_as_double();
 				if (not ok)
 				{
-					throw ok.error();
+					raise_error(ok.error());
 				}
 
 				return ok.value();
@@ -528,7 +633,7 @@ namespace luco
 				auto ok = this->try_as_boolean();
 				if (not ok)
 				{
-					throw ok.error();
+					raise_error(ok.error());
 				}
 
 				return ok.value();
@@ -545,7 +650,7 @@ namespace luco
 				auto ok = this->try_as_null();
 				if (not ok)
 				{
-					throw ok.error();
+					raise_error(ok.error());
 				}
 
 				return ok.value();
@@ -559,46 +664,8 @@ namespace luco
 			{
 				if (this->is_double())
 				{
-					std::string str			 = std::to_string(std::get<double>(_value));
-
-					auto	    pop_zeros_at_the_end = [&]()
-					{
-						bool found_zero = false;
-						for (size_t i = str.size() - 1;; i--)
-						{
-							if (str[i] == '0' && not found_zero)
-							{
-								found_zero = true;
-							}
-							else if (str[i] == '0' && found_zero)
-							{
-								str.pop_back();
-							}
-							else if (found_zero)
-							{
-								str.pop_back();
-								found_zero = false;
-							}
-							else
-							{
-								break;
-							}
-
-							if (i == 0)
-							{
-								break;
-							}
-						}
-
-						if (not str.empty() && str.back() == '.')
-						{
-							str += "0";
-						}
-					};
-
-					pop_zeros_at_the_end();
-
-					return str;
+					char buffer[double_chars];
+					return std::string(value::write_double(std::get<double>(_value), buffer));
 				}
 				else if (this->is_integer())
 				{
@@ -666,7 +733,6 @@ namespace luco
 	using object_pairs = std::initializer_list<std::pair<std::string, std::any>>;
 	using array_values = std::initializer_list<std::any>;
 
-	using luco_array   = std::vector<class node>;
 	using luco_node	   = std::variant<std::shared_ptr<class value>, std::shared_ptr<luco::array>, std::shared_ptr<luco::object>>;
 
 	/**
@@ -675,6 +741,12 @@ namespace luco
 	 */
 	class node {
 		private:
+			friend class schema;
+			friend class tree_walk;
+
+			template<typename visitor_t>
+			friend decltype(auto) visit(visitor_t&& visitor, const class node& node);
+
 			luco_node _node;
 
 		protected:
@@ -687,8 +759,14 @@ namespace luco
 			template<typename container_or_node_type>
 			constexpr void setting_allowed_node_type(const container_or_node_type& node_value) noexcept;
 
-			template<is_allowed_value_type T>
-			expected<T, error> access_value(std::function<expected<T, error>(std::shared_ptr<class value>)> fun) const;
+			/**
+			 * @brief casts the value the node is holding with a cast of luco::value, inlined instead of going
+			 * through a std::function or copying the shared_ptr
+			 */
+			template<is_allowed_value_type T, typename cast_t>
+			expected<T, error> access_value(const cast_t& cast) const noexcept;
+
+			const char*	   type_literal() const noexcept;
 
 		public:
 			/**
@@ -1007,6 +1085,22 @@ namespace luco
 			 */
 			class node&						  at(const size_t array_index) const;
 
+			/**
+			 * @brief access the node at an object key known at compile time. the key is looked up as a
+			 * std::string_view of a fixed size and the object isn't shared_ptr copied, so nothing is allocated,
+			 * measured or reference counted per lookup
+			 * @detail @cpp
+			 * for (const auto& server : servers)
+			 * {
+			 *	int64_t port = server.at<"port">().as_integer();
+			 * }
+			 * @ecpp
+			 * @return luco::node& at the key
+			 * @see at()
+			 */
+			template<fixed_string object_key>
+			class node& at() const;
+
 			/**
 			 * @brief access the node at the specified object key
 			 * @param object_key luco key to access in an object
@@ -1059,6 +1153,14 @@ namespace luco
 			 */
 			expected<std::reference_wrapper<luco::node>, luco::error> try_at(const size_t array_index) const noexcept;
 
+			/**
+			 * @brief access the node at an object key known at compile time
+			 * @return either std::reference_wrapper<luco::node> if the node was found or luco::error if not
+			 * @see at<>()
+			 */
+			template<fixed_string object_key>
+			expected<std::reference_wrapper<luco::node>, luco::error> try_at() const noexcept;
+
 			/**
 			 * @brief set a node with a container_or_node_type
 			 * @param node_value value to be set
@@ -1098,11 +1200,23 @@ namespace luco
 			 */
 			class node			  operator+(const node& other_node);
 
-			void				  dump_to_json(const std::function<void(std::string)> out_func = __print,
-								       const std::pair<char, size_t>& indent_conf = {' ', 4}, size_t indent = 0) const;
+			/**
+			 * @brief write luco::node as JSON through a sink
+			 * @param out_func called with each piece of the output, any callable taking a std::string
+			 * @param indent_conf indentation config for writing {char, size}
+			 */
+			template<typename output_t = void (*)(const std::string&)>
+			void				  dump_to_json(const output_t& out_func = __print, const std::pair<char, size_t>& indent_conf = {' ', 4},
+								       size_t indent = 0) const;
 
-			void				  dump_to_luco(const std::function<void(std::string)> out_func = __print,
-								       const std::pair<char, size_t>& indent_conf = {' ', 4}, size_t indent = 0) const;
+			/**
+			 * @brief write luco::node as luco through a sink
+			 * @param out_func called with each piece of the output, any callable taking a std::string
+			 * @param indent_conf indentation config for writing {char, size}
+			 */
+			template<typename output_t = void (*)(const std::string&)>
+			void				  dump_to_luco(const output_t& out_func = __print, const std::pair<char, size_t>& indent_conf = {' ', 4},
+								       size_t indent = 0) const;
 
 			/**
 			 * @brief write luco::node to stdout
@@ -1128,7 +1242,31 @@ namespace luco
 			expected<class luco::node, error> add_value_to_array(const size_t index, const class value& value);
 			expected<class luco::node, error> add_node_to_array(const size_t index, const luco::node& node);
 	};
-	using luco_object = std::map<std::string, class node>;
+
+	// the number of keys and elements stored in an object or an array itself with LUCO_INLINE_CONTAINERS
+	inline constexpr size_t inline_keys	= 4;
+	inline constexpr size_t inline_elements = 4;
+
+#ifdef LUCO_INLINE_CONTAINERS
+	template<typename T, typename arena_t>
+	using container_allocator = inline_allocator<T, arena_t>;
+#else
+	template<typename T, typename arena_t>
+	using container_allocator = std::allocator<T>;
+#endif
+
+#ifdef LUCO_ORDERED_OBJECTS
+	// a slot for every entry and one for the pointers to them
+	using object_arena = inline_arena<std::max(sizeof(std::pair<std::string, class node>), sizeof(void*) * inline_keys), inline_keys + 1>;
+	using luco_object  = ordered_map<class node, container_allocator<std::pair<std::string, class node>, object_arena>>;
+#else
+	// a tree node is an entry and at most four pointers
+	using object_arena = inline_arena<sizeof(std::pair<const std::string, class node>) + 4 * sizeof(void*), inline_keys>;
+	using luco_object  = std::map<std::string, class node, std::less<>, container_allocator<std::pair<const std::string, class node>, object_arena>>;
+#endif
+
+	using array_arena = inline_arena<sizeof(class node) * inline_elements, 1>;
+	using luco_array  = std::vector<class node, container_allocator<class node, array_arena>>;
 
 	/**
 	 * @class object
@@ -1136,14 +1274,40 @@ namespace luco
 	 */
 	class object {
 		private:
+#ifdef LUCO_INLINE_CONTAINERS
+			object_arena _arena; // destroyed after the keys allocated from it
+#endif
 			luco_object _object;
 
 		public:
 			/**
 			 * @brief constructor for luco::object
 			 */
-			explicit object() : _object(luco_object{})
+#ifdef LUCO_INLINE_CONTAINERS
+			explicit object() : _object(luco_object::allocator_type(&_arena))
+			{
+#ifdef LUCO_ORDERED_OBJECTS
+				_object.reserve(inline_keys);
+#endif
+			}
+#else
+			explicit object()
+			{
+			}
+#endif
+
+			/**
+			 * @brief copy constructor for luco::object, with LUCO_INLINE_CONTAINERS the keys are copied into its own storage
+			 */
+			object(const object& other) : object()
 			{
+				_object = other._object;
+			}
+
+			object& operator=(const object& other)
+			{
+				_object = other._object;
+				return *this;
 			}
 
 			/**
@@ -1154,7 +1318,7 @@ namespace luco
 			 */
 			luco::node& insert(const std::string& key, const class node& element)
 			{
-				return _object[key] = element;
+				return _object.insert_or_assign(key, element).first->second;
 			}
 
 			/**
@@ -1210,7 +1374,7 @@ namespace luco
 			 * @brief find a key
 			 * @return iterator of the found key found or end()
 			 */
-			luco_object::iterator find(const std::string& key)
+			luco_object::iterator find(std::string_view key)
 			{
 				return _object.find(key);
 			}
@@ -1237,11 +1401,17 @@ namespace luco
 			 * @brief access specified key *with* bounds checking
 			 * @param key to be accessed
 			 * @return a reference to the luco::node associated to the key
-			 * @throw std::out_of_range if the container doesn't have the key
+			 * @throw luco::error if the container doesn't have the key
 			 */
 			class luco::node& at(const std::string& key)
 			{
-				return _object.at(key);
+				auto itr = _object.find(key);
+				if (itr == _object.end())
+				{
+					raise_error(error::key_not_found(key));
+				}
+
+				return itr->second;
 			}
 
 			/**
@@ -1261,16 +1431,41 @@ namespace luco
 	 */
 	class array {
 		private:
+#ifdef LUCO_INLINE_CONTAINERS
+			array_arena _arena; // destroyed after the elements allocated from it
+#endif
 			luco_array _array;
 
 		public:
-			explicit array(const luco_array& arr) noexcept : _array(arr)
+			explicit array(const luco_array& arr) : array()
 			{
+				_array = arr;
 			}
 
+#ifdef LUCO_INLINE_CONTAINERS
+			explicit array() noexcept : _array(luco_array::allocator_type(&_arena))
+			{
+				_array.reserve(inline_elements);
+			}
+#else
 			explicit array() noexcept
 			{
 			}
+#endif
+
+			/**
+			 * @brief copy constructor for luco::array, with LUCO_INLINE_CONTAINERS the elements are copied into its own storage
+			 */
+			array(const array& other) : array()
+			{
+				_array = other._array;
+			}
+
+			array& operator=(const array& other)
+			{
+				_array = other._array;
+				return *this;
+			}
 
 			void push_back(const class node& element)
 			{
@@ -1324,7 +1519,12 @@ namespace luco
 
 			class luco::node& at(size_t i)
 			{
-				return _array.at(i);
+				if (i >= _array.size())
+				{
+					raise_error(error::index_not_found(i));
+				}
+
+				return _array[i];
 			}
 
 			class luco::node& operator[](size_t i)
@@ -1340,6 +1540,10 @@ namespace luco
 	{
 	}
 
+	node::node(const luco_node& n) : _node(n)
+	{
+	}
+
 	node::node(enum node_type type)
 	{
 		switch (type)
@@ -1533,8 +1737,8 @@ namespace luco
 			}
 			else
 			{
-				throw error(error_type::wrong_type,
-					    std::string("unknown type given to luco::node constructor: ") + any_value.type().name());
+				raise_error(error(error_type::wrong_type,
+					    std::string("unknown type given to luco::node constructor: ") + any_value.type().name()));
 			}
 		}
 	}
@@ -1644,8 +1848,7 @@ namespace luco
 	{
 		if (not this->is_value())
 		{
-			return unexpected(
-			    error(error_type::wrong_type, "wrong type: trying to cast a '{}' node to a value", this->type_name()));
+			return unexpected(error::node_cast(this->type_literal(), "a value"));
 		}
 
 		return std::get<std::shared_ptr<class value>>(_node);
@@ -1655,8 +1858,7 @@ namespace luco
 	{
 		if (not this->is_array())
 		{
-			return unexpected(
-			    error(error_type::wrong_type, "wrong type: trying to cast a '{} node to an array", this->type_name()));
+			return unexpected(error::node_cast(this->type_literal(), "an array"));
 		}
 
 		return std::get<std::shared_ptr<luco::array>>(_node);
@@ -1666,8 +1868,7 @@ namespace luco
 	{
 		if (not this->is_object())
 		{
-			return unexpected(
-			    error(error_type::wrong_type, "wrong type: trying to cast a '{}' node to an object", this->type_name()));
+			return unexpected(error::node_cast(this->type_literal(), "an object"));
 		}
 
 		return std::get<std::shared_ptr<luco::object>>(_node);
@@ -1678,7 +1879,7 @@ namespace luco
 		auto ok = this->try_as_value();
 		if (not ok)
 		{
-			throw ok.error();
+			raise_error(ok.error());
 		}
 
 		return ok.value();
@@ -1689,7 +1890,7 @@ namespace luco
 		auto ok = this->try_as_array();
 		if (not ok)
 		{
-			throw ok.error();
+			raise_error(ok.error());
 		}
 
 		return ok.value();
@@ -1700,7 +1901,7 @@ namespace luco
 		auto ok = this->try_as_object();
 		if (not ok)
 		{
-			throw ok.error();
+			raise_error(ok.error());
 		}
 
 		return ok.value();
@@ -1788,7 +1989,7 @@ namespace luco
 		}
 	}
 
-	std::string node::type_name() const noexcept
+	const char* node::type_literal() const noexcept
 	{
 		if (this->is_value())
 		{
@@ -1804,70 +2005,51 @@ namespace luco
 		}
 	}
 
-	template<is_allowed_value_type T>
-	expected<T, error> node::access_value(std::function<expected<T, error>(std::shared_ptr<class value>)> fun) const
+	std::string node::type_name() const noexcept
+	{
+		return this->type_literal();
+	}
+
+	template<is_allowed_value_type T, typename cast_t>
+	expected<T, error> node::access_value(const cast_t& cast) const noexcept
 	{
-		auto val = this->try_as_value();
-		if (not val)
+		auto val = std::get_if<std::shared_ptr<class value>>(&_node);
+		if (val == nullptr)
 		{
-			return val.error();
+			return unexpected(error::node_cast(this->type_literal(), "a value"));
 		}
 
-		return fun(val.value());
+		return cast(**val);
 	}
 
 	expected<std::string, error> node::try_as_string() const noexcept
 	{
-		auto cast_fn = [](std::shared_ptr<class luco::value> val) -> expected<std::string, error>
-		{
-			return val->try_as_string();
-		};
-		return this->access_value<std::string>(cast_fn);
+		return this->access_value<std::string>([](class value& val) { return val.try_as_string(); });
 	}
 
 	expected<int64_t, error> node::try_as_integer() const noexcept
 	{
-		auto cast_func = [](std::shared_ptr<class luco::value> val) -> expected<int64_t, error>
-		{
-			return val->try_as_integer();
-		};
-		return this->access_value<int64_t>(cast_func);
+		return this->access_value<int64_t>([](class value& val) { return val.try_as_integer(); });
 	}
 
 	expected<double, error> node::try_as_double() const noexcept
 	{
-		auto cast_func = [](std::shared_ptr<class luco::value> val) -> expected<double, error>
-		{
-			return val->try_as_double();
-		};
-		return this->access_value<double>(cast_func);
+		return this->access_value<double>([](class value& val) { return val.try_as_double(); });
 	}
 
 	expected<double, error> node::try_as_number() const noexcept
 	{
-		auto cast_func = [](std::shared_ptr<class luco::value> val) -> expected<double, error>
-		{
-			return val->try_as_number();
-		};
-		return this->access_value<double>(cast_func);
+		return this->access_value<double>([](class value& val) { return val.try_as_number(); });
 	}
 
 	expected<bool, error> node::try_as_boolean() const noexcept
 	{
-		auto cast_func = [](std::shared_ptr<class luco::value> val) -> expected<bool, error>
-		{
-			return val->try_as_boolean();
-		};
-		return this->access_value<bool>(cast_func);
+		return this->access_value<bool>([](class value& val) { return val.try_as_boolean(); });
 	}
 
 	expected<null_type, error> node::try_as_null() const noexcept
 	{
-		auto cast_func = [](std::shared_ptr<class luco::value> val) -> expected<null_type, error>
-		{
-			return val->try_as_null();
-		};
-		return this->access_value<null_type>(cast_func);
+		return this->access_value<null_type>([](class value& val) { return val.try_as_null(); });
 	}
 
 	std::string node::as_string() const
@@ -1875,7 +2057,7 @@ namespace luco
 		auto ok = this->try_as_string();
 		if (not ok)
 		{
-			throw ok.error();
+			raise_error(ok.error());
 		}
 		return ok.value();
 	}
@@ -1885,7 +2067,7 @@ namespace luco
 		auto ok = this->try_as_integer();
 		if (not ok)
 		{
-			throw ok.error();
+			raise_error(ok.error());
 		}
 		return ok.value();
 	}
@@ -1895,7 +2077,7 @@ namespace luco
 		auto ok = this->try_as_double();
 		if (not ok)
 		{
-			throw ok.error();
+			raise_error(ok.error());
 		}
 		return ok.value();
 	}
@@ -1905,7 +2087,7 @@ namespace luco
 		auto ok = this->try_as_number();
 		if (not ok)
 		{
-			throw ok.error();
+			raise_error(ok.error());
 		}
 		return ok.value();
 	}
@@ -1915,7 +2097,7 @@ namespace luco
 		auto ok = this->try_as_boolean();
 		if (not ok)
 		{
-			throw ok.error();
+			raise_error(ok.error());
 		}
 		return ok.value();
 	}
@@ -1925,7 +2107,7 @@ namespace luco
 		auto ok = this->try_as_null();
 		if (not ok)
 		{
-			throw ok.error();
+			raise_error(ok.error());
 		}
 		return ok.value();
 	}
@@ -1985,7 +2167,7 @@ namespace luco
 		auto itr = obj->find(object_key);
 		if (itr == obj->end())
 		{
-			throw error(error_type::key_not_found, std::format("key: '{}' not found", object_key));
+			raise_error(error::key_not_found(object_key));
 		}
 		return itr->second;
 	}
@@ -1995,7 +2177,7 @@ namespace luco
 		auto arr = this->as_array();
 		if (array_index >= arr->size())
 		{
-			throw error(error_type::key_not_found, "index: '{}' not found", array_index);
+			raise_error(error::index_not_found(array_index));
 		}
 
 		return arr->at(array_index);
@@ -2011,7 +2193,7 @@ namespace luco
 		auto itr = obj.value()->find(object_key);
 		if (itr == obj.value()->end())
 		{
-			return unexpected(error(error_type::key_not_found, std::format("key: '{}' not found", object_key)));
+			return unexpected(error::key_not_found(object_key));
 		}
 
 		return std::ref(itr->second);
@@ -2019,13 +2201,43 @@ namespace luco
 
 	expected<std::reference_wrapper<luco::node>, luco::error> node::try_at(const size_t array_index) const noexcept
 	{
-		auto arr = this->try_as_array();
-		if (not arr)
+		auto arr = std::get_if<std::shared_ptr<luco::array>>(&_node);
+		if (arr == nullptr || array_index >= (*arr)->size())
+		{
+			return unexpected(error::index_not_found(array_index));
+		}
+
+		return std::ref((**arr)[array_index]);
+	}
+
+	template<fixed_string object_key>
+	class node& node::at() const
+	{
+		auto ok = this->try_at<object_key>();
+		if (not ok)
 		{
-			return unexpected(error(error_type::key_not_found, "index: '{}' not found", array_index));
+			raise_error(ok.error());
 		}
 
-		return std::ref(arr.value()->at(array_index));
+		return ok.value().get();
+	}
+
+	template<fixed_string object_key>
+	expected<std::reference_wrapper<luco::node>, luco::error> node::try_at() const noexcept
+	{
+		auto obj = std::get_if<std::shared_ptr<luco::object>>(&_node);
+		if (obj == nullptr)
+		{
+			return unexpected(error::node_cast(this->type_literal(), "an object"));
+		}
+
+		auto itr = (*obj)->find(object_key.view());
+		if (itr == (*obj)->end())
+		{
+			return unexpected(error::key_not_found(object_key.view()));
+		}
+
+		return std::ref(itr->second);
 	}
 
 	template<typename container_or_node_type>
@@ -2049,7 +2261,7 @@ namespace luco
 	{
 		if (not this->is_object())
 		{
-			throw error(error_type::wrong_type, "wrong type: trying to insert pairs to a non-object");
+			raise_error(error(error_type::wrong_type, "wrong type: trying to insert pairs to a non-object"));
 		}
 
 		std::string key;
@@ -2082,7 +2294,7 @@ namespace luco
 	{
 		if (not this->is_array())
 		{
-			throw error(error_type::wrong_type, "wrong type: trying to insert pairs to a non-array");
+			raise_error(error(error_type::wrong_type, "wrong type: trying to insert pairs to a non-array"));
 		}
 
 		auto vector	 = this->as_array();
@@ -2112,7 +2324,7 @@ namespace luco
 	{
 		if (this->type() != other_node.type())
 		{
-			throw error(error_type::wrong_type, "trying to + two nodes with different types");
+			raise_error(error(error_type::wrong_type, "trying to + two nodes with different types"));
 		}
 
 		if (this->is_object())
@@ -2158,8 +2370,8 @@ namespace luco
 			}
 			else
 			{
-				throw error(error_type::wrong_type,
-					    "trying to + two nodes with values that are neither a number nor string");
+				raise_error(error(error_type::wrong_type,
+					    "trying to + two nodes with values that are neither a number nor string"));
 			}
 
 			return new_node;
@@ -2172,8 +2384,8 @@ namespace luco
 		this->setting_allowed_node_type(node_value);
 	}
 
-	void node::dump_to_json(const std::function<void(std::string)> out_func, const std::pair<char, size_t>& indent_conf,
-				size_t indent) const
+	template<typename output_t>
+	void node::dump_to_json(const output_t& out_func, const std::pair<char, size_t>& indent_conf, size_t indent) const
 	{
 		using node_or_value = std::variant<std::shared_ptr<class value>, luco::node>;
 
@@ -2244,8 +2456,8 @@ namespace luco
 		}
 	}
 
-	void node::dump_to_luco(const std::function<void(std::string)> out_func, const std::pair<char, size_t>& indent_conf,
-				size_t indent) const
+	template<typename output_t>
+	void node::dump_to_luco(const output_t& out_func, const std::pair<char, size_t>& indent_conf, size_t indent) const
 	{
 		using node_or_value = std::variant<std::shared_ptr<class value>, luco::node>;
 
@@ -0,0 +1,248 @@
+/*
+ * Copyright: 2025 nodeluna
+ * SPDX-License-Identifier: Apache-2.0
+ * repository: https://github.com/nodeluna/luco
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <condition_variable>
+#include <coroutine>
+#include <cstddef>
+#include <deque>
+#include <filesystem>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+#include "api.hpp"
+#include "parser.hpp"
+#include "expected.hpp"
+#include "error.hpp"
+
+/**
+ * @brief the namespace for luco
+ */
+namespace luco
+{
+	/**
+	 * @class executor
+	 * @brief where luco::async_parse() runs its jobs. derive from it to run them on an event loop
+	 */
+	class executor {
+		public:
+			/**
+			 * @brief runs the job at some point, from any thread
+			 */
+			virtual void post(std::function<void()> job) = 0;
+
+			virtual ~executor() = default;
+	};
+
+	/**
+	 * @class inline_executor
+	 * @brief runs every job right away on the thread posting it
+	 */
+	class inline_executor : public executor {
+		public:
+			inline void post(std::function<void()> job) override;
+
+			/**
+			 * @return the instance used when no executor is given
+			 */
+			inline static inline_executor& instance() noexcept;
+	};
+
+	/**
+	 * @class thread_pool
+	 * @brief runs jobs on a fixed number of threads. jobs already posted are finished before it's destroyed
+	 */
+	class thread_pool : public executor {
+		private:
+			std::mutex			  _mutex;
+			std::condition_variable		  _ready;
+			std::deque<std::function<void()>> _jobs;
+			std::vector<std::thread>	  _threads;
+			bool				  _stopping = false;
+
+		public:
+			/**
+			 * @brief constructor for luco::thread_pool
+			 * @param threads the number of threads
+			 */
+			inline explicit thread_pool(size_t threads);
+			thread_pool(const thread_pool&) = delete;
+
+			inline void post(std::function<void()> job) override;
+
+			/**
+			 * @return the pool reading files for luco::async_parse() when no executor is given
+			 */
+			inline static thread_pool& io();
+
+			/**
+			 * @return the pool helping luco::for_each() and the other parallel algorithms, one thread per core
+			 */
+			inline static thread_pool& compute();
+
+			inline ~thread_pool();
+	};
+
+	/**
+	 * @class parse_awaitable
+	 * @brief the awaitable returned by luco::async_parse(). the file is read and parsed on the I/O executor, then the
+	 * awaiting coroutine is resumed through the resume executor with expected<luco::node, luco::error>
+	 */
+	class parse_awaitable {
+		private:
+			std::filesystem::path			   _path;
+			executor&				   _io;
+			executor&				   _resume_on;
+			std::optional<expected<luco::node, error>> _result;
+
+		public:
+			inline parse_awaitable(const std::filesystem::path& path, executor& io, executor& resume_on);
+
+			inline bool			   await_ready() const noexcept;
+			inline void			   await_suspend(std::coroutine_handle<> awaiting);
+			inline expected<luco::node, error> await_resume();
+	};
+
+	/**
+	 * @brief parses a file without blocking the awaiting coroutine. the file is read and parsed on thread_pool::io()
+	 * and the coroutine resumes on that thread
+	 * @detail @cpp
+	 * luco::expected<luco::node, luco::error> node = co_await luco::async_parse("config.luco");
+	 * @ecpp
+	 */
+	inline parse_awaitable async_parse(const std::filesystem::path& path);
+
+	/**
+	 * @brief parses a file without blocking the awaiting coroutine
+	 * @param resume_on the executor resuming the awaiting coroutine, such as one posting to an event loop
+	 */
+	inline parse_awaitable async_parse(const std::filesystem::path& path, executor& resume_on);
+
+	/**
+	 * @brief parses a file without blocking the awaiting coroutine
+	 * @param resume_on the executor resuming the awaiting coroutine, such as one posting to an event loop
+	 * @param io the executor reading and parsing the file
+	 */
+	inline parse_awaitable async_parse(const std::filesystem::path& path, executor& resume_on, executor& io);
+}
+
+namespace luco
+{
+	inline void inline_executor::post(std::function<void()> job)
+	{
+		job();
+	}
+
+	inline inline_executor& inline_executor::instance() noexcept
+	{
+		static inline_executor executor;
+		return executor;
+	}
+
+	inline thread_pool::thread_pool(size_t threads)
+	{
+		for (size_t i = 0; i < std::max<size_t>(threads, 1); i++)
+		{
+			_threads.emplace_back(
+			    [this]()
+			    {
+				    while (true)
+				    {
+					    std::unique_lock lock(_mutex);
+					    _ready.wait(lock, [this]() { return _stopping || not _jobs.empty(); });
+					    if (_jobs.empty())
+					    {
+						    return;
+					    }
+
+					    std::function<void()> job = std::move(_jobs.front());
+					    _jobs.pop_front();
+					    lock.unlock();
+					    job();
+				    }
+			    });
+		}
+	}
+
+	inline void thread_pool::post(std::function<void()> job)
+	{
+		{
+			std::lock_guard lock(_mutex);
+			_jobs.push_back(std::move(job));
+		}
+		_ready.notify_one();
+	}
+
+	inline thread_pool& thread_pool::io()
+	{
+		static thread_pool pool(std::clamp<size_t>(std::thread::hardware_concurrency(), 2, 8));
+		return pool;
+	}
+
+	inline thread_pool& thread_pool::compute()
+	{
+		static thread_pool pool(std::thread::hardware_concurrency());
+		return pool;
+	}
+
+	inline thread_pool::~thread_pool()
+	{
+		{
+			std::lock_guard lock(_mutex);
+			_stopping = true;
+		}
+		_ready.notify_all();
+
+		for (auto& thread : _threads)
+		{
+			thread.join();
+		}
+	}
+
+	inline parse_awaitable::parse_awaitable(const std::filesystem::path& path, executor& io, executor& resume_on)
+	    : _path(path), _io(io), _resume_on(resume_on)
+	{
+	}
+
+	inline bool parse_awaitable::await_ready() const noexcept
+	{
+		return false;
+	}
+
+	inline void parse_awaitable::await_suspend(std::coroutine_handle<> awaiting)
+	{
+		_io.post(
+		    [this, awaiting]()
+		    {
+			    _result.emplace(luco::parser::try_parse(_path));
+			    _resume_on.post([awaiting]() { awaiting.resume(); });
+		    });
+	}
+
+	inline expected<luco::node, error> parse_awaitable::await_resume()
+	{
+		return _result.value();
+	}
+
+	inline parse_awaitable async_parse(const std::filesystem::path& path)
+	{
+		return parse_awaitable(path, thread_pool::io(), inline_executor::instance());
+	}
+
+	inline parse_awaitable async_parse(const std::filesystem::path& path, executor& resume_on)
+	{
+		return parse_awaitable(path, thread_pool::io(), resume_on);
+	}
+
+	inline parse_awaitable async_parse(const std::filesystem::path& path, executor& resume_on, executor& io)
+	{
+		return parse_awaitable(path, io, resume_on);
+	}
+}
@@ -0,0 +1,910 @@
+/*
+ * Copyright: 2025 nodeluna
+ * SPDX-License-Identifier: Apache-2.0
+ * repository: https://github.com/nodeluna/luco
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cctype>
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <map>
+#include <optional>
+#include <set>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <variant>
+#include <vector>
+#include "api.hpp"
+#include "scanner.hpp"
+#include "schema.hpp"
+#include "expected.hpp"
+#include "error.hpp"
+
+/**
+ * @brief the namespace for luco
+ */
+namespace luco
+{
+	/**
+	 * @class typed_reader
+	 * @brief reads a luco text straight into the structs written by luco::codegen, without building any node. the
+	 * generated code walks the items of every object with a luco::scanner and calls read() with the member a key
+	 * dispatches to
+	 */
+	class typed_reader {
+		private:
+			luco::scanner _scanner;
+
+			inline expected<std::string, error> text_of(const scanner::item& item) const;
+
+		public:
+			/**
+			 * @brief constructor for luco::typed_reader
+			 * @param text the luco text, it isn't copied
+			 */
+			inline explicit typed_reader(std::string_view text) noexcept;
+
+			/**
+			 * @return the line of a position, counted for errors only
+			 */
+			inline size_t line_at(size_t pos) const noexcept;
+
+			/**
+			 * @brief finds the next item of the object or array opened at some position
+			 * @param opening the position of its '{', scanner::incomplete for the root object
+			 * @param in_object whether items should be keys
+			 * @return the item, an error if it's out of place or the text ends before the '}'
+			 */
+			inline expected<scanner::item, error> next(size_t pos, size_t opening, bool in_object) const;
+
+			/**
+			 * @return the unescaped key of a key_value or key_block item
+			 */
+			inline std::string key(const scanner::item& item) const;
+
+			/**
+			 * @brief skips an item whose key isn't a member
+			 * @return the position after it
+			 */
+			inline expected<size_t, error> skip(const scanner::item& item) const;
+
+			/**
+			 * @return an error of error_type::schema_violation at the line of an item
+			 */
+			inline expected<monostate, error> violation(const scanner::item& item, const std::string& why) const;
+
+			/**
+			 * @brief reads the value of an item into a member
+			 * @return the position after the item
+			 */
+			inline expected<size_t, error> read(const scanner::item& item, std::string& out) const;
+			inline expected<size_t, error> read(const scanner::item& item, int64_t& out) const;
+			inline expected<size_t, error> read(const scanner::item& item, double& out) const;
+			inline expected<size_t, error> read(const scanner::item& item, bool& out) const;
+			inline expected<size_t, error> read(const scanner::item& item, null_type& out) const;
+
+			/**
+			 * @brief reads an array, one element per item
+			 */
+			template<typename element_t>
+			expected<size_t, error> read(const scanner::item& item, std::vector<element_t>& out) const;
+
+			/**
+			 * @brief reads an object into a generated struct through its generated luco_read()
+			 */
+			template<typename struct_t>
+			expected<size_t, error> read(const scanner::item& item, struct_t& out) const;
+	};
+
+	/**
+	 * @class typed_writer
+	 * @brief writes the structs generated by luco::codegen as luco text, in the layout of node::dump_to_string(). keys
+	 * and strings are escaped the way parser::parse() reads them back, and the first one that can't be written, such
+	 * as a string with a newline, is kept as the error of status()
+	 */
+	class typed_writer {
+		private:
+			std::string		   _text;
+			std::pair<char, size_t>	   _indent;
+			size_t			   _depth  = 0;
+			expected<monostate, error> _status = monostate();
+
+			inline void write_key(std::string_view key);
+			inline void write_value(const std::string& value);
+			inline void write_value(int64_t value);
+			inline void write_value(double value);
+			inline void write_value(bool value);
+			inline void write_value(null_type value);
+
+			template<typename element_t>
+			void write_value(const std::vector<element_t>& value);
+
+			template<typename struct_t>
+			void write_value(const struct_t& value);
+
+		public:
+			/**
+			 * @brief constructor for luco::typed_writer
+			 * @param indent_conf the character and width of one level of indentation
+			 */
+			inline explicit typed_writer(const std::pair<char, size_t>& indent_conf = {' ', 4});
+
+			/**
+			 * @brief writes a member with its key
+			 */
+			template<typename member_t>
+			void write(std::string_view key, const member_t& value);
+
+			/**
+			 * @return the text written so far
+			 */
+			inline const std::string& text() const noexcept;
+
+			/**
+			 * @return the error of the first key or string that couldn't be written, if any
+			 */
+			inline const expected<monostate, error>& status() const noexcept;
+	};
+
+	/**
+	 * @class codegen
+	 * @brief writes a C++ header with a struct for every object of a schema, a parser reading a luco text straight
+	 * into them and a matching serializer. keys are dispatched with a switch on their length and characters instead
+	 * of looking them up
+	 * @detail @cpp
+	 * luco::schema rules = luco::schema::parse(std::filesystem::path("config.schema.luco"));
+	 * std::string header = luco::codegen(rules, "config", "app").generate();
+	 * // app::config config = app::parse_config(text);
+	 * // std::string text = app::dump_config(config);
+	 * @ecpp
+	 * required, closed, min and max are checked by the generated code, enum and pattern aren't. values without a
+	 * declared type are read as strings and objects without declared keys are skipped
+	 */
+	class codegen {
+		private:
+			struct member {
+					std::string	     key;
+					std::string	     name;
+					std::string	     type;
+					const schema::entry* rule;
+			};
+
+			const luco::schema& _schema;
+			std::string	    _name;
+			std::string	    _namespace;
+
+			inline static std::string		   identifier(std::string_view key);
+			inline static std::string		   literal(std::string_view text);
+			inline static std::string		   character(char c);
+			inline static std::string		   dispatch(const std::vector<member>& members);
+			inline static std::string		   checks(const member& member);
+			inline std::optional<node_type>		   shape_of(const schema::entry& rule) const;
+			inline expected<std::string, error>	   type_of(const schema::entry& rule, const std::string& name, std::string& code,
+								   std::set<std::string>& structs) const;
+			inline expected<monostate, error>	   emit_struct(const schema::entry& rule, const std::string& name, std::string& code,
+								       std::set<std::string>& structs) const;
+
+		public:
+			/**
+			 * @brief constructor for luco::codegen
+			 * @param schema the schema of the root object. luco::schema::infer() makes one from a representative
+			 * config
+			 * @param name the name of the root struct, nested structs are named after their key paths
+			 * @param name_space the namespace of the generated code, none if empty
+			 */
+			inline codegen(const luco::schema& schema, const std::string& name, const std::string& name_space = "");
+
+			/**
+			 * @return the generated header, or an error if a key path can't become a struct
+			 */
+			inline expected<std::string, error> try_generate() const noexcept;
+
+			/**
+			 * @return the generated header
+			 * @see try_generate()
+			 */
+			inline std::string generate() const;
+	};
+}
+
+namespace luco
+{
+	inline typed_reader::typed_reader(std::string_view text) noexcept : _scanner(text)
+	{
+	}
+
+	inline size_t typed_reader::line_at(size_t pos) const noexcept
+	{
+		std::string_view text = _scanner.text();
+		return 1 + static_cast<size_t>(std::count(text.begin(), text.begin() + std::min(pos, text.size()), '\n'));
+	}
+
+	inline expected<scanner::item, error> typed_reader::next(size_t pos, size_t opening, bool in_object) const
+	{
+		const bool    top  = opening == scanner::incomplete;
+		scanner::item item = _scanner.next_item(pos, false);
+		if (item.end == scanner::incomplete || (item.kind == scanner::item_kind::end && not top))
+		{
+			return unexpected(error(error_type::parsing_error, "line {}: '{{' isn't closed before the end of the text",
+						this->line_at(top ? item.begin : opening)));
+		}
+		else if (item.kind == scanner::item_kind::close && top)
+		{
+			return unexpected(error(error_type::parsing_error, "line {}: found '}}' without being in an [object] or [array]",
+						this->line_at(item.begin)));
+		}
+		else if (in_object && (item.kind == scanner::item_kind::value || item.kind == scanner::item_kind::block))
+		{
+			return unexpected(error(error_type::parsing_error_wrong_type, "line {}: expected a key in an object",
+						this->line_at(item.begin)));
+		}
+		else if (not in_object && (item.kind == scanner::item_kind::key_value || item.kind == scanner::item_kind::key_block))
+		{
+			return unexpected(error(error_type::parsing_error_wrong_type, "line {}: expected an element in an array",
+						this->line_at(item.begin)));
+		}
+
+		return item;
+	}
+
+	inline std::string typed_reader::key(const scanner::item& item) const
+	{
+		return _scanner.key(item);
+	}
+
+	inline expected<size_t, error> typed_reader::skip(const scanner::item& item) const
+	{
+		if (item.kind != scanner::item_kind::key_block && item.kind != scanner::item_kind::block)
+		{
+			return item.end;
+		}
+
+		size_t end = _scanner.skip_block(item.block);
+		if (end == scanner::incomplete)
+		{
+			return unexpected(error(error_type::parsing_error, "line {}: '{{' isn't closed before the end of the text",
+						this->line_at(item.block)));
+		}
+
+		return end;
+	}
+
+	inline expected<monostate, error> typed_reader::violation(const scanner::item& item, const std::string& why) const
+	{
+		return unexpected(error(error_type::schema_violation, "line {}: {}", this->line_at(item.begin), why));
+	}
+
+	inline expected<std::string, error> typed_reader::text_of(const scanner::item& item) const
+	{
+		if (item.kind == scanner::item_kind::key_block || item.kind == scanner::item_kind::block)
+		{
+			return unexpected(error(error_type::parsing_error_wrong_type, "line {}: expected a value but found an object or array",
+						this->line_at(item.begin)));
+		}
+
+		bool quoted = false;
+		return _scanner.value(item, quoted);
+	}
+
+	inline expected<size_t, error> typed_reader::read(const scanner::item& item, std::string& out) const
+	{
+		auto text = this->text_of(item);
+		if (not text)
+		{
+			return unexpected(text.error());
+		}
+		out = std::move(text.value());
+
+		return item.end;
+	}
+
+	inline expected<size_t, error> typed_reader::read(const scanner::item& item, int64_t& out) const
+	{
+		auto text = this->text_of(item);
+		if (not text)
+		{
+			return unexpected(text.error());
+		}
+
+		auto converted = schema::convert(text.value(), value_type::integer);
+		if (not converted)
+		{
+			return unexpected(error(error_type::parsing_error_wrong_type, "line {}: {}", this->line_at(item.begin),
+						converted.error().message()));
+		}
+		out = std::get<int64_t>(converted.value());
+
+		return item.end;
+	}
+
+	inline expected<size_t, error> typed_reader::read(const scanner::item& item, double& out) const
+	{
+		auto text = this->text_of(item);
+		if (not text)
+		{
+			return unexpected(text.error());
+		}
+
+		auto converted = schema::convert(text.value(), value_type::double_t);
+		if (not converted)
+		{
+			return unexpected(error(error_type::parsing_error_wrong_type, "line {}: {}", this->line_at(item.begin),
+						converted.error().message()));
+		}
+		out = std::get<double>(converted.value());
+
+		return item.end;
+	}
+
+	inline expected<size_t, error> typed_reader::read(const scanner::item& item, bool& out) const
+	{
+		auto text = this->text_of(item);
+		if (not text)
+		{
+			return unexpected(text.error());
+		}
+
+		auto converted = schema::convert(text.value(), value_type::boolean);
+		if (not converted)
+		{
+			return unexpected(error(error_type::parsing_error_wrong_type, "line {}: {}", this->line_at(item.begin),
+						converted.error().message()));
+		}
+		out = std::get<bool>(converted.value());
+
+		return item.end;
+	}
+
+	inline expected<size_t, error> typed_reader::read(const scanner::item& item, null_type&) const
+	{
+		auto text = this->text_of(item);
+		if (not text)
+		{
+			return unexpected(text.error());
+		}
+
+		auto converted = schema::convert(text.value(), value_type::null);
+		if (not converted)
+		{
+			return unexpected(error(error_type::parsing_error_wrong_type, "line {}: {}", this->line_at(item.begin),
+						converted.error().message()));
+		}
+
+		return item.end;
+	}
+
+	template<typename element_t>
+	expected<size_t, error> typed_reader::read(const scanner::item& item, std::vector<element_t>& out) const
+	{
+		if (item.kind != scanner::item_kind::key_block && item.kind != scanner::item_kind::block)
+		{
+			return unexpected(error(error_type::parsing_error_wrong_type, "line {}: expected an array but found a value",
+						this->line_at(item.begin)));
+		}
+
+		size_t pos = item.block + 1;
+		while (true)
+		{
+			auto element = this->next(pos, item.block, false);
+			if (not element)
+			{
+				return unexpected(element.error());
+			}
+			else if (element.value().kind == scanner::item_kind::close)
+			{
+				return element.value().end;
+			}
+
+			auto end = this->read(element.value(), out.emplace_back());
+			if (not end)
+			{
+				return end;
+			}
+			pos = end.value();
+		}
+	}
+
+	template<typename struct_t>
+	expected<size_t, error> typed_reader::read(const scanner::item& item, struct_t& out) const
+	{
+		if (item.kind != scanner::item_kind::key_block && item.kind != scanner::item_kind::block)
+		{
+			return unexpected(error(error_type::parsing_error_wrong_type, "line {}: expected an object but found a value",
+						this->line_at(item.begin)));
+		}
+
+		return luco_read(*this, item.block, out);
+	}
+
+	inline typed_writer::typed_writer(const std::pair<char, size_t>& indent_conf) : _indent(indent_conf)
+	{
+	}
+
+	inline void typed_writer::write_key(std::string_view key)
+	{
+		_text.append(_depth * _indent.second, _indent.first);
+		auto ok = luco_simple_types::write_string(_text, key, true);
+		if (not ok && _status)
+		{
+			_status = unexpected(ok.error());
+		}
+	}
+
+	inline void typed_writer::write_value(const std::string& value)
+	{
+		auto ok = luco_simple_types::write_string(_text, value, false);
+		if (not ok && _status)
+		{
+			_status = unexpected(ok.error());
+		}
+	}
+
+	inline void typed_writer::write_value(int64_t value)
+	{
+		_text += std::to_string(value);
+	}
+
+	inline void typed_writer::write_value(double value)
+	{
+		_text += luco::value(value).stringify();
+	}
+
+	inline void typed_writer::write_value(bool value)
+	{
+		_text += value ? "true" : "false";
+	}
+
+	inline void typed_writer::write_value(null_type)
+	{
+		_text += "null";
+	}
+
+	template<typename element_t>
+	void typed_writer::write_value(const std::vector<element_t>& value)
+	{
+		_text += "{\n";
+		_depth++;
+		for (const element_t& element : value)
+		{
+			_text.append(_depth * _indent.second, _indent.first);
+			this->write_value(element);
+			_text += '\n';
+		}
+		_depth--;
+		_text.append(_depth * _indent.second, _indent.first);
+		_text += '}';
+	}
+
+	template<typename struct_t>
+	void typed_writer::write_value(const struct_t& value)
+	{
+		_text += "{\n";
+		_depth++;
+		luco_write(*this, value);
+		_depth--;
+		_text.append(_depth * _indent.second, _indent.first);
+		_text += '}';
+	}
+
+	template<typename member_t>
+	void typed_writer::write(std::string_view key, const member_t& value)
+	{
+		this->write_key(key);
+		if constexpr (std::is_class_v<member_t> && not std::is_same_v<member_t, std::string> && not std::is_same_v<member_t, null_type>)
+		{
+			_text += ' ';
+		}
+		else
+		{
+			_text += " = ";
+		}
+		this->write_value(value);
+		_text += '\n';
+	}
+
+	inline const std::string& typed_writer::text() const noexcept
+	{
+		return _text;
+	}
+
+	inline const expected<monostate, error>& typed_writer::status() const noexcept
+	{
+		return _status;
+	}
+
+	inline codegen::codegen(const luco::schema& schema, const std::string& name, const std::string& name_space)
+	    : _schema(schema), _name(identifier(name)), _namespace(name_space)
+	{
+	}
+
+	inline std::string codegen::identifier(std::string_view key)
+	{
+		static const std::set<std::string_view> reserved = {
+		    "alignas",	 "alignof",  "and",	 "auto",     "bool",	  "break",    "case",	  "catch",    "char",	"class",
+		    "const",	 "continue", "default",	 "delete",   "do",	  "double",   "else",	  "enum",     "explicit", "export",
+		    "extern",	 "false",    "float",	 "for",	     "friend",	  "goto",     "if",	  "inline",   "int",	"long",
+		    "namespace", "new",	     "not",	 "nullptr",  "operator",  "or",	      "private",  "protected", "public",   "register",
+		    "return",	 "short",    "signed",	 "sizeof",   "static",	  "struct",   "switch",	  "template", "this",	"throw",
+		    "true",	 "try",	     "typedef",	 "typename", "union",	  "unsigned", "using",	  "virtual",  "void",	"volatile",
+		    "while",	 "xor",	     "requires", "concept",  "co_await", "co_yield", "co_return",
+		};
+
+		std::string name;
+		for (char c : key)
+		{
+			name += std::isalnum(static_cast<unsigned char>(c)) ? c : '_';
+		}
+		if (name.empty() || std::isdigit(static_cast<unsigned char>(name.front())))
+		{
+			name.insert(name.begin(), '_');
+		}
+		else if (reserved.contains(name))
+		{
+			name += '_';
+		}
+
+		return name;
+	}
+
+	inline std::string codegen::literal(std::string_view text)
+	{
+		std::string quoted = "\"";
+		for (char c : text)
+		{
+			if (c == '"' || c == '\\')
+			{
+				quoted += '\\';
+				quoted += c;
+			}
+			else if (std::isprint(static_cast<unsigned char>(c)))
+			{
+				quoted += c;
+			}
+			else
+			{
+				// ends the literal so the next character can't extend the escape
+				quoted += std::format("\\x{:02x}\"\"", static_cast<unsigned char>(c));
+			}
+		}
+
+		return quoted + '"';
+	}
+
+	inline std::string codegen::character(char c)
+	{
+		if (std::isalnum(static_cast<unsigned char>(c)) || c == '_' || c == '-' || c == '.' || c == ' ')
+		{
+			return std::format("'{}'", c);
+		}
+
+		return std::format("static_cast<char>({})", static_cast<int>(static_cast<unsigned char>(c)));
+	}
+
+	inline std::string codegen::dispatch(const std::vector<member>& members)
+	{
+		std::map<size_t, std::vector<size_t>> by_length;
+		for (size_t i = 0; i < members.size(); i++)
+		{
+			by_length[members[i].key.size()].push_back(i);
+		}
+
+		std::string code = "\t\tswitch (key.size())\n\t\t{\n";
+		for (const auto& [length, indices] : by_length)
+		{
+			code += std::format("\t\t\tcase {}:\n", length);
+
+			// the first position where every key of this length has a different character
+			std::optional<size_t> position;
+			for (size_t at = 0; at < length && not position && indices.size() > 1; at++)
+			{
+				std::set<char> characters;
+				for (size_t index : indices)
+				{
+					characters.insert(members[index].key[at]);
+				}
+				if (characters.size() == indices.size())
+				{
+					position = at;
+				}
+			}
+
+			if (position)
+			{
+				code += std::format("\t\t\t\tswitch (key[{}])\n\t\t\t\t{{\n", position.value());
+				for (size_t index : indices)
+				{
+					code += std::format("\t\t\t\t\tcase {}:\n\t\t\t\t\t\treturn key == {} ? {} : -1;\n",
+							    character(members[index].key[position.value()]), literal(members[index].key), index);
+				}
+				code += "\t\t\t\t}\n\t\t\t\tbreak;\n";
+			}
+			else
+			{
+				for (size_t index : indices)
+				{
+					code += std::format("\t\t\t\tif (key == {})\n\t\t\t\t{{\n\t\t\t\t\treturn {};\n\t\t\t\t}}\n",
+							    literal(members[index].key), index);
+				}
+				code += "\t\t\t\tbreak;\n";
+			}
+		}
+		code += "\t\t}\n\n\t\treturn -1;\n";
+
+		return code;
+	}
+
+	inline std::string codegen::checks(const member& member)
+	{
+		const schema::entry& rule = *member.rule;
+		if (not rule.min && not rule.max)
+		{
+			return "";
+		}
+
+		bool	    sized = not rule.type || rule.type == value_type::string || rule.shape;
+		std::string value = std::format("out.{}{}", member.name, sized ? ".size()" : "");
+		std::string in_range;
+		if (rule.min)
+		{
+			in_range += std::format("{} >= {}", value, rule.min.value());
+		}
+		if (rule.max)
+		{
+			in_range += std::format("{}{} <= {}", in_range.empty() ? "" : " && ", value, rule.max.value());
+		}
+
+		std::string why = std::format("'{}' expected {}{}{}", member.key,
+					      rule.min ? std::format("at least {}", rule.min.value()) : "",
+					      rule.min && rule.max ? " and " : "",
+					      rule.max ? std::format("at most {}", rule.max.value()) : "");
+		if (sized)
+		{
+			why += rule.shape == node_type::array ? " elements" : rule.shape == node_type::object ? " keys" : " characters";
+		}
+
+		return std::format("\t\t\t\t\tif (end && not({}))\n\t\t\t\t\t{{\n\t\t\t\t\t\tend = reader.violation(item.value(), {});\n"
+				   "\t\t\t\t\t}}\n",
+				   in_range, literal(why));
+	}
+
+	inline std::optional<node_type> codegen::shape_of(const schema::entry& rule) const
+	{
+		if (rule.shape)
+		{
+			return rule.shape;
+		}
+		else if (_schema.find(rule, schema::element) != nullptr)
+		{
+			return node_type::array;
+		}
+		else if (not rule.keys.empty())
+		{
+			return node_type::object;
+		}
+
+		return std::nullopt;
+	}
+
+	inline expected<std::string, error> codegen::type_of(const schema::entry& rule, const std::string& name, std::string& code,
+							     std::set<std::string>& structs) const
+	{
+		if (rule.type)
+		{
+			switch (rule.type.value())
+			{
+				case value_type::string:
+					return std::string("std::string");
+				case value_type::integer:
+					return std::string("int64_t");
+				case value_type::double_t:
+				case value_type::number:
+					return std::string("double");
+				case value_type::boolean:
+					return std::string("bool");
+				case value_type::null:
+					return std::string("luco::null_type");
+				case value_type::none:
+				case value_type::temp_escape_type:
+				case value_type::unknown:
+					break;
+			}
+		}
+
+		std::optional<node_type> shape = this->shape_of(rule);
+		if (shape == node_type::object)
+		{
+			if (rule.keys.empty())
+			{
+				return std::string();
+			}
+
+			auto ok = this->emit_struct(rule, name, code, structs);
+			if (not ok)
+			{
+				return unexpected(ok.error());
+			}
+			return name;
+		}
+		else if (shape == node_type::array)
+		{
+			const schema::entry* element = _schema.find(rule, schema::element);
+			if (element == nullptr)
+			{
+				return std::string("std::vector<std::string>");
+			}
+
+			auto type = this->type_of(*element, name + "_element", code, structs);
+			if (not type || type.value().empty())
+			{
+				return type;
+			}
+			return std::format("std::vector<{}>", type.value());
+		}
+
+		return std::string("std::string");
+	}
+
+	inline expected<monostate, error> codegen::emit_struct(const schema::entry& rule, const std::string& name, std::string& code,
+							       std::set<std::string>& structs) const
+	{
+		if (not structs.insert(name).second)
+		{
+			return unexpected(error(error_type::wrong_type, "two key paths would generate the struct '{}'", name));
+		}
+
+		std::vector<member>   members;
+		std::set<std::string> names;
+		for (const auto& [key, index] : rule.keys)
+		{
+			const schema::entry* nested = _schema.find(rule, key);
+			if (key == schema::element)
+			{
+				continue;
+			}
+
+			std::string member_name = identifier(key);
+			while (not names.insert(member_name).second)
+			{
+				member_name += '_';
+			}
+
+			auto type = this->type_of(*nested, name + "_" + member_name, code, structs);
+			if (not type)
+			{
+				return unexpected(type.error());
+			}
+			else if (not type.value().empty())
+			{
+				members.push_back(member{key, member_name, type.value(), nested});
+			}
+		}
+
+		code += std::format("\tstruct {} {{\n", name);
+		for (const member& member : members)
+		{
+			const char* initial = member.type == "int64_t" || member.type == "double" ? " = 0" : member.type == "bool" ? " = false" : "";
+			code += std::format("\t\t{} {}{};\n", member.type, member.name, initial);
+		}
+		code += "\t};\n\n";
+
+		code += std::format("\tinline int {}_member(std::string_view key) noexcept\n\t{{\n{}\t}}\n\n", name, dispatch(members));
+
+		std::vector<size_t> required;
+		for (size_t i = 0; i < members.size(); i++)
+		{
+			if (members[i].rule->required)
+			{
+				required.push_back(i);
+			}
+		}
+
+		code += std::format("\tinline luco::expected<size_t, luco::error> luco_read(const luco::typed_reader& reader, size_t opening, {}& out)\n"
+				    "\t{{\n",
+				    name);
+		if (not required.empty())
+		{
+			code += std::format("\t\tbool   seen[{}] = {{}};\n", required.size());
+		}
+		code += "\t\tsize_t pos = opening == luco::scanner::incomplete ? 0 : opening + 1;\n"
+			"\t\twhile (true)\n\t\t{\n"
+			"\t\t\tauto item = reader.next(pos, opening, true);\n"
+			"\t\t\tif (not item)\n\t\t\t{\n\t\t\t\treturn luco::unexpected(item.error());\n\t\t\t}\n"
+			"\t\t\telse if (item.value().kind == luco::scanner::item_kind::close || item.value().kind == luco::scanner::item_kind::end)\n"
+			"\t\t\t{\n";
+		for (size_t slot = 0; slot < required.size(); slot++)
+		{
+			code += std::format("\t\t\t\tif (not seen[{}])\n\t\t\t\t{{\n\t\t\t\t\treturn reader.violation(item.value(), {});\n\t\t\t\t}}\n",
+					    slot, literal(std::format("missing the required key '{}'", members[required[slot]].key)));
+		}
+		code += "\t\t\t\treturn item.value().end;\n\t\t\t}\n\n"
+			"\t\t\tluco::expected<size_t, luco::error> end = luco::unexpected(luco::error(luco::error_type::none, \"\"));\n";
+		code += std::format("\t\t\tswitch ({}_member(reader.key(item.value())))\n\t\t\t{{\n", name);
+		for (size_t i = 0; i < members.size(); i++)
+		{
+			code += std::format("\t\t\t\tcase {}:\n\t\t\t\t\tend = reader.read(item.value(), out.{});\n", i, members[i].name);
+			code += checks(members[i]);
+			auto slot = std::find(required.begin(), required.end(), i);
+			if (slot != required.end())
+			{
+				code += std::format("\t\t\t\t\tseen[{}] = true;\n", slot - required.begin());
+			}
+			code += "\t\t\t\t\tbreak;\n";
+		}
+		if (rule.closed)
+		{
+			code += "\t\t\t\tdefault:\n\t\t\t\t\tend = reader.violation(item.value(), \"the key '\" + reader.key(item.value()) + \"' isn't "
+				"allowed\");\n\t\t\t\t\tbreak;\n";
+		}
+		else
+		{
+			code += "\t\t\t\tdefault:\n\t\t\t\t\tend = reader.skip(item.value());\n\t\t\t\t\tbreak;\n";
+		}
+		code += "\t\t\t}\n\n\t\t\tif (not end)\n\t\t\t{\n\t\t\t\treturn end;\n\t\t\t}\n\t\t\tpos = end.value();\n\t\t}\n\t}\n\n";
+
+		code += std::format("\tinline void luco_write(luco::typed_writer& writer, const {}& value)\n\t{{\n", name);
+		for (const member& member : members)
+		{
+			code += std::format("\t\twriter.write({}, value.{});\n", literal(member.key), member.name);
+		}
+		code += "\t}\n\n";
+
+		return monostate();
+	}
+
+	inline expected<std::string, error> codegen::try_generate() const noexcept
+	{
+		std::string	      code;
+		std::set<std::string> structs;
+		auto		      ok = this->emit_struct(_schema.root(), _name, code, structs);
+		if (not ok)
+		{
+			return unexpected(ok.error());
+		}
+
+		std::string header = "// generated by luco::codegen, don't edit\n\n"
+				     "#pragma once\n\n"
+				     "#include <cstdint>\n#include <string>\n#include <string_view>\n#include <vector>\n#include <luco.hpp>\n\n";
+		header += _namespace.empty() ? "" : std::format("namespace {}\n{{\n", _namespace);
+		header += code;
+		header += std::format("\tinline luco::expected<{0}, luco::error> try_parse_{0}(std::string_view text)\n\t{{\n"
+				      "\t\tluco::typed_reader reader(text);\n"
+				      "\t\t{0}		   out;\n"
+				      "\t\tauto		   end = luco_read(reader, luco::scanner::incomplete, out);\n"
+				      "\t\tif (not end)\n\t\t{{\n\t\t\treturn luco::unexpected(end.error());\n\t\t}}\n\n"
+				      "\t\treturn out;\n\t}}\n\n"
+				      "\tinline {0} parse_{0}(std::string_view text)\n\t{{\n"
+				      "\t\tluco::expected<{0}, luco::error> ok = try_parse_{0}(text);\n"
+				      "\t\tif (not ok)\n\t\t{{\n\t\t\tluco::raise_error(ok.error());\n\t\t}}\n\n"
+				      "\t\treturn ok.value();\n\t}}\n\n"
+				      "\tinline luco::expected<std::string, luco::error> try_dump_{0}(const {0}& value,\n"
+				      "\t\t\t\t\t\t\t\tconst std::pair<char, size_t>& indent_conf = {{' ', 4}})\n\t{{\n"
+				      "\t\tluco::typed_writer writer(indent_conf);\n"
+				      "\t\tluco_write(writer, value);\n"
+				      "\t\tif (not writer.status())\n\t\t{{\n\t\t\treturn luco::unexpected(writer.status().error());\n\t\t}}\n\n"
+				      "\t\treturn writer.text();\n\t}}\n\n"
+				      "\tinline std::string dump_{0}(const {0}& value, const std::pair<char, size_t>& indent_conf = {{' ', 4}})\n\t{{\n"
+				      "\t\tluco::expected<std::string, luco::error> ok = try_dump_{0}(value, indent_conf);\n"
+				      "\t\tif (not ok)\n\t\t{{\n\t\t\tluco::raise_error(ok.error());\n\t\t}}\n\n"
+				      "\t\treturn ok.value();\n\t}}\n",
+				      _name);
+		header += _namespace.empty() ? "" : "}\n";
+
+		return header;
+	}
+
+	inline std::string codegen::generate() const
+	{
+		expected<std::string, error> ok = this->try_generate();
+		if (not ok)
+		{
+			raise_error(ok.error());
+		}
+
+		return ok.value();
+	}
+}
@@ -0,0 +1,395 @@
+/*
+ * Copyright: 2025 nodeluna
+ * SPDX-License-Identifier: Apache-2.0
+ * repository: https://github.com/nodeluna/luco
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <format>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "api.hpp"
+#include "parser.hpp"
+#include "expected.hpp"
+#include "error.hpp"
+
+/**
+ * @brief the namespace for luco
+ */
+namespace luco
+{
+	/**
+	 * @struct text_edit
+	 * @brief replaces the bytes [begin, end) of a document's text with replacement
+	 */
+	struct text_edit {
+			size_t	    begin = 0;
+			size_t	    end	  = 0;
+			std::string replacement;
+	};
+
+	/**
+	 * @class document
+	 * @brief a parsed luco text that keeps its source and the spans of every object and array, so that edits only
+	 * reparse the innermost object or array that encloses them
+	 * @detail @cpp
+	 * luco::document doc = luco::document::parse("key {\n\tnested = 1\n}\n");
+	 * doc.edit({14, 15, "2"}); // only 'key' is reparsed
+	 * @ecpp
+	 */
+	class document {
+		private:
+			std::string		 _text;
+			luco::node		 _root;
+			std::vector<source_span> _spans;
+			bool			 _balanced = true;
+
+			inline expected<monostate, error> reparse_all(std::string&& new_text) noexcept;
+			inline std::vector<source_span>::iterator enclosing_span(const text_edit& edit);
+
+			/**
+			 * @brief compares a node of the document with the one reparsed in its place
+			 * @param pairs when they're the same, gets every reparsed object and array paired with the one of the
+			 * document it stands for
+			 * @return true if both hold the same keys and values
+			 */
+			inline static bool same_tree(const luco::node& kept, const luco::node& parsed,
+						     std::unordered_map<const void*, luco::node>& pairs);
+
+		public:
+			/**
+			 * @brief parses a luco string into a document
+			 * @param text the luco text
+			 * @return luco::document
+			 * @throws luco::error on parsing errors
+			 */
+			inline static document parse(const std::string& text);
+
+			/**
+			 * @brief parses a luco string into a document
+			 * @param text the luco text
+			 * @return luco::expected<document, error>
+			 */
+			inline static expected<document, error> try_parse(const std::string& text) noexcept;
+
+			/**
+			 * @brief applies an edit to the text and reparses only the innermost object or array enclosing it. the
+			 * enclosing luco::node keeps its identity, and so does every entry of it the edit didn't change and
+			 * every node outside it; only the changed entries are replaced. edits that aren't enclosed by an object
+			 * or array, or that change its kind, reparse the whole text
+			 * @param edit the byte range and its replacement
+			 * @return luco::expected<monostate, error>, the document is unchanged on error
+			 */
+			inline expected<monostate, error> try_edit(const text_edit& edit) noexcept;
+
+			/**
+			 * @brief same as try_edit() but throws
+			 * @param edit the byte range and its replacement
+			 * @throws luco::error on parsing errors or an out of range edit
+			 */
+			inline void edit(const text_edit& edit);
+
+			/**
+			 * @return the current text of the document
+			 */
+			inline const std::string& text() const noexcept;
+
+			/**
+			 * @return the parsed tree of the document
+			 */
+			inline luco::node& root() noexcept;
+
+			/**
+			 * @return the spans of every object and array in the document, in no particular order
+			 */
+			inline const std::vector<source_span>& spans() const noexcept;
+	};
+}
+
+namespace luco
+{
+	inline document document::parse(const std::string& text)
+	{
+		expected<document, error> doc = document::try_parse(text);
+		if (not doc)
+		{
+			raise_error(doc.error());
+		}
+
+		return std::move(doc.value());
+	}
+
+	inline expected<document, error> document::try_parse(const std::string& text) noexcept
+	{
+		document doc;
+		auto	 ok = doc.reparse_all(std::string(text));
+		if (not ok)
+		{
+			return unexpected(ok.error());
+		}
+
+		return doc;
+	}
+
+	inline expected<monostate, error> document::reparse_all(std::string&& new_text) noexcept
+	{
+		std::vector<source_span> spans;
+		struct parsing_data	 data;
+		data.spans = &spans;
+
+		expected<luco::node, error> root = luco::parser::parse_string(new_text, data);
+		if (not root)
+		{
+			return unexpected(root.error());
+		}
+
+		// unclosed objects or arrays are accepted, but then the spans don't describe the tree and every edit has to
+		// reparse the whole text
+		_text	  = std::move(new_text);
+		_root	  = std::move(root.value());
+		_spans	  = std::move(spans);
+		_balanced = data.luco_objs.size() == 1;
+
+		return monostate();
+	}
+
+	inline std::vector<source_span>::iterator document::enclosing_span(const text_edit& edit)
+	{
+		auto innermost = _spans.end();
+		for (auto itr = _spans.begin(); itr != _spans.end(); itr++)
+		{
+			if (itr->begin < edit.begin && edit.end <= itr->end &&
+			    (innermost == _spans.end() || itr->end - itr->begin < innermost->end - innermost->begin))
+			{
+				innermost = itr;
+			}
+		}
+
+		return innermost;
+	}
+
+	inline bool document::same_tree(const luco::node& kept, const luco::node& parsed, std::unordered_map<const void*, luco::node>& pairs)
+	{
+		if (kept.is_value() || parsed.is_value())
+		{
+			return kept.is_value() && parsed.is_value() && kept.as_value()->type() == parsed.as_value()->type() &&
+			       kept.as_value()->stringify() == parsed.as_value()->stringify();
+		}
+		else if (kept.is_object() && parsed.is_object())
+		{
+			auto kept_object   = kept.as_object();
+			auto parsed_object = parsed.as_object();
+			if (kept_object->size() != parsed_object->size())
+			{
+				return false;
+			}
+
+			for (auto k = kept_object->begin(), p = parsed_object->begin(); k != kept_object->end(); k++, p++)
+			{
+				if (k->first != p->first || not document::same_tree(k->second, p->second, pairs))
+				{
+					return false;
+				}
+			}
+			pairs.insert_or_assign(parsed_object.get(), kept);
+
+			return true;
+		}
+		else if (kept.is_array() && parsed.is_array())
+		{
+			auto kept_array	  = kept.as_array();
+			auto parsed_array = parsed.as_array();
+			if (kept_array->size() != parsed_array->size())
+			{
+				return false;
+			}
+
+			for (size_t i = 0; i < kept_array->size(); i++)
+			{
+				if (not document::same_tree((*kept_array)[i], (*parsed_array)[i], pairs))
+				{
+					return false;
+				}
+			}
+			pairs.insert_or_assign(parsed_array.get(), kept);
+
+			return true;
+		}
+
+		return false;
+	}
+
+	inline expected<monostate, error> document::try_edit(const text_edit& edit) noexcept
+	{
+		if (edit.begin > edit.end || edit.end > _text.size())
+		{
+			return unexpected(error(error_type::wronge_index, "edit [{}, {}) is out of the document's range of {} bytes",
+						edit.begin, edit.end, _text.size()));
+		}
+
+		std::string new_text;
+		new_text.reserve(_text.size() - (edit.end - edit.begin) + edit.replacement.size());
+		new_text.append(_text, 0, edit.begin);
+		new_text.append(edit.replacement);
+		new_text.append(_text, edit.end);
+
+		auto span = this->enclosing_span(edit);
+		if (span == _spans.end() || not _balanced)
+		{
+			return this->reparse_all(std::move(new_text));
+		}
+
+		const long long delta	   = static_cast<long long>(edit.replacement.size()) - static_cast<long long>(edit.end - edit.begin);
+		const size_t	new_end	   = static_cast<size_t>(static_cast<long long>(span->end) + delta);
+		const long long line_delta = std::count(edit.replacement.begin(), edit.replacement.end(), '\n') -
+					     std::count(_text.begin() + edit.begin, _text.begin() + edit.end, '\n');
+
+		// the enclosing container is parsed on its own inside a wrapper that gives it the same kind of parent it has in
+		// the document, starting at its own line so error locations match the document
+		const std::string	 prefix	 = span->in_array ? "k {\n{" : "k {";
+		const std::string	 suffix	 = span->in_array ? "}\n}\n" : "}\n";
+		const size_t		 opening = prefix.size() - 1;
+		std::string		 wrapper = prefix + new_text.substr(span->begin + 1, new_end - span->begin - 1) + suffix;
+		std::vector<source_span> new_spans;
+		struct parsing_data	 data;
+		data.spans	 = &new_spans;
+		data.line_number = span->in_array ? span->line - 1 : span->line;
+
+		expected<luco::node, error> wrapped = luco::parser::parse_string(wrapper, data);
+		if (not wrapped)
+		{
+			return unexpected(wrapped.error());
+		}
+
+		// the edit may have closed the container early or opened a new one that swallowed its closing bracket, or
+		// turned an object into an array
+		const size_t closing   = wrapper.size() - suffix.size();
+		auto	     outermost	  = std::find_if(new_spans.begin(), new_spans.end(), [&](const source_span& s)
+						      { return s.begin == opening && s.end == closing; });
+		auto	     wrapper_root = wrapped.value().as_object();
+		if (data.luco_objs.size() != 1 || wrapper_root->size() != 1 || (span->in_array && not wrapper_root->begin()->second.is_array()) ||
+		    (span->in_array && wrapper_root->begin()->second.as_array()->size() != 1) || outermost == new_spans.end() ||
+		    outermost->node.is_object() != span->node.is_object())
+		{
+			return this->reparse_all(std::move(new_text));
+		}
+
+		// only the entries the edit changed are spliced in, the others keep the nodes of the document so whoever holds
+		// them still holds a part of the tree. the pairs are only kept for entries found to be the same
+		luco::node				    container = span->node;
+		std::unordered_map<const void*, luco::node> pairs;
+		auto keep_if_same = [&](const luco::node& kept, luco::node& parsed)
+		{
+			std::unordered_map<const void*, luco::node> found;
+			if (not document::same_tree(kept, parsed, found))
+			{
+				return false;
+			}
+			pairs.merge(found);
+			parsed = kept;
+			return true;
+		};
+
+		if (container.is_object())
+		{
+			auto kept = container.as_object();
+			for (auto& [key, parsed] : *outermost->node.as_object())
+			{
+				if (auto itr = kept->find(key); itr != kept->end())
+				{
+					keep_if_same(itr->second, parsed);
+				}
+			}
+			*kept = std::move(*outermost->node.as_object());
+		}
+		else
+		{
+			// elements are matched from both ends, the ones in between were inserted, removed or edited
+			auto   kept	= container.as_array();
+			auto   parsed	= outermost->node.as_array();
+			size_t shortest = std::min(kept->size(), parsed->size());
+			size_t front	= 0;
+			while (front < shortest && keep_if_same((*kept)[front], (*parsed)[front]))
+			{
+				front++;
+			}
+			size_t back = 0;
+			while (back < shortest - front && keep_if_same((*kept)[kept->size() - 1 - back], (*parsed)[parsed->size() - 1 - back]))
+			{
+				back++;
+			}
+			*kept = std::move(*parsed);
+		}
+
+		const size_t old_begin = span->begin;
+		const size_t old_end   = span->end;
+		std::erase_if(_spans, [&](const source_span& s) { return old_begin <= s.begin && s.end <= old_end; });
+
+		for (source_span& s : _spans)
+		{
+			if (s.begin >= edit.end)
+			{
+				s.begin = static_cast<size_t>(static_cast<long long>(s.begin) + delta);
+				s.line	= static_cast<size_t>(static_cast<long long>(s.line) + line_delta);
+			}
+			if (s.end >= edit.end)
+			{
+				s.end = static_cast<size_t>(static_cast<long long>(s.end) + delta);
+			}
+		}
+
+		for (source_span& s : new_spans)
+		{
+			if (s.begin < opening)
+			{
+				continue;
+			}
+			s.begin = s.begin - opening + old_begin;
+			s.end	= s.end - opening + old_begin;
+			if (s.begin == old_begin)
+			{
+				s.node = container;
+			}
+			else if (auto kept = pairs.find(s.node.is_object() ? static_cast<const void*>(s.node.as_object().get())
+									   : static_cast<const void*>(s.node.as_array().get()));
+				 kept != pairs.end())
+			{
+				s.node = kept->second;
+			}
+			_spans.push_back(std::move(s));
+		}
+
+		_text = std::move(new_text);
+
+		return monostate();
+	}
+
+	inline void document::edit(const text_edit& edit)
+	{
+		auto ok = this->try_edit(edit);
+		if (not ok)
+		{
+			raise_error(ok.error());
+		}
+	}
+
+	inline const std::string& document::text() const noexcept
+	{
+		return _text;
+	}
+
+	inline luco::node& document::root() noexcept
+	{
+		return _root;
+	}
+
+	inline const std::vector<source_span>& document::spans() const noexcept
+	{
+		return _spans;
+	}
+}
@@ -0,0 +1,407 @@
+/*
+ * Copyright: 2025 nodeluna
+ * SPDX-License-Identifier: Apache-2.0
+ * repository: https://github.com/nodeluna/luco
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <format>
+#include <span>
+#include <string>
+#include <string_view>
+#include "static_document.hpp"
+#include "expected.hpp"
+#include "error.hpp"
+
+/**
+ * @brief the namespace for luco
+ */
+namespace luco
+{
+	/**
+	 * @class static_image
+	 * @brief reads a document image written by luco::embed::image(). an image is the table of a
+	 * luco::static_document in one relocatable blob, a header followed by the entries and the characters. it's read in
+	 * place without parsing, for the platform it was built on
+	 */
+	class static_image {
+		public:
+			/**
+			 * @struct header
+			 * @brief the start of an image
+			 */
+			struct header {
+					char	 magic[4]   = {'l', 'u', 'c', 'o'};
+					uint16_t version    = 1;
+					uint16_t entry_size = sizeof(static_entry);
+					uint32_t entries    = 0;
+					uint32_t chars	    = 0;
+			};
+
+			/**
+			 * @brief checks an image and views its root object. every offset is checked so a broken image is an
+			 * error instead of a read out of bounds
+			 * @param bytes the image, aligned like luco::static_entry since it's read in place
+			 * @return the root object, or an error if the bytes aren't an image for this platform
+			 */
+			inline static expected<static_node, error> try_open(std::span<const unsigned char> bytes) noexcept;
+
+			/**
+			 * @return the root object of an image
+			 * @see try_open()
+			 */
+			inline static static_node open(std::span<const unsigned char> bytes);
+	};
+
+	/**
+	 * @class embed
+	 * @brief compiles a luco text at build time into data to link into a binary, so reading it at startup needs no
+	 * parsing and no filesystem access
+	 * @detail @cpp
+	 * luco::embed defaults(text, "defaults", "app");
+	 * std::string header = defaults.generate(); // the table as constant arrays, app::defaults() views it
+	 * std::string image = defaults.image();     // a blob for #embed, read with luco::static_image::open()
+	 * @ecpp
+	 * the text is parsed like luco::static_document parses it, @include isn't supported and keys can't be repeated
+	 */
+	class embed {
+		private:
+			std::string_view _text;
+			std::string	 _name;
+			std::string	 _namespace;
+
+			inline expected<monostate, error>      check_name() const noexcept;
+			inline expected<static_parsing, error> try_compile() const noexcept;
+			inline std::string		       opening() const;
+			inline std::string		       closing() const;
+
+		public:
+			/**
+			 * @brief constructor for luco::embed
+			 * @param text the luco text, it isn't copied
+			 * @param name the name of the generated accessor, the data is named after it
+			 * @param name_space the namespace of the generated code, none if empty
+			 */
+			inline embed(std::string_view text, const std::string& name, const std::string& name_space = "");
+
+			/**
+			 * @return the document image, or an error if the text can't be parsed
+			 */
+			inline expected<std::string, error> try_image() const noexcept;
+
+			/**
+			 * @return the document image
+			 * @see try_image()
+			 */
+			inline std::string image() const;
+
+			/**
+			 * @return a C++ header holding the table as constexpr arrays and a constexpr accessor returning its
+			 * root object, or an error if the text can't be parsed
+			 */
+			inline expected<std::string, error> try_generate() const noexcept;
+
+			/**
+			 * @return the generated header
+			 * @see try_generate()
+			 */
+			inline std::string generate() const;
+
+			/**
+			 * @brief for big documents, writes a header that pulls an image in with #embed instead of spelling
+			 * the table out. it needs a compiler supporting #embed
+			 * @param image_path the path of the image as written in the #embed directive
+			 * @return the header, or an error if the name isn't an identifier
+			 */
+			inline expected<std::string, error> try_generate_embed(const std::string& image_path) const noexcept;
+
+			/**
+			 * @return the generated header
+			 * @see try_generate_embed()
+			 */
+			inline std::string generate_embed(const std::string& image_path) const;
+	};
+}
+
+namespace luco
+{
+	inline expected<static_node, error> static_image::try_open(std::span<const unsigned char> bytes) noexcept
+	{
+		header head;
+		if (bytes.size() < sizeof(header))
+		{
+			return unexpected(error(error_type::parsing_error, "the image is too small to have a header"));
+		}
+
+		const uint16_t version = head.version;
+		std::memcpy(&head, bytes.data(), sizeof(header));
+		if (std::memcmp(head.magic, "luco", 4) != 0)
+		{
+			return unexpected(error(error_type::parsing_error, "the bytes aren't a luco image"));
+		}
+		else if (head.version != version || head.entry_size != sizeof(static_entry))
+		{
+			return unexpected(error(error_type::parsing_error, "the image was built for another version of luco or another platform"));
+		}
+		else if (head.entries == 0 || bytes.size() != sizeof(header) + head.entries * sizeof(static_entry) + head.chars)
+		{
+			return unexpected(error(error_type::parsing_error, "the size of the image doesn't match its header"));
+		}
+		else if (reinterpret_cast<uintptr_t>(bytes.data()) % alignof(static_entry) != 0)
+		{
+			return unexpected(error(error_type::parsing_error, "the image isn't aligned like luco::static_entry"));
+		}
+
+		auto entries = reinterpret_cast<const static_entry*>(bytes.data() + sizeof(header));
+		auto chars   = reinterpret_cast<const char*>(bytes.data() + sizeof(header) + head.entries * sizeof(static_entry));
+		for (uint32_t i = 0; i < head.entries; i++)
+		{
+			const static_entry& entry = entries[i];
+			bool		    keys  = uint64_t(entry.key) + entry.key_size <= head.chars;
+			bool		    range = false;
+			switch (entry.type)
+			{
+				case node_type::object:
+				case node_type::array:
+					// children always come after their parent, so walking the image ends
+					range = entry.first > i && uint64_t(entry.first) + entry.size <= head.entries;
+					break;
+				case node_type::value:
+					range = entry.value != value_type::string || uint64_t(entry.first) + entry.size <= head.chars;
+					break;
+			}
+
+			if (not keys || not range || (i == 0 && entry.type != node_type::object))
+			{
+				return unexpected(error(error_type::parsing_error, "entry {} of the image is out of its bounds", i));
+			}
+		}
+
+		return static_node(entries, chars);
+	}
+
+	inline static_node static_image::open(std::span<const unsigned char> bytes)
+	{
+		expected<static_node, error> ok = static_image::try_open(bytes);
+		if (not ok)
+		{
+			raise_error(ok.error());
+		}
+
+		return ok.value();
+	}
+
+	inline embed::embed(std::string_view text, const std::string& name, const std::string& name_space)
+	    : _text(text), _name(name), _namespace(name_space)
+	{
+	}
+
+	inline expected<monostate, error> embed::check_name() const noexcept
+	{
+		auto identifier = [](char c) { return std::isalnum(static_cast<unsigned char>(c)) || c == '_'; };
+		if (_name.empty() || std::isdigit(static_cast<unsigned char>(_name.front())) ||
+		    not std::all_of(_name.begin(), _name.end(), identifier))
+		{
+			return unexpected(error(error_type::parsing_error, "'{}' isn't a C++ identifier", _name));
+		}
+
+		return monostate();
+	}
+
+	inline expected<static_parsing, error> embed::try_compile() const noexcept
+	{
+		if (auto ok = this->check_name(); not ok)
+		{
+			return unexpected(ok.error());
+		}
+
+		static_parsing parsing;
+		if (not parsing.parse(_text))
+		{
+			return unexpected(error(error_type::parsing_error, parsing.failure));
+		}
+
+		return parsing;
+	}
+
+	inline std::string embed::opening() const
+	{
+		std::string code = "// generated by luco::embed, don't edit\n\n"
+				   "#pragma once\n\n"
+				   "#include <luco.hpp>\n\n";
+
+		return code + (_namespace.empty() ? "" : std::format("namespace {}\n{{\n", _namespace));
+	}
+
+	inline std::string embed::closing() const
+	{
+		return _namespace.empty() ? "" : "}\n";
+	}
+
+	inline expected<std::string, error> embed::try_image() const noexcept
+	{
+		auto parsing = this->try_compile();
+		if (not parsing)
+		{
+			return unexpected(parsing.error());
+		}
+
+		static_image::header head;
+		head.entries = static_cast<uint32_t>(parsing.value().entries.size());
+		head.chars   = static_cast<uint32_t>(parsing.value().chars.size());
+
+		std::string image(sizeof(head) + head.entries * sizeof(static_entry), '\0');
+		std::memcpy(image.data(), &head, sizeof(head));
+		std::memcpy(image.data() + sizeof(head), parsing.value().entries.data(), head.entries * sizeof(static_entry));
+		image += parsing.value().chars;
+
+		return image;
+	}
+
+	inline std::string embed::image() const
+	{
+		expected<std::string, error> ok = this->try_image();
+		if (not ok)
+		{
+			raise_error(ok.error());
+		}
+
+		return ok.value();
+	}
+
+	inline expected<std::string, error> embed::try_generate() const noexcept
+	{
+		auto parsing = this->try_compile();
+		if (not parsing)
+		{
+			return unexpected(parsing.error());
+		}
+
+		std::string code = this->opening();
+		code += std::format("\tinline constexpr luco::static_entry {}_entries[] = {{\n", _name);
+		for (const static_entry& entry : parsing.value().entries)
+		{
+			std::string number = std::format("{}", entry.number);
+			if (not std::isfinite(entry.number))
+			{
+				number = "std::numeric_limits<double>::infinity()";
+			}
+			else if (number.find_first_of(".e") == std::string::npos)
+			{
+				number += ".0";
+			}
+
+			std::string type  = entry.type == node_type::object ? "object" : entry.type == node_type::array ? "array" : "value";
+			std::string value = "none";
+			switch (entry.value)
+			{
+				case value_type::string:
+					value = "string";
+					break;
+				case value_type::integer:
+					value = "integer";
+					break;
+				case value_type::double_t:
+					value = "double_t";
+					break;
+				case value_type::boolean:
+					value = "boolean";
+					break;
+				case value_type::null:
+					value = "null";
+					break;
+				case value_type::none:
+				case value_type::number:
+				case value_type::temp_escape_type:
+				case value_type::unknown:
+					break;
+			}
+
+			code += std::format("\t\t{{luco::node_type::{}, luco::value_type::{}, {}, {}, {}, {}, {}, {}}},\n", type, value, entry.key,
+					    entry.key_size, entry.first, entry.size, entry.integer, number);
+		}
+		code += "\t};\n\n";
+
+		// octal escapes are always three digits, so a following digit can't extend them
+		code += std::format("\tinline constexpr char {}_chars[] = \"", _name);
+		const std::string& chars = parsing.value().chars;
+		for (size_t i = 0; i < chars.size(); i++)
+		{
+			unsigned char c = static_cast<unsigned char>(chars[i]);
+			if (i != 0 && i % 64 == 0)
+			{
+				code += "\"\n\t\t\"";
+			}
+
+			if (c == '"' || c == '\\' || c == '?' || not std::isprint(c))
+			{
+				code += std::format("\\{:03o}", c);
+			}
+			else
+			{
+				code += static_cast<char>(c);
+			}
+		}
+		code += "\";\n\n";
+
+		code += std::format("\t/**\n\t * @return the root object of the embedded document\n\t */\n"
+				    "\tconstexpr luco::static_node {0}() noexcept\n\t{{\n"
+				    "\t\treturn luco::static_node({0}_entries, {0}_chars);\n\t}}\n",
+				    _name);
+
+		return code + this->closing();
+	}
+
+	inline std::string embed::generate() const
+	{
+		expected<std::string, error> ok = this->try_generate();
+		if (not ok)
+		{
+			raise_error(ok.error());
+		}
+
+		return ok.value();
+	}
+
+	inline expected<std::string, error> embed::try_generate_embed(const std::string& image_path) const noexcept
+	{
+		if (auto ok = this->check_name(); not ok)
+		{
+			return unexpected(ok.error());
+		}
+		else if (image_path.find_first_of("\"\n") != std::string::npos)
+		{
+			return unexpected(error(error_type::parsing_error, "the image path can't have '\"' or a newline"));
+		}
+
+		std::string code = this->opening();
+		code += std::format("\talignas(luco::static_entry) inline constexpr unsigned char {0}_image[] = {{\n"
+				    "#embed \"{1}\"\n"
+				    "\t}};\n\n"
+				    "\t/**\n\t * @return the root object of the embedded document, the image is checked once\n\t */\n"
+				    "\tinline luco::static_node {0}()\n\t{{\n"
+				    "\t\tstatic const luco::static_node root = luco::static_image::open({0}_image);\n"
+				    "\t\treturn root;\n\t}}\n",
+				    _name, image_path);
+
+		return code + this->closing();
+	}
+
+	inline std::string embed::generate_embed(const std::string& image_path) const
+	{
+		expected<std::string, error> ok = this->try_generate_embed(image_path);
+		if (not ok)
+		{
+			raise_error(ok.error());
+		}
+
+		return ok.value();
+	}
+}
@@ -7,6 +7,7 @@
 #pragma once
 
 #include <any>
+#include <atomic>
 #include <cstdint>
 #include <cstring>
 #include <filesystem>
@@ -14,6 +15,7 @@
 #include <iostream>
 #include <memory>
 #include <string>
+#include <string_view>
 #include <map>
 #include <stack>
 #include <fstream>
@@ -45,6 +47,7 @@ namespace luco
 		parsing_error_wrong_type,
 		wrong_type,
 		wronge_index,
+		schema_violation,
 	};
 
 	/**
@@ -53,8 +56,48 @@ namespace luco
 	 */
 	class error {
 		private:
-			error_type  err_type;
-			std::string msg;
+			/**
+			 * @enum deferred
+			 * @brief the errors of the try_* accessors keep their context instead of a message, which is
+			 * formatted the first time message() or what() is called. probing a node for several types doesn't
+			 * allocate a message per miss
+			 */
+			enum class deferred : uint8_t {
+				none,
+				key_not_found,
+				index_not_found,
+				node_cast,
+				value_cast,
+			};
+
+			/**
+			 * @enum state
+			 * @brief whether msg is written. the first thread to format a deferred error marks it as formatting
+			 * and the others wait for it, so what() and message() can be called from several threads at once
+			 */
+			enum class state : uint8_t {
+				formatted,
+				pending,
+				formatting,
+			};
+
+			static constexpr size_t inline_text = 31;
+
+			error_type		   err_type;
+			mutable std::string	   msg;
+			mutable std::atomic<state> _state    = state::formatted;
+			deferred		   _deferred = deferred::none;
+			uint8_t			   _size     = 0;
+			char			   _text[inline_text] = {}; // the key, or the value that couldn't be cast
+			const char*		   _found    = nullptr;
+			const char*		   _expected = nullptr;
+			size_t			   _index    = 0;
+
+			inline error(error_type err, deferred kind) noexcept;
+			inline bool  keep(std::string_view text) noexcept;
+			inline void  format() const noexcept;
+			inline state settled() const noexcept;
+			inline void  copy_context(const error& other) noexcept;
 
 		public:
 			/**
@@ -74,6 +117,11 @@ namespace luco
 			template<typename... args_t>
 			inline error(error_type err, std::format_string<args_t...> fmt, args_t&&... args) noexcept;
 
+			inline error(const error& other) noexcept;
+			inline error(error&& other) noexcept;
+			inline error& operator=(const error& other) noexcept;
+			inline error& operator=(error&& other) noexcept;
+
 			/**
 			 * @brief get the string message of the error
 			 * @return get the string message of the error
@@ -91,7 +139,42 @@ namespace luco
 			 * @return get the luco::error_type of the error
 			 */
 			inline error_type	  value() const noexcept;
+
+			/**
+			 * @brief an error for a missing key, formatted as "key: '{}' not found" when its message is asked for
+			 * @param key the key, copied inline when it's short, the message is formatted right away otherwise
+			 */
+			inline static error key_not_found(std::string_view key) noexcept;
+
+			/**
+			 * @brief an error for an index out of an array, formatted as "index: '{}' not found"
+			 */
+			inline static error index_not_found(size_t index) noexcept;
+
+			/**
+			 * @brief an error for casting a node to the wrong container or to a value
+			 * @param found the type name of the node, such as "node object"
+			 * @param expected what it was cast to, such as "an array"
+			 * @warning both are kept as pointers, they should be string literals
+			 */
+			inline static error node_cast(const char* found, const char* expected) noexcept;
+
+			/**
+			 * @brief an error for casting a value to the wrong type
+			 * @param text the value as text, copied inline when it's short, the message is formatted right away
+			 * otherwise
+			 * @param found the type name of the value, such as "string"
+			 * @param expected the type it was cast to, such as "integer"
+			 * @warning found and expected are kept as pointers, they should be string literals
+			 */
+			inline static error value_cast(std::string_view text, const char* found, const char* expected) noexcept;
 	};
+
+	/**
+	 * @brief how the throwing functions of luco report an error
+	 * @throws the error, or prints it to stderr and aborts with LUCO_NO_EXCEPTIONS
+	 */
+	[[noreturn]] inline void raise_error(const error& e);
 }
 
 namespace luco
@@ -106,13 +189,127 @@ namespace luco
 	{
 	}
 
+	inline error::error(error_type err, deferred kind) noexcept : err_type(err), _state(state::pending), _deferred(kind)
+	{
+	}
+
+	inline error::error(const error& other) noexcept : err_type(other.err_type)
+	{
+		this->copy_context(other);
+		_state.store(other.settled(), std::memory_order_relaxed);
+		msg = _state.load(std::memory_order_relaxed) == state::formatted ? other.msg : std::string();
+	}
+
+	inline error::error(error&& other) noexcept : err_type(other.err_type)
+	{
+		this->copy_context(other);
+		_state.store(other.settled(), std::memory_order_relaxed);
+		msg = std::move(other.msg);
+	}
+
+	inline error& error::operator=(const error& other) noexcept
+	{
+		if (this != &other)
+		{
+			err_type = other.err_type;
+			this->copy_context(other);
+			_state.store(other.settled(), std::memory_order_relaxed);
+			msg = _state.load(std::memory_order_relaxed) == state::formatted ? other.msg : std::string();
+		}
+
+		return *this;
+	}
+
+	inline error& error::operator=(error&& other) noexcept
+	{
+		if (this != &other)
+		{
+			err_type = other.err_type;
+			this->copy_context(other);
+			_state.store(other.settled(), std::memory_order_relaxed);
+			msg = std::move(other.msg);
+		}
+
+		return *this;
+	}
+
+	inline error::state error::settled() const noexcept
+	{
+		// a message being formatted by another thread is waited for, a pending one is copied as its context
+		state current = _state.load(std::memory_order_acquire);
+		while (current == state::formatting)
+		{
+			_state.wait(state::formatting, std::memory_order_acquire);
+			current = _state.load(std::memory_order_acquire);
+		}
+
+		return current;
+	}
+
+	inline void error::copy_context(const error& other) noexcept
+	{
+		_deferred = other._deferred;
+		_size	  = other._size;
+		std::memcpy(_text, other._text, inline_text);
+		_found	  = other._found;
+		_expected = other._expected;
+		_index	  = other._index;
+	}
+
+	inline bool error::keep(std::string_view text) noexcept
+	{
+		if (text.size() > inline_text)
+		{
+			return false;
+		}
+
+		std::memcpy(_text, text.data(), text.size());
+		_size = static_cast<uint8_t>(text.size());
+		return true;
+	}
+
+	inline void error::format() const noexcept
+	{
+		state current = state::pending;
+		if (not _state.compare_exchange_strong(current, state::formatting, std::memory_order_acquire))
+		{
+			// already formatted, or being formatted by another thread
+			this->settled();
+			return;
+		}
+
+		std::string_view text(_text, _size);
+		switch (_deferred)
+		{
+			case deferred::none:
+				break;
+			case deferred::key_not_found:
+				msg = std::format("key: '{}' not found", text);
+				break;
+			case deferred::index_not_found:
+				msg = std::format("index: '{}' not found", _index);
+				break;
+			case deferred::node_cast:
+				msg = std::format("wrong type: trying to cast a '{}' node to {}", _found, _expected);
+				break;
+			case deferred::value_cast:
+				msg = std::format("wrong type: trying to cast the value '{}' which is a '{}' to '{}'", text, _found, _expected);
+				break;
+		}
+
+		_state.store(state::formatted, std::memory_order_release);
+		_state.notify_all();
+	}
+
 	inline const char* error::what() const noexcept
 	{
+		this->format();
 		return msg.c_str();
 	}
 
 	inline const std::string& error::message() const noexcept
 	{
+		this->format();
 		return msg;
 	}
 
@@ -120,4 +317,54 @@ namespace luco
 	{
 		return err_type;
 	}
+
+	inline error error::key_not_found(std::string_view key) noexcept
+	{
+		error e(error_type::key_not_found, deferred::key_not_found);
+		if (not e.keep(key))
+		{
+			return error(error_type::key_not_found, "key: '{}' not found", key);
+		}
+
+		return e;
+	}
+
+	inline error error::index_not_found(size_t index) noexcept
+	{
+		error e(error_type::key_not_found, deferred::index_not_found);
+		e._index = index;
+		return e;
+	}
+
+	inline error error::node_cast(const char* found, const char* expected) noexcept
+	{
+		error e(error_type::wrong_type, deferred::node_cast);
+		e._found    = found;
+		e._expected = expected;
+		return e;
+	}
+
+	inline error error::value_cast(std::string_view text, const char* found, const char* expected) noexcept
+	{
+		error e(error_type::wrong_type, deferred::value_cast);
+		if (not e.keep(text))
+		{
+			return error(error_type::wrong_type, "wrong type: trying to cast the value '{}' which is a '{}' to '{}'", text, found,
+				     expected);
+		}
+
+		e._found    = found;
+		e._expected = expected;
+		return e;
+	}
+
+	inline void raise_error(const error& e)
+	{
+#ifdef LUCO_NO_EXCEPTIONS
+		std::fprintf(stderr, "luco: %s\n", e.what());
+		std::abort();
+#else
+		throw e;
+#endif
+	}
 }
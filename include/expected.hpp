@@ -25,12 +25,38 @@
 #include <cassert>
 #include <source_location>
 #include <type_traits>
+#include <cstdio>
+#include <cstdlib>
+#include <stdexcept>
+
+/**
+ * @brief defined when luco is built without exceptions, by -fno-exceptions or by defining it before including luco.
+ * the throwing functions then print their error to stderr and abort, the try_* functions and luco::expected work the
+ * same
+ */
+#if not defined(LUCO_NO_EXCEPTIONS) && not defined(__cpp_exceptions) && not defined(__EXCEPTIONS) && not defined(_CPPUNWIND)
+#define LUCO_NO_EXCEPTIONS
+#endif
 
 /**
  * @brief the namespace for luco
  */
 namespace luco
 {
+	/**
+	 * @brief reports accessing the wrong state of a luco::expected
+	 * @throws std::runtime_error, or aborts with LUCO_NO_EXCEPTIONS
+	 */
+	[[noreturn]] inline void bad_expected_access(const char* what)
+	{
+#ifdef LUCO_NO_EXCEPTIONS
+		std::fprintf(stderr, "luco: %s\n", what);
+		std::abort();
+#else
+		throw std::runtime_error(what);
+#endif
+	}
+
 	/**
 	 * @class monostate
 	 * @brief an implementation of std::monostate to allow using luco with C++20. check the cppreference
@@ -245,7 +271,7 @@ namespace luco
 	{
 		if (not _has_value)
 		{
-			throw std::runtime_error("Attempted to access the value of a error state");
+			bad_expected_access("Attempted to access the value of a error state");
 		}
 		return _value;
 	}
@@ -255,7 +281,7 @@ namespace luco
 	{
 		if (_has_value)
 		{
-			throw std::runtime_error("Attempted to access the error of a value state");
+			bad_expected_access("Attempted to access the error of a value state");
 		}
 		return _error;
 	}
@@ -265,7 +291,7 @@ namespace luco
 	{
 		if (not _has_value)
 		{
-			throw std::runtime_error("Attempted to access the value of a error state");
+			bad_expected_access("Attempted to access the value of a error state");
 		}
 		return _value;
 	}
@@ -275,7 +301,7 @@ namespace luco
 	{
 		if (_has_value)
 		{
-			throw std::runtime_error("Attempted to access the error of a value state");
+			bad_expected_access("Attempted to access the error of a value state");
 		}
 		return _error;
 	}
@@ -285,7 +311,7 @@ namespace luco
 	{
 		if (not _has_value)
 		{
-			throw std::runtime_error("Attempted to access the value of a error state");
+			bad_expected_access("Attempted to access the value of a error state");
 		}
 		return std::move(_value);
 	}
@@ -295,7 +321,7 @@ namespace luco
 	{
 		if (_has_value)
 		{
-			throw std::runtime_error("Attempted to access the error of a value state");
+			bad_expected_access("Attempted to access the error of a value state");
 		}
 		return std::move(_error);
 	}
@@ -305,7 +331,7 @@ namespace luco
 	{
 		if (not _has_value)
 		{
-			throw std::runtime_error("Attempted to access the value of a error state");
+			bad_expected_access("Attempted to access the value of a error state");
 		}
 		return std::move(_value);
 	}
@@ -315,7 +341,7 @@ namespace luco
 	{
 		if (_has_value)
 		{
-			throw std::runtime_error("Attempted to access the error of a value state");
+			bad_expected_access("Attempted to access the error of a value state");
 		}
 		return std::move(_error);
 	}
@@ -0,0 +1,173 @@
+/*
+ * Copyright: 2025 nodeluna
+ * SPDX-License-Identifier: Apache-2.0
+ * repository: https://github.com/nodeluna/luco
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+
+/**
+ * @brief the namespace for luco
+ */
+namespace luco
+{
+	/**
+	 * @class inline_arena
+	 * @brief a few slots of memory living inside the container using them, so a small container needs no
+	 * allocation of its own. a block takes the first run of free slots it fits in
+	 * @detail copying an arena gives an empty one, the blocks belong to the container that allocated them
+	 */
+	template<size_t block_size, size_t slots>
+	class inline_arena {
+		private:
+			static_assert(slots > 0 && slots < 32, "the slots of luco::inline_arena are one bitmask");
+
+			// slots are rounded so every one of them is aligned like any type
+			static constexpr size_t slot_size =
+			    (block_size + alignof(std::max_align_t) - 1) / alignof(std::max_align_t) * alignof(std::max_align_t);
+
+			alignas(std::max_align_t) unsigned char _bytes[slot_size * slots];
+			uint32_t _used = 0;
+
+		public:
+			inline_arena() noexcept = default;
+
+			inline_arena(const inline_arena&) noexcept
+			{
+			}
+
+			inline_arena& operator=(const inline_arena&) noexcept
+			{
+				return *this;
+			}
+
+			/**
+			 * @return a block from the arena, or nullptr if it has no room for it
+			 */
+			void* allocate(size_t bytes, size_t alignment) noexcept;
+
+			/**
+			 * @brief frees a block if it's from the arena
+			 * @return false if it isn't
+			 */
+			bool deallocate(void* block, size_t bytes) noexcept;
+	};
+
+	/**
+	 * @class inline_allocator
+	 * @brief allocates from an inline_arena while it has room and from the heap after that, so a container
+	 * starts inline and moves to the heap once it grows past the arena
+	 * @detail the allocator isn't propagated when a container is copied, moved or swapped, containers using it
+	 * copy their elements into their own arena instead
+	 */
+	template<typename T, typename arena_t>
+	class inline_allocator {
+		private:
+			template<typename, typename>
+			friend class inline_allocator;
+
+			arena_t* _arena = nullptr;
+
+		public:
+			using value_type				     = T;
+			using propagate_on_container_copy_assignment = std::false_type;
+			using propagate_on_container_move_assignment = std::false_type;
+			using propagate_on_container_swap	     = std::false_type;
+			using is_always_equal			     = std::false_type;
+
+			/**
+			 * @brief an allocator using only the heap
+			 */
+			inline_allocator() noexcept = default;
+
+			explicit inline_allocator(arena_t* arena) noexcept : _arena(arena)
+			{
+			}
+
+			template<typename other_t>
+			inline_allocator(const inline_allocator<other_t, arena_t>& other) noexcept : _arena(other._arena)
+			{
+			}
+
+			T* allocate(size_t count)
+			{
+				if (_arena != nullptr)
+				{
+					if (void* block = _arena->allocate(count * sizeof(T), alignof(T)))
+					{
+						return static_cast<T*>(block);
+					}
+				}
+
+				return std::allocator<T>().allocate(count);
+			}
+
+			void deallocate(T* block, size_t count) noexcept
+			{
+				if (_arena == nullptr || not _arena->deallocate(block, count * sizeof(T)))
+				{
+					std::allocator<T>().deallocate(block, count);
+				}
+			}
+
+			/**
+			 * @return an allocator using only the heap, a copy can outlive the arena
+			 */
+			inline_allocator select_on_container_copy_construction() const noexcept
+			{
+				return inline_allocator();
+			}
+
+			template<typename other_t>
+			bool operator==(const inline_allocator<other_t, arena_t>& other) const noexcept
+			{
+				return _arena == other._arena;
+			}
+	};
+}
+
+namespace luco
+{
+	template<size_t block_size, size_t slots>
+	void* inline_arena<block_size, slots>::allocate(size_t bytes, size_t alignment) noexcept
+	{
+		const size_t needed = (bytes + slot_size - 1) / slot_size;
+		if (needed == 0 || needed > slots || alignment > alignof(std::max_align_t))
+		{
+			return nullptr;
+		}
+
+		const uint32_t run = (uint32_t(1) << needed) - 1;
+		for (size_t i = 0; i + needed <= slots; i++)
+		{
+			if ((_used & (run << i)) == 0)
+			{
+				_used |= run << i;
+				return _bytes + i * slot_size;
+			}
+		}
+
+		return nullptr;
+	}
+
+	template<size_t block_size, size_t slots>
+	bool inline_arena<block_size, slots>::deallocate(void* block, size_t bytes) noexcept
+	{
+		const uintptr_t at    = reinterpret_cast<uintptr_t>(block);
+		const uintptr_t first = reinterpret_cast<uintptr_t>(_bytes);
+		if (at < first || at >= first + sizeof(_bytes))
+		{
+			return false;
+		}
+
+		const size_t   needed = (bytes + slot_size - 1) / slot_size;
+		const uint32_t run    = (uint32_t(1) << needed) - 1;
+		_used &= ~(run << ((at - first) / slot_size));
+		return true;
+	}
+}
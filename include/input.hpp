@@ -0,0 +1,127 @@
+/*
+ * Copyright: 2025 nodeluna
+ * SPDX-License-Identifier: Apache-2.0
+ * repository: https://github.com/nodeluna/luco
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cerrno>
+#include <climits>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <format>
+#include <istream>
+#include "api.hpp"
+#include "parser.hpp"
+#include "expected.hpp"
+#include "error.hpp"
+
+#if defined(_WIN32)
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+/**
+ * @brief the namespace for luco
+ */
+namespace luco
+{
+	inline expected<luco::node, error> parser::try_parse(std::istream& stream, size_t block_size, const parse_options& options) noexcept
+	{
+		struct include_context includes(options, std::filesystem::path());
+		auto		       read_block = [&stream](char* buffer, size_t size) -> expected<size_t, error>
+		{
+			stream.read(buffer, static_cast<std::streamsize>(size));
+			if (stream.bad())
+			{
+				return unexpected(luco::error(error_type::filesystem_error, "couldn't read the stream"));
+			}
+			return static_cast<size_t>(stream.gcount());
+		};
+
+		return luco::parser::parse_blocks(read_block, block_size, std::filesystem::path(), includes, options.schema);
+	}
+
+	inline expected<luco::node, error> parser::try_parse(std::FILE* file, size_t block_size, const parse_options& options) noexcept
+	{
+		assert(file != NULL);
+		struct include_context includes(options, std::filesystem::path());
+		auto		       read_block = [file](char* buffer, size_t size) -> expected<size_t, error>
+		{
+			size_t read = std::fread(buffer, 1, size, file);
+			if (read == 0 && std::ferror(file))
+			{
+				return unexpected(luco::error(error_type::filesystem_error, std::format("couldn't read the file, {}", std::strerror(errno))));
+			}
+			return read;
+		};
+
+		return luco::parser::parse_blocks(read_block, block_size, std::filesystem::path(), includes, options.schema);
+	}
+
+	inline expected<luco::node, error> parser::try_parse_fd(int fd, size_t block_size, const parse_options& options) noexcept
+	{
+		struct include_context includes(options, std::filesystem::path());
+		auto		       read_block = [fd](char* buffer, size_t size) -> expected<size_t, error>
+		{
+			while (true)
+			{
+#if defined(_WIN32)
+				auto read = ::_read(fd, buffer, static_cast<unsigned int>(std::min<size_t>(size, INT_MAX)));
+#else
+				auto read = ::read(fd, buffer, size);
+#endif
+				if (read >= 0)
+				{
+					return static_cast<size_t>(read);
+				}
+				else if (errno != EINTR)
+				{
+					return unexpected(luco::error(error_type::filesystem_error,
+								      std::format("couldn't read file descriptor {}, {}", fd, std::strerror(errno))));
+				}
+			}
+		};
+
+		return luco::parser::parse_blocks(read_block, block_size, std::filesystem::path(), includes, options.schema);
+	}
+
+	inline luco::node parser::parse(std::istream& stream, size_t block_size, const parse_options& options)
+	{
+		expected<luco::node, error> ok = luco::parser::try_parse(stream, block_size, options);
+		if (not ok)
+		{
+			raise_error(ok.error());
+		}
+
+		return ok.value();
+	}
+
+	inline luco::node parser::parse(std::FILE* file, size_t block_size, const parse_options& options)
+	{
+		expected<luco::node, error> ok = luco::parser::try_parse(file, block_size, options);
+		if (not ok)
+		{
+			raise_error(ok.error());
+		}
+
+		return ok.value();
+	}
+
+	inline luco::node parser::parse_fd(int fd, size_t block_size, const parse_options& options)
+	{
+		expected<luco::node, error> ok = luco::parser::try_parse_fd(fd, block_size, options);
+		if (not ok)
+		{
+			raise_error(ok.error());
+		}
+
+		return ok.value();
+	}
+}
@@ -0,0 +1,574 @@
+/*
+ * Copyright: 2025 nodeluna
+ * SPDX-License-Identifier: Apache-2.0
+ * repository: https://github.com/nodeluna/luco
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cerrno>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <variant>
+#include "api.hpp"
+#include "parser.hpp"
+#include "simd.hpp"
+#include "expected.hpp"
+#include "error.hpp"
+
+/**
+ * @brief the namespace for luco
+ */
+namespace luco
+{
+	/**
+	 * @class json_reader
+	 * @brief a recursive descent JSON parser producing luco::node trees. it doesn't go through the luco state machine,
+	 * strings are scanned with luco::simd and numbers are converted with std::from_chars
+	 */
+	class json_reader {
+		private:
+			const char* _begin;
+			const char* _cur;
+			const char* _end;
+			size_t	    _line   = 1;
+			size_t	    _column = 1;
+
+			inline error			     fail(const char* at, std::string_view what) const;
+			inline void			     skip_whitespace() noexcept;
+			inline expected<luco::node, error>   read_value(size_t depth);
+			inline expected<luco::node, error>   read_object(size_t depth);
+			inline expected<luco::node, error>   read_array(size_t depth);
+			inline expected<std::string, error>  read_string();
+			inline expected<luco::node, error>   read_number();
+			inline expected<std::variant<int64_t, double>, error> read_number_value();
+			inline expected<luco::node, error>   read_literal(std::string_view literal, luco::node&& node);
+			inline expected<monostate, error>    read_escape(std::string& out);
+
+			template<typename value_type>
+			inline static luco::node make_value(value_type&& value)
+			{
+				return luco::node(luco_node(std::make_shared<luco::value>(std::forward<value_type>(value))));
+			}
+
+		public:
+			static constexpr size_t max_depth = 1024;
+
+			/**
+			 * @brief constructor for luco::json_reader
+			 * @param text the JSON text, it isn't copied
+			 */
+			inline explicit json_reader(std::string_view text) noexcept;
+
+			/**
+			 * @brief constructor for a window in the middle of a bigger JSON text, errors are located relative to it
+			 * @param text the JSON text, it isn't copied
+			 * @param line the line of the first character of text
+			 * @param column the column of the first character of text
+			 */
+			inline json_reader(std::string_view text, size_t line, size_t column) noexcept;
+
+			/**
+			 * @brief parses the whole text as one JSON value
+			 * @return luco::node or luco::error
+			 */
+			inline expected<luco::node, error> read();
+
+			friend class transcoder;
+	};
+}
+
+namespace luco
+{
+	inline json_reader::json_reader(std::string_view text) noexcept
+	    : _begin(text.data()), _cur(text.data()), _end(text.data() + text.size())
+	{
+	}
+
+	inline json_reader::json_reader(std::string_view text, size_t line, size_t column) noexcept
+	    : _begin(text.data()), _cur(text.data()), _end(text.data() + text.size()), _line(line), _column(column)
+	{
+	}
+
+	inline error json_reader::fail(const char* at, std::string_view what) const
+	{
+		// the location is only computed once something fails
+		size_t line   = _line + std::count(_begin, at, '\n');
+		auto   start  = std::find(std::make_reverse_iterator(at), std::make_reverse_iterator(_begin), '\n').base();
+		size_t column = static_cast<size_t>(at - start) + (start == _begin ? _column : 1);
+
+		if (at == _end)
+		{
+			return error(error_type::parsing_error, "{}:{} {} but reached the end of the text", line, column, what);
+		}
+		return error(error_type::parsing_error, "{}:{} {} but found '{}'", line, column, what, *at);
+	}
+
+	inline void json_reader::skip_whitespace() noexcept
+	{
+		_cur = simd::skip_json_whitespace(_cur, _end);
+	}
+
+	inline expected<luco::node, error> json_reader::read()
+	{
+		this->skip_whitespace();
+		expected<luco::node, error> node = this->read_value(0);
+		if (not node)
+		{
+			return node;
+		}
+
+		this->skip_whitespace();
+		if (_cur != _end)
+		{
+			return unexpected(this->fail(_cur, "expected the end of the text after the JSON value"));
+		}
+
+		return node;
+	}
+
+	inline expected<luco::node, error> json_reader::read_value(size_t depth)
+	{
+		if (_cur == _end)
+		{
+			return unexpected(this->fail(_cur, "expected a JSON value"));
+		}
+		else if (depth == max_depth)
+		{
+			return unexpected(error(error_type::parsing_error, "JSON is nested deeper than {} levels", max_depth));
+		}
+
+		switch (*_cur)
+		{
+			case '{':
+				return this->read_object(depth + 1);
+			case '[':
+				return this->read_array(depth + 1);
+			case '"':
+			{
+				auto string = this->read_string();
+				if (not string)
+				{
+					return unexpected(string.error());
+				}
+				return json_reader::make_value(std::move(string.value()));
+			}
+			case 't':
+				return this->read_literal("true", json_reader::make_value(true));
+			case 'f':
+				return this->read_literal("false", json_reader::make_value(false));
+			case 'n':
+				return this->read_literal("null", json_reader::make_value(luco::null));
+			default:
+				return this->read_number();
+		}
+	}
+
+	inline expected<luco::node, error> json_reader::read_object(size_t depth)
+	{
+		luco::node object(node_type::object);
+		auto	   members = object.as_object();
+
+		_cur++;
+		this->skip_whitespace();
+		if (_cur != _end && *_cur == '}')
+		{
+			_cur++;
+			return object;
+		}
+
+		while (true)
+		{
+			if (_cur == _end || *_cur != '"')
+			{
+				return unexpected(this->fail(_cur, "expected a '\"' starting an object key"));
+			}
+
+			auto key = this->read_string();
+			if (not key)
+			{
+				return unexpected(key.error());
+			}
+
+			this->skip_whitespace();
+			if (_cur == _end || *_cur != ':')
+			{
+				return unexpected(this->fail(_cur, "expected ':' after an object key"));
+			}
+			_cur++;
+			this->skip_whitespace();
+
+			auto value = this->read_value(depth);
+			if (not value)
+			{
+				return value;
+			}
+			members->insert(key.value(), std::move(value.value()));
+
+			this->skip_whitespace();
+			if (_cur != _end && *_cur == ',')
+			{
+				_cur++;
+				this->skip_whitespace();
+			}
+			else if (_cur != _end && *_cur == '}')
+			{
+				_cur++;
+				return object;
+			}
+			else
+			{
+				return unexpected(this->fail(_cur, "expected ',' or '}' after an object member"));
+			}
+		}
+	}
+
+	inline expected<luco::node, error> json_reader::read_array(size_t depth)
+	{
+		luco::node array(node_type::array);
+		auto	   elements = array.as_array();
+
+		_cur++;
+		this->skip_whitespace();
+		if (_cur != _end && *_cur == ']')
+		{
+			_cur++;
+			return array;
+		}
+
+		while (true)
+		{
+			auto value = this->read_value(depth);
+			if (not value)
+			{
+				return value;
+			}
+			elements->push_back(std::move(value.value()));
+
+			this->skip_whitespace();
+			if (_cur != _end && *_cur == ',')
+			{
+				_cur++;
+				this->skip_whitespace();
+			}
+			else if (_cur != _end && *_cur == ']')
+			{
+				_cur++;
+				return array;
+			}
+			else
+			{
+				return unexpected(this->fail(_cur, "expected ',' or ']' after an array element"));
+			}
+		}
+	}
+
+	inline expected<std::string, error> json_reader::read_string()
+	{
+		const char* opening = _cur++;
+		std::string string;
+		while (true)
+		{
+			// copies everything up to the next quote, escape or control character at once
+			const char* special = simd::find_string_special(_cur, _end);
+			string.append(_cur, special);
+			_cur = special;
+
+			if (_cur == _end)
+			{
+				return unexpected(this->fail(_cur, std::format("expected '\"' closing the string started at offset {}", opening - _begin)));
+			}
+			else if (*_cur == '"')
+			{
+				_cur++;
+				return string;
+			}
+			else if (*_cur == '\\')
+			{
+				auto ok = this->read_escape(string);
+				if (not ok)
+				{
+					return unexpected(ok.error());
+				}
+			}
+			else
+			{
+				return unexpected(this->fail(_cur, "expected an escaped control character in a string"));
+			}
+		}
+	}
+
+	inline expected<monostate, error> json_reader::read_escape(std::string& out)
+	{
+		const char* escape = _cur++;
+		if (_cur == _end)
+		{
+			return unexpected(this->fail(_cur, "expected an escape sequence"));
+		}
+
+		auto read_hex = [this](uint32_t& code) -> bool
+		{
+			if (_end - _cur < 4)
+			{
+				return false;
+			}
+			auto [ptr, ec] = std::from_chars(_cur, _cur + 4, code, 16);
+			if (ec != std::errc() || ptr != _cur + 4)
+			{
+				return false;
+			}
+			_cur += 4;
+			return true;
+		};
+
+		switch (*_cur++)
+		{
+			case '"':
+				out += '"';
+				return monostate();
+			case '\\':
+				out += '\\';
+				return monostate();
+			case '/':
+				out += '/';
+				return monostate();
+			case 'b':
+				out += '\b';
+				return monostate();
+			case 'f':
+				out += '\f';
+				return monostate();
+			case 'n':
+				out += '\n';
+				return monostate();
+			case 'r':
+				out += '\r';
+				return monostate();
+			case 't':
+				out += '\t';
+				return monostate();
+			case 'u':
+				break;
+			default:
+				return unexpected(this->fail(escape + 1, "expected a valid escape character"));
+		}
+
+		uint32_t code = 0;
+		if (not read_hex(code))
+		{
+			return unexpected(this->fail(escape, "expected 4 hex digits after '\\u'"));
+		}
+		else if (code >= 0xD800 && code <= 0xDBFF)
+		{
+			uint32_t low = 0;
+			if (_end - _cur < 2 || _cur[0] != '\\' || _cur[1] != 'u' || (_cur += 2, not read_hex(low)) || low < 0xDC00 ||
+			    low > 0xDFFF)
+			{
+				return unexpected(this->fail(escape, "expected a low surrogate after a high surrogate"));
+			}
+			code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+		}
+		else if (code >= 0xDC00 && code <= 0xDFFF)
+		{
+			return unexpected(this->fail(escape, "expected a high surrogate before a low surrogate"));
+		}
+
+		if (code < 0x80)
+		{
+			out += static_cast<char>(code);
+		}
+		else if (code < 0x800)
+		{
+			out += static_cast<char>(0xC0 | (code >> 6));
+			out += static_cast<char>(0x80 | (code & 0x3F));
+		}
+		else if (code < 0x10000)
+		{
+			out += static_cast<char>(0xE0 | (code >> 12));
+			out += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+			out += static_cast<char>(0x80 | (code & 0x3F));
+		}
+		else
+		{
+			out += static_cast<char>(0xF0 | (code >> 18));
+			out += static_cast<char>(0x80 | ((code >> 12) & 0x3F));
+			out += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+			out += static_cast<char>(0x80 | (code & 0x3F));
+		}
+
+		return monostate();
+	}
+
+	inline expected<luco::node, error> json_reader::read_number()
+	{
+		auto number = this->read_number_value();
+		if (not number)
+		{
+			return unexpected(number.error());
+		}
+
+		return std::visit([](auto value) { return json_reader::make_value(value); }, number.value());
+	}
+
+	inline expected<std::variant<int64_t, double>, error> json_reader::read_number_value()
+	{
+		const char* start = _cur;
+		const char* p	  = _cur;
+		auto	    digit = [&](const char* at) { return at != _end && *at >= '0' && *at <= '9'; };
+
+		// from_chars is more lenient than JSON, so the grammar is checked first
+		if (p != _end && *p == '-')
+		{
+			p++;
+		}
+		if (not digit(p))
+		{
+			return unexpected(this->fail(start, "expected a JSON value"));
+		}
+		else if (*p == '0')
+		{
+			p++;
+		}
+		else
+		{
+			while (digit(p))
+			{
+				p++;
+			}
+		}
+
+		bool integer = true;
+		if (p != _end && *p == '.')
+		{
+			integer = false;
+			p++;
+			if (not digit(p))
+			{
+				return unexpected(this->fail(p, "expected a digit after '.'"));
+			}
+			while (digit(p))
+			{
+				p++;
+			}
+		}
+		if (p != _end && (*p == 'e' || *p == 'E'))
+		{
+			integer = false;
+			p++;
+			if (p != _end && (*p == '+' || *p == '-'))
+			{
+				p++;
+			}
+			if (not digit(p))
+			{
+				return unexpected(this->fail(p, "expected a digit in the exponent"));
+			}
+			while (digit(p))
+			{
+				p++;
+			}
+		}
+
+		_cur = p;
+		if (integer)
+		{
+			int64_t number	= 0;
+			auto [ptr, ec]	= std::from_chars(start, p, number);
+			if (ec == std::errc() && ptr == p)
+			{
+				return std::variant<int64_t, double>(number);
+			}
+		}
+
+		double number  = 0;
+		auto [ptr, ec] = std::from_chars(start, p, number);
+		if (ec != std::errc() || ptr != p)
+		{
+			return unexpected(this->fail(start, "expected a number that fits in a double"));
+		}
+
+		return std::variant<int64_t, double>(number);
+	}
+
+	inline expected<luco::node, error> json_reader::read_literal(std::string_view literal, luco::node&& node)
+	{
+		if (static_cast<size_t>(_end - _cur) < literal.size() || std::string_view(_cur, literal.size()) != literal)
+		{
+			return unexpected(this->fail(_cur, "expected a JSON value"));
+		}
+
+		_cur += literal.size();
+		return std::move(node);
+	}
+
+	inline expected<luco::node, error> parser::try_parse_json(const std::filesystem::path& path) noexcept
+	{
+		std::ifstream file(path, std::ios::binary);
+		if (not file.is_open())
+		{
+			return unexpected(luco::error(error_type::filesystem_error,
+						      std::format("couldn't open '{}', {}", path.string(), std::strerror(errno))));
+		}
+
+		std::error_code ec;
+		std::string	raw_json;
+		raw_json.resize(std::filesystem::file_size(path, ec));
+		file.read(raw_json.data(), static_cast<std::streamsize>(raw_json.size()));
+		raw_json.resize(static_cast<size_t>(file.gcount()));
+
+		return json_reader(raw_json).read();
+	}
+
+	inline expected<luco::node, error> parser::try_parse_json(const std::string& raw_json) noexcept
+	{
+		return json_reader(raw_json).read();
+	}
+
+	inline expected<luco::node, error> parser::try_parse_json(const char* raw_json) noexcept
+	{
+		assert(raw_json != NULL);
+		return json_reader(raw_json).read();
+	}
+
+	inline luco::node parser::parse_json(const std::filesystem::path& path)
+	{
+		expected<luco::node, error> ok = luco::parser::try_parse_json(path);
+		if (not ok)
+		{
+			raise_error(ok.error());
+		}
+
+		return ok.value();
+	}
+
+	inline luco::node parser::parse_json(const std::string& raw_json)
+	{
+		expected<luco::node, error> ok = luco::parser::try_parse_json(raw_json);
+		if (not ok)
+		{
+			raise_error(ok.error());
+		}
+
+		return ok.value();
+	}
+
+	inline luco::node parser::parse_json(const char* raw_json)
+	{
+		expected<luco::node, error> ok = luco::parser::try_parse_json(raw_json);
+		if (not ok)
+		{
+			raise_error(ok.error());
+		}
+
+		return ok.value();
+	}
+}
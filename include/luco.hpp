@@ -8,5 +8,20 @@
 
 #include "api.hpp"
 #include "parser.hpp"
+#include "input.hpp"
+#include "document.hpp"
+#include "scanner.hpp"
+#include "static_document.hpp"
+#include "embed.hpp"
+#include "visit.hpp"
+#include "projection.hpp"
+#include "schema.hpp"
+#include "codegen.hpp"
+#include "stream.hpp"
+#include "simd.hpp"
+#include "json.hpp"
+#include "transcode.hpp"
+#include "async.hpp"
+#include "parallel.hpp"
 #include "expected.hpp"
 #include "concepts.hpp"
@@ -0,0 +1,529 @@
+/*
+ * Copyright: 2025 nodeluna
+ * SPDX-License-Identifier: Apache-2.0
+ * repository: https://github.com/nodeluna/luco
+ */
+
+#pragma once
+
+#include <bit>
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief the namespace for luco
+ */
+namespace luco
+{
+	/**
+	 * @class ordered_map
+	 * @brief a map keeping its keys in the order they were inserted. every entry has an allocation of its own and the
+	 * map keeps a vector of pointers to them in order, small maps are searched linearly and bigger ones through an
+	 * open addressing index of positions in that vector. luco::object is stored in it when LUCO_ORDERED_OBJECTS is
+	 * defined
+	 * @detail like with std::map, references to the entries stay valid while other keys are inserted or erased, only
+	 * the iterators are invalidated by inserting and erasing. erasing is linear since the pointers after the erased
+	 * ones are moved and the index is rebuilt. the keys must not be changed through an iterator
+	 */
+	template<typename mapped_t, typename allocator_t = std::allocator<std::pair<std::string, mapped_t>>>
+	class ordered_map {
+		public:
+			using key_type	     = std::string;
+			using mapped_type    = mapped_t;
+			using value_type     = std::pair<std::string, mapped_t>;
+			using size_type	     = size_t;
+			using allocator_type = allocator_t;
+
+		private:
+			using traits	       = std::allocator_traits<allocator_t>;
+			using pointers_t       = std::vector<value_type*, typename traits::template rebind_alloc<value_type*>>;
+
+			// up to this many keys a linear scan beats hashing the key
+			static constexpr size_t linear_limit = 8;
+
+			allocator_t _allocator;
+			pointers_t  _entries;
+			std::vector<uint32_t> _slots; // the position of an entry + 1, 0 for an empty slot
+
+			size_t slot_of(std::string_view key) const noexcept;
+			void   reindex();
+			void   destroy(value_type* entry) noexcept;
+
+			template<typename value_t>
+			value_type* create(const std::string& key, value_t&& value);
+
+		public:
+			/**
+			 * @class basic_iterator
+			 * @brief iterates the entries of the map in order
+			 */
+			template<bool is_const>
+			class basic_iterator {
+				private:
+					friend class ordered_map;
+					template<bool>
+					friend class basic_iterator;
+
+					using base_t =
+					    std::conditional_t<is_const, typename pointers_t::const_iterator, typename pointers_t::iterator>;
+
+					base_t _at;
+
+					explicit basic_iterator(base_t at) noexcept : _at(at)
+					{
+					}
+
+				public:
+					using iterator_category = std::random_access_iterator_tag;
+					using value_type	= typename ordered_map::value_type;
+					using difference_type	= std::ptrdiff_t;
+					using pointer		= std::conditional_t<is_const, const value_type*, value_type*>;
+					using reference		= std::conditional_t<is_const, const value_type&, value_type&>;
+
+					basic_iterator() = default;
+
+					/**
+					 * @brief an iterator converts to a const_iterator
+					 */
+					template<bool other_const>
+						requires(is_const && not other_const)
+					basic_iterator(const basic_iterator<other_const>& other) noexcept : _at(other._at)
+					{
+					}
+
+					reference operator*() const noexcept
+					{
+						return **_at;
+					}
+
+					pointer operator->() const noexcept
+					{
+						return *_at;
+					}
+
+					reference operator[](difference_type offset) const noexcept
+					{
+						return *_at[offset];
+					}
+
+					basic_iterator& operator++() noexcept
+					{
+						++_at;
+						return *this;
+					}
+
+					basic_iterator operator++(int) noexcept
+					{
+						return basic_iterator(_at++);
+					}
+
+					basic_iterator& operator--() noexcept
+					{
+						--_at;
+						return *this;
+					}
+
+					basic_iterator operator--(int) noexcept
+					{
+						return basic_iterator(_at--);
+					}
+
+					basic_iterator& operator+=(difference_type offset) noexcept
+					{
+						_at += offset;
+						return *this;
+					}
+
+					basic_iterator& operator-=(difference_type offset) noexcept
+					{
+						_at -= offset;
+						return *this;
+					}
+
+					friend basic_iterator operator+(basic_iterator itr, difference_type offset) noexcept
+					{
+						return itr += offset;
+					}
+
+					friend basic_iterator operator+(difference_type offset, basic_iterator itr) noexcept
+					{
+						return itr += offset;
+					}
+
+					friend basic_iterator operator-(basic_iterator itr, difference_type offset) noexcept
+					{
+						return itr -= offset;
+					}
+
+					friend difference_type operator-(const basic_iterator& left, const basic_iterator& right) noexcept
+					{
+						return left._at - right._at;
+					}
+
+					friend bool operator==(const basic_iterator& left, const basic_iterator& right) noexcept
+					{
+						return left._at == right._at;
+					}
+
+					friend auto operator<=>(const basic_iterator& left, const basic_iterator& right) noexcept
+					{
+						return left._at <=> right._at;
+					}
+			};
+
+			using iterator	     = basic_iterator<false>;
+			using const_iterator = basic_iterator<true>;
+
+			ordered_map() = default;
+
+			/**
+			 * @brief constructor for luco::ordered_map
+			 * @param allocator allocates the entries and the pointers to them, the index is always on the heap
+			 */
+			explicit ordered_map(const allocator_t& allocator) : _allocator(allocator), _entries(allocator)
+			{
+			}
+
+			/**
+			 * @brief copies every entry with the allocator the other map selects for a copy
+			 */
+			ordered_map(const ordered_map& other)
+			    : ordered_map(traits::select_on_container_copy_construction(other._allocator))
+			{
+				*this = other;
+			}
+
+			/**
+			 * @brief takes the entries of the other map, which is left empty
+			 */
+			ordered_map(ordered_map&& other) noexcept
+			    : _allocator(other._allocator), _entries(std::move(other._entries)), _slots(std::move(other._slots))
+			{
+				other._entries.clear();
+				other._slots.clear();
+			}
+
+			/**
+			 * @brief copies every entry, the map keeps its own allocator
+			 */
+			ordered_map& operator=(const ordered_map& other);
+
+			/**
+			 * @brief takes the entries of the other map if both use the same allocator and copies them otherwise
+			 */
+			ordered_map& operator=(ordered_map&& other);
+
+			~ordered_map()
+			{
+				this->clear();
+			}
+
+			/**
+			 * @brief reserves room for a number of entries
+			 */
+			void reserve(size_type count)
+			{
+				_entries.reserve(count);
+			}
+
+			/**
+			 * @brief find a key
+			 * @return iterator of the found key or end()
+			 */
+			iterator find(std::string_view key) noexcept;
+
+			/**
+			 * @brief find a key
+			 * @return iterator of the found key or end()
+			 */
+			const_iterator find(std::string_view key) const noexcept;
+
+			/**
+			 * @return true if the map has the key
+			 */
+			bool contains(std::string_view key) const noexcept;
+
+			/**
+			 * @brief access a key, appending it with a default constructed value if it doesn't exist
+			 * @return a reference to the value of the key
+			 */
+			mapped_t& operator[](const std::string& key);
+
+			/**
+			 * @brief set the value of a key, appending the key if it doesn't exist
+			 * @return iterator of the key and true if it was appended
+			 */
+			template<typename value_t>
+			std::pair<iterator, bool> insert_or_assign(const std::string& key, value_t&& value);
+
+			/**
+			 * @brief remove a key
+			 * @return the number of keys removed
+			 */
+			size_type erase(std::string_view key);
+
+			/**
+			 * @brief remove an entry
+			 * @return iterator following the removed entry
+			 */
+			iterator erase(const_iterator pos);
+
+			/**
+			 * @brief remove a range of entries
+			 * @return iterator following the last removed entry
+			 */
+			iterator erase(const_iterator begin, const_iterator end);
+
+			size_type size() const noexcept
+			{
+				return _entries.size();
+			}
+
+			bool empty() const noexcept
+			{
+				return _entries.empty();
+			}
+
+			void clear() noexcept
+			{
+				for (value_type* entry : _entries)
+				{
+					this->destroy(entry);
+				}
+				_entries.clear();
+				_slots.clear();
+			}
+
+			iterator begin() noexcept
+			{
+				return iterator(_entries.begin());
+			}
+
+			iterator end() noexcept
+			{
+				return iterator(_entries.end());
+			}
+
+			const_iterator begin() const noexcept
+			{
+				return const_iterator(_entries.begin());
+			}
+
+			const_iterator end() const noexcept
+			{
+				return const_iterator(_entries.end());
+			}
+	};
+}
+
+namespace luco
+{
+	template<typename mapped_t, typename allocator_t>
+	size_t ordered_map<mapped_t, allocator_t>::slot_of(std::string_view key) const noexcept
+	{
+		// the index is never more than half full, so probing always ends on the key or an empty slot
+		const size_t mask = _slots.size() - 1;
+		for (size_t i = std::hash<std::string_view>{}(key) & mask;; i = (i + 1) & mask)
+		{
+			if (_slots[i] == 0 || _entries[_slots[i] - 1]->first == key)
+			{
+				return i;
+			}
+		}
+	}
+
+	template<typename mapped_t, typename allocator_t>
+	void ordered_map<mapped_t, allocator_t>::reindex()
+	{
+		_slots.clear();
+		if (_entries.size() <= linear_limit)
+		{
+			return;
+		}
+
+		_slots.resize(std::bit_ceil(_entries.size() * 2));
+		for (size_t i = 0; i < _entries.size(); i++)
+		{
+			_slots[this->slot_of(_entries[i]->first)] = static_cast<uint32_t>(i + 1);
+		}
+	}
+
+	template<typename mapped_t, typename allocator_t>
+	void ordered_map<mapped_t, allocator_t>::destroy(value_type* entry) noexcept
+	{
+		traits::destroy(_allocator, entry);
+		traits::deallocate(_allocator, entry, 1);
+	}
+
+	template<typename mapped_t, typename allocator_t>
+	template<typename value_t>
+	typename ordered_map<mapped_t, allocator_t>::value_type* ordered_map<mapped_t, allocator_t>::create(
+	    const std::string& key, value_t&& value)
+	{
+		// gives the memory back if constructing the entry throws
+		struct held {
+				allocator_t& allocator;
+				value_type*  entry;
+
+				~held()
+				{
+					if (entry != nullptr)
+					{
+						traits::deallocate(allocator, entry, 1);
+					}
+				}
+		} block{_allocator, traits::allocate(_allocator, 1)};
+
+		traits::construct(_allocator, block.entry, key, std::forward<value_t>(value));
+		return std::exchange(block.entry, nullptr);
+	}
+
+	template<typename mapped_t, typename allocator_t>
+	ordered_map<mapped_t, allocator_t>& ordered_map<mapped_t, allocator_t>::operator=(const ordered_map& other)
+	{
+		if (this == &other)
+		{
+			return *this;
+		}
+
+		this->clear();
+		_entries.reserve(other._entries.size());
+		for (const value_type* entry : other._entries)
+		{
+			_entries.push_back(this->create(entry->first, entry->second));
+		}
+		_slots = other._slots;
+		return *this;
+	}
+
+	template<typename mapped_t, typename allocator_t>
+	ordered_map<mapped_t, allocator_t>& ordered_map<mapped_t, allocator_t>::operator=(ordered_map&& other)
+	{
+		if (_allocator != other._allocator)
+		{
+			return *this = std::as_const(other);
+		}
+
+		if (this != &other)
+		{
+			this->clear();
+			_entries.swap(other._entries);
+			_slots.swap(other._slots);
+		}
+		return *this;
+	}
+
+	template<typename mapped_t, typename allocator_t>
+	typename ordered_map<mapped_t, allocator_t>::iterator ordered_map<mapped_t, allocator_t>::find(std::string_view key) noexcept
+	{
+		auto itr = std::as_const(*this).find(key);
+		return this->begin() + (itr - std::as_const(*this).begin());
+	}
+
+	template<typename mapped_t, typename allocator_t>
+	typename ordered_map<mapped_t, allocator_t>::const_iterator ordered_map<mapped_t, allocator_t>::find(std::string_view key) const noexcept
+	{
+		if (_slots.empty())
+		{
+			for (auto itr = _entries.begin(); itr != _entries.end(); itr++)
+			{
+				if ((*itr)->first == key)
+				{
+					return const_iterator(itr);
+				}
+			}
+
+			return this->end();
+		}
+
+		const uint32_t slot = _slots[this->slot_of(key)];
+		return slot == 0 ? this->end() : this->begin() + (slot - 1);
+	}
+
+	template<typename mapped_t, typename allocator_t>
+	bool ordered_map<mapped_t, allocator_t>::contains(std::string_view key) const noexcept
+	{
+		return this->find(key) != this->end();
+	}
+
+	template<typename mapped_t, typename allocator_t>
+	mapped_t& ordered_map<mapped_t, allocator_t>::operator[](const std::string& key)
+	{
+		if (auto itr = this->find(key); itr != this->end())
+		{
+			return itr->second;
+		}
+
+		return this->insert_or_assign(key, mapped_t()).first->second;
+	}
+
+	template<typename mapped_t, typename allocator_t>
+	template<typename value_t>
+	std::pair<typename ordered_map<mapped_t, allocator_t>::iterator, bool> ordered_map<mapped_t, allocator_t>::insert_or_assign(
+	    const std::string& key, value_t&& value)
+	{
+		if (auto itr = this->find(key); itr != this->end())
+		{
+			itr->second = std::forward<value_t>(value);
+			return {itr, false};
+		}
+
+		// room for the pointer first, so a failed allocation leaves no entry behind
+		if (_entries.size() == _entries.capacity())
+		{
+			_entries.reserve(_entries.size() * 2 + 1);
+		}
+		_entries.push_back(this->create(key, std::forward<value_t>(value)));
+		if (_entries.size() > linear_limit && _entries.size() * 2 > _slots.size())
+		{
+			this->reindex();
+		}
+		else if (not _slots.empty())
+		{
+			_slots[this->slot_of(key)] = static_cast<uint32_t>(_entries.size());
+		}
+
+		return {this->end() - 1, true};
+	}
+
+	template<typename mapped_t, typename allocator_t>
+	typename ordered_map<mapped_t, allocator_t>::size_type ordered_map<mapped_t, allocator_t>::erase(std::string_view key)
+	{
+		auto itr = std::as_const(*this).find(key);
+		if (itr == this->end())
+		{
+			return 0;
+		}
+
+		this->erase(itr);
+		return 1;
+	}
+
+	template<typename mapped_t, typename allocator_t>
+	typename ordered_map<mapped_t, allocator_t>::iterator ordered_map<mapped_t, allocator_t>::erase(const_iterator pos)
+	{
+		return this->erase(pos, pos + 1);
+	}
+
+	template<typename mapped_t, typename allocator_t>
+	typename ordered_map<mapped_t, allocator_t>::iterator ordered_map<mapped_t, allocator_t>::erase(const_iterator begin, const_iterator end)
+	{
+		const size_t first = begin - std::as_const(*this).begin();
+		for (auto itr = begin._at; itr != end._at; itr++)
+		{
+			this->destroy(*itr);
+		}
+		_entries.erase(begin._at, end._at);
+		this->reindex();
+		return this->begin() + first;
+	}
+}
@@ -0,0 +1,507 @@
+/*
+ * Copyright: 2025 nodeluna
+ * SPDX-License-Identifier: Apache-2.0
+ * repository: https://github.com/nodeluna/luco
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <type_traits>
+#include <variant>
+#include <vector>
+#include "api.hpp"
+#include "async.hpp"
+#include "expected.hpp"
+#include "error.hpp"
+
+/**
+ * @brief the namespace for luco
+ */
+namespace luco
+{
+	/**
+	 * @brief the execution policies of luco::for_each(), luco::transform_values() and luco::count_if()
+	 */
+	namespace execution
+	{
+		/**
+		 * @struct sequenced_policy
+		 * @brief walks the tree on the calling thread, in the order of the document
+		 */
+		struct sequenced_policy {
+		};
+
+		/**
+		 * @struct parallel_policy
+		 * @brief splits big arrays and objects into ranges that the calling thread and thread_pool::compute()
+		 * share by stealing them from each other
+		 */
+		struct parallel_policy {
+				/**
+				 * @brief the number of threads walking the tree with the calling thread, one per core if 0
+				 */
+				size_t threads = 0;
+
+				/**
+				 * @brief the number of children a range is split down to, smaller containers are walked by
+				 * one thread
+				 */
+				size_t grain = 1024;
+		};
+
+		inline constexpr sequenced_policy seq;
+		inline constexpr parallel_policy  par;
+	}
+
+	/**
+	 * @brief the execution policies taken by the luco algorithms
+	 */
+	template<typename policy_t>
+	concept is_execution_policy = std::is_same_v<std::remove_cvref_t<policy_t>, execution::sequenced_policy> ||
+				      std::is_same_v<std::remove_cvref_t<policy_t>, execution::parallel_policy>;
+
+	/**
+	 * @class tree_walk
+	 * @brief calls a function on every value under a node, the algorithms below are built on it. in parallel each
+	 * thread has a queue of ranges, it takes the last one it pushed and steals the first one of another thread
+	 * when its own is empty, so the biggest ranges move between threads and the small ones stay where they're warm.
+	 * containers smaller than the grain are walked in place, but once a child took a grain of work and a thread is
+	 * idle the siblings left are pushed too, so deep trees of small containers are shared as well. idle threads
+	 * sleep until a range is pushed or the walk ends
+	 */
+	class tree_walk {
+		private:
+			struct range {
+					std::shared_ptr<std::vector<luco::node*>> children; // the children of a big object
+					luco::node*				  elements = nullptr; // the elements of a big array
+					size_t					  begin	   = 0;
+					size_t					  end	   = 0;
+
+					luco::node& operator[](size_t i) const
+					{
+						return elements != nullptr ? elements[i] : *(*children)[i];
+					}
+			};
+
+			struct queue {
+					std::mutex	  mutex;
+					std::deque<range> ranges;
+			};
+
+			template<typename body_t>
+			struct walk {
+					std::vector<queue>  queues;
+					std::atomic<size_t> pending = 0;
+					std::atomic<size_t> counted = 0;
+					std::atomic<size_t> idle    = 0;
+					std::atomic<size_t> signal  = 0; // bumped on every push and at the end, idle threads wait on it
+					size_t		    grain;
+					body_t*		    body;
+#ifndef LUCO_NO_EXCEPTIONS
+					std::atomic<bool>  failed = false;
+					std::mutex	   mutex;
+					std::exception_ptr error;
+#endif
+
+					walk(size_t threads, size_t grain, body_t& body) : queues(threads), grain(std::max<size_t>(grain, 1)), body(&body)
+					{
+					}
+			};
+
+			template<typename body_t>
+			static void push(walk<body_t>& walk, size_t self, range&& range);
+
+			template<typename body_t>
+			static std::optional<range> take(walk<body_t>& walk, size_t self);
+
+			template<typename body_t>
+			static bool hand_off(walk<body_t>& walk, size_t done, size_t left) noexcept;
+
+			template<typename body_t>
+			static size_t visit(walk<body_t>& walk, size_t self, const luco::node& node, size_t& counted);
+
+			template<typename body_t>
+			static void run(walk<body_t>& walk, size_t self, range part, size_t& counted);
+
+			template<typename body_t>
+			static void work(walk<body_t>& walk, size_t self);
+
+		public:
+			/**
+			 * @brief calls the body on every value in the order of the document
+			 * @param body callable with luco::value&, returning whether to count the value
+			 * @return the number of values counted
+			 */
+			template<typename body_t>
+			static size_t sequenced(const luco::node& node, body_t& body);
+
+			/**
+			 * @brief calls the body on every value from as many threads as the policy asks for. the first
+			 * exception thrown by the body stops the walk and is rethrown on the calling thread
+			 * @param body callable with luco::value& from any thread, returning whether to count the value
+			 * @return the number of values counted
+			 */
+			template<typename body_t>
+			static size_t parallel(const execution::parallel_policy& policy, const luco::node& node, body_t& body);
+	};
+
+	/**
+	 * @brief calls a function on every value under a node
+	 * @param policy luco::execution::seq to call it in the order of the document on the calling thread, or
+	 * luco::execution::par to call it from several threads in no particular order
+	 * @param function callable with luco::value&, it can change the value but not the tree holding it
+	 * @detail @cpp
+	 * std::atomic<size_t> bytes = 0;
+	 * luco::for_each(luco::execution::par, inventory, [&](luco::value& value) {
+	 *	if (value.is_string()) bytes += value.as_string().size();
+	 * });
+	 * @ecpp
+	 */
+	template<is_execution_policy policy_t, typename function_t>
+		requires std::is_invocable_v<function_t&, luco::value&>
+	void for_each(policy_t&& policy, const luco::node& node, function_t&& function);
+
+	/**
+	 * @brief replaces every value under a node with what a function returns for it. each value is written by one
+	 * thread and in its own place, so the result is the same with every policy
+	 * @param function callable with luco::value&, returning a luco::value or anything a luco::value is constructed
+	 * from
+	 * @detail @cpp
+	 * luco::transform_values(luco::execution::par, inventory, [](luco::value& value) -> luco::value {
+	 *	if (value.is_string() && value.as_string().starts_with("http://old."))
+	 *		return "http://new." + value.as_string().substr(11);
+	 *	return value;
+	 * });
+	 * @ecpp
+	 */
+	template<is_execution_policy policy_t, typename function_t>
+		requires std::is_constructible_v<luco::value, std::invoke_result_t<function_t&, luco::value&>>
+	void transform_values(policy_t&& policy, const luco::node& node, function_t&& function);
+
+	/**
+	 * @brief counts the values under a node a predicate is true for
+	 * @param predicate callable with luco::value&, returning something convertible to bool
+	 * @return the number of values, the same with every policy
+	 */
+	template<is_execution_policy policy_t, typename predicate_t>
+		requires std::is_invocable_v<predicate_t&, luco::value&>
+	size_t count_if(policy_t&& policy, const luco::node& node, predicate_t&& predicate);
+}
+
+namespace luco
+{
+	template<typename body_t>
+	void tree_walk::push(walk<body_t>& walk, size_t self, range&& range)
+	{
+		// counted before it can be taken, so pending only reaches 0 once every range is walked
+		walk.pending.fetch_add(1, std::memory_order_relaxed);
+		{
+			std::lock_guard lock(walk.queues[self].mutex);
+			walk.queues[self].ranges.push_back(std::move(range));
+		}
+
+		walk.signal.fetch_add(1, std::memory_order_release);
+		walk.signal.notify_one();
+	}
+
+	template<typename body_t>
+	std::optional<tree_walk::range> tree_walk::take(walk<body_t>& walk, size_t self)
+	{
+		for (size_t i = 0; i < walk.queues.size(); i++)
+		{
+			queue&		victim = walk.queues[(self + i) % walk.queues.size()];
+			std::lock_guard lock(victim.mutex);
+			if (victim.ranges.empty())
+			{
+				continue;
+			}
+
+			range taken;
+			if (i == 0)
+			{
+				taken = std::move(victim.ranges.back());
+				victim.ranges.pop_back();
+			}
+			else
+			{
+				taken = std::move(victim.ranges.front());
+				victim.ranges.pop_front();
+			}
+
+			return taken;
+		}
+
+		return std::nullopt;
+	}
+
+	template<typename body_t>
+	bool tree_walk::hand_off(walk<body_t>& walk, size_t done, size_t left) noexcept
+	{
+		// the siblings left are guessed to take as long as the one just walked, the second half of them is pushed
+		return left >= 2 && done * left >= walk.grain && walk.idle.load(std::memory_order_relaxed) != 0;
+	}
+
+	template<typename body_t>
+	size_t tree_walk::visit(walk<body_t>& walk, size_t self, const luco::node& node, size_t& counted)
+	{
+		if (auto val = std::get_if<0>(&node._node))
+		{
+			counted += (*walk.body)(**val) ? 1 : 0;
+			return 1;
+		}
+
+		size_t visited = 1;
+		if (auto arr = std::get_if<1>(&node._node))
+		{
+			luco::array& array = **arr;
+			if (array.size() >= walk.grain)
+			{
+				tree_walk::push(walk, self, range{nullptr, &array[0], 0, array.size()});
+				return visited;
+			}
+
+			for (size_t i = 0, end = array.size(); i < end; i++)
+			{
+				size_t done = tree_walk::visit(walk, self, array[i], counted);
+				visited += done;
+				if (tree_walk::hand_off(walk, done, end - i - 1))
+				{
+					size_t middle = end - (end - i - 1) / 2;
+					tree_walk::push(walk, self, range{nullptr, &array[0], middle, end});
+					end = middle;
+				}
+			}
+		}
+		else
+		{
+			luco::object& object = *std::get<2>(node._node);
+			auto	      pushed = [&](auto from, size_t size)
+			{
+				auto children = std::make_shared<std::vector<luco::node*>>();
+				children->reserve(size);
+				for (; from != object.end(); from++)
+				{
+					children->push_back(&from->second);
+				}
+
+				tree_walk::push(walk, self, range{children, nullptr, 0, children->size()});
+			};
+
+			if (object.size() >= walk.grain)
+			{
+				pushed(object.begin(), object.size());
+				return visited;
+			}
+
+			size_t left = object.size();
+			for (auto itr = object.begin(), end = object.end(); itr != end; itr++)
+			{
+				size_t done = tree_walk::visit(walk, self, itr->second, counted);
+				visited += done;
+				if (tree_walk::hand_off(walk, done, --left))
+				{
+					end = std::next(itr, static_cast<std::ptrdiff_t>(left - left / 2 + 1));
+					pushed(end, left / 2);
+					left -= left / 2;
+				}
+			}
+		}
+
+		return visited;
+	}
+
+	template<typename body_t>
+	void tree_walk::run(walk<body_t>& walk, size_t self, range part, size_t& counted)
+	{
+		// the halves are left to be stolen while this thread keeps the first one
+		while (part.end - part.begin > walk.grain)
+		{
+			size_t middle = part.begin + (part.end - part.begin) / 2;
+			tree_walk::push(walk, self, range{part.children, part.elements, middle, part.end});
+			part.end = middle;
+		}
+
+		for (size_t i = part.begin; i < part.end; i++)
+		{
+			size_t done = tree_walk::visit(walk, self, part[i], counted);
+			if (tree_walk::hand_off(walk, done, part.end - i - 1))
+			{
+				size_t middle = part.end - (part.end - i - 1) / 2;
+				tree_walk::push(walk, self, range{part.children, part.elements, middle, part.end});
+				part.end = middle;
+			}
+		}
+	}
+
+	template<typename body_t>
+	void tree_walk::work(walk<body_t>& walk, size_t self)
+	{
+		while (true)
+		{
+			// read before looking for a range, a push or the end after it changes the signal and wakes the wait
+			size_t signal = walk.signal.load(std::memory_order_acquire);
+			if (walk.pending.load(std::memory_order_acquire) == 0)
+			{
+				return;
+			}
+
+			std::optional<range> taken = tree_walk::take(walk, self);
+			if (not taken)
+			{
+				walk.idle.fetch_add(1, std::memory_order_relaxed);
+				walk.signal.wait(signal, std::memory_order_acquire);
+				walk.idle.fetch_sub(1, std::memory_order_relaxed);
+				continue;
+			}
+
+			size_t counted = 0;
+#ifdef LUCO_NO_EXCEPTIONS
+			tree_walk::run(walk, self, std::move(*taken), counted);
+#else
+			// after a failure the ranges left are only drained
+			if (not walk.failed.load(std::memory_order_relaxed))
+			{
+				try
+				{
+					tree_walk::run(walk, self, std::move(*taken), counted);
+				}
+				catch (...)
+				{
+					std::lock_guard lock(walk.mutex);
+					if (not walk.failed.exchange(true))
+					{
+						walk.error = std::current_exception();
+					}
+				}
+			}
+#endif
+
+			walk.counted.fetch_add(counted, std::memory_order_relaxed);
+			if (walk.pending.fetch_sub(1, std::memory_order_acq_rel) == 1)
+			{
+				walk.signal.fetch_add(1, std::memory_order_release);
+				walk.signal.notify_all();
+			}
+		}
+	}
+
+	template<typename body_t>
+	size_t tree_walk::sequenced(const luco::node& node, body_t& body)
+	{
+		if (auto val = std::get_if<0>(&node._node))
+		{
+			return body(**val) ? 1 : 0;
+		}
+
+		size_t counted = 0;
+		if (auto arr = std::get_if<1>(&node._node))
+		{
+			for (auto& child : **arr)
+			{
+				counted += tree_walk::sequenced(child, body);
+			}
+		}
+		else
+		{
+			for (auto& [key, child] : *std::get<2>(node._node))
+			{
+				counted += tree_walk::sequenced(child, body);
+			}
+		}
+
+		return counted;
+	}
+
+	template<typename body_t>
+	size_t tree_walk::parallel(const execution::parallel_policy& policy, const luco::node& node, body_t& body)
+	{
+		size_t threads = policy.threads != 0 ? policy.threads : std::thread::hardware_concurrency();
+		if (threads <= 1 || std::holds_alternative<std::shared_ptr<class value>>(node._node))
+		{
+			return tree_walk::sequenced(node, body);
+		}
+
+		// the helpers share the walk, one posted after the walk is done finds nothing pending and returns
+		auto shared = std::make_shared<walk<body_t>>(threads, policy.grain, body);
+		tree_walk::push(*shared, 0, range{nullptr, const_cast<luco::node*>(&node), 0, 1});
+		for (size_t i = 1; i < threads; i++)
+		{
+			thread_pool::compute().post([shared, i]() { tree_walk::work(*shared, i); });
+		}
+
+		tree_walk::work(*shared, 0);
+#ifndef LUCO_NO_EXCEPTIONS
+		if (shared->failed.load())
+		{
+			std::rethrow_exception(shared->error);
+		}
+#endif
+
+		return shared->counted.load(std::memory_order_acquire);
+	}
+
+	template<is_execution_policy policy_t, typename function_t>
+		requires std::is_invocable_v<function_t&, luco::value&>
+	void for_each(policy_t&& policy, const luco::node& node, function_t&& function)
+	{
+		auto body = [&function](luco::value& value)
+		{
+			function(value);
+			return false;
+		};
+
+		if constexpr (std::is_same_v<std::remove_cvref_t<policy_t>, execution::parallel_policy>)
+		{
+			tree_walk::parallel(policy, node, body);
+		}
+		else
+		{
+			tree_walk::sequenced(node, body);
+		}
+	}
+
+	template<is_execution_policy policy_t, typename function_t>
+		requires std::is_constructible_v<luco::value, std::invoke_result_t<function_t&, luco::value&>>
+	void transform_values(policy_t&& policy, const luco::node& node, function_t&& function)
+	{
+		auto body = [&function](luco::value& value)
+		{
+			value = luco::value(function(value));
+			return false;
+		};
+
+		if constexpr (std::is_same_v<std::remove_cvref_t<policy_t>, execution::parallel_policy>)
+		{
+			tree_walk::parallel(policy, node, body);
+		}
+		else
+		{
+			tree_walk::sequenced(node, body);
+		}
+	}
+
+	template<is_execution_policy policy_t, typename predicate_t>
+		requires std::is_invocable_v<predicate_t&, luco::value&>
+	size_t count_if(policy_t&& policy, const luco::node& node, predicate_t&& predicate)
+	{
+		auto body = [&predicate](luco::value& value) { return static_cast<bool>(predicate(value)); };
+
+		if constexpr (std::is_same_v<std::remove_cvref_t<policy_t>, execution::parallel_policy>)
+		{
+			return tree_walk::parallel(policy, node, body);
+		}
+		else
+		{
+			return tree_walk::sequenced(node, body);
+		}
+	}
+}
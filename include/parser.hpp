@@ -7,22 +7,31 @@
 #pragma once
 
 #include <algorithm>
+#include <charconv>
+#include <chrono>
 #include <any>
 #include <cstddef>
 #include <cstdint>
+#include <cstdio>
 #include <cstring>
 #include <filesystem>
 #include <initializer_list>
 #include <iostream>
 #include <memory>
 #include <string>
+#include <string_view>
 #include <map>
+#include <optional>
 #include <set>
 #include <stack>
+#include <thread>
 #include <fstream>
 #include <format>
 #include <functional>
+#include <future>
+#include <mutex>
 #include <tuple>
+#include <unordered_map>
 #include <unordered_set>
 #include <utility>
 #include <variant>
@@ -34,17 +43,81 @@
 #include "expected.hpp"
 #include "error.hpp"
 #include "log.hpp"
+#include "simd.hpp"
+#include "schema.hpp"
 
 /**
  * @brief the namespace for luco
  */
 namespace luco
 {
+	/**
+	 * @struct parse_options
+	 * @brief optional checks done while parsing. they also apply to the files included by the parsed one
+	 */
+	struct parse_options {
+			/**
+			 * @brief rejects keys and values that aren't valid UTF-8, the error points at the first invalid byte
+			 */
+			bool validate_utf8 = false;
+
+			/**
+			 * @brief converts the values at the key paths it declares straight to their declared type instead of
+			 * guessing it. it has to outlive the parsing, and it doesn't apply to included files
+			 */
+			const luco::schema* schema = nullptr;
+
+			/**
+			 * @brief replaces '@include' values with the content of the file they name. off by default so
+			 * parsing untrusted text never reads other files, an '@include' value is then a plain string
+			 */
+			bool allow_includes = false;
+
+			/**
+			 * @brief included files have to be inside this directory. when empty it's the directory of the
+			 * parsed file, or the current directory for text that isn't a file
+			 */
+			std::filesystem::path include_root;
+
+			/**
+			 * @brief the most threads parsing included files at once, 0 is the number of hardware threads. the
+			 * files past that are parsed by the thread that waits for them
+			 */
+			size_t include_threads = 0;
+
+			// not an aggregate, so a braced projection such as {{"a", "b"}} never converts to it
+			parse_options() = default;
+	};
+
 	class parser {
 		private:
 			inline static bool			 done_or_not_ok(const expected<bool, error>& ok);
 			inline static expected<monostate, error> return_error_if_not_ok(const expected<bool, error>& ok);
 			inline static expected<monostate, error> parsing(struct parsing_data& data, struct syntax& syntax);
+			inline static expected<luco::node, error> parse_file(const std::filesystem::path& path, struct include_context& includes,
+									     const luco::schema* schema = nullptr) noexcept;
+			inline static expected<luco::node, error> parse_string(const std::string& raw_json, struct parsing_data& data,
+									       const parse_options& options = parse_options()) noexcept;
+			inline static expected<luco::node, error> parse_blocks(const std::function<expected<size_t, error>(char*, size_t)>& read_block,
+									       size_t block_size, const std::filesystem::path& source_path,
+									       struct include_context& includes,
+									       const luco::schema*     schema = nullptr) noexcept;
+			inline static expected<luco::node, error> resolve_includes(struct parsing_data& data, luco::node& luco_data);
+			inline static void			  splice_includes(luco::node&						    node,
+									  const std::unordered_map<const void*, luco::node>& resolved);
+			inline static luco::node		  copy_tree(const luco::node& node);
+
+			inline static expected<luco::node, error> parse_projected(class chunked_source& source, const class projection& projection,
+									  const std::filesystem::path&			     source_path,
+									  const std::function<expected<luco::node, error>()>& parse_whole) noexcept;
+			inline static expected<monostate, error>  stream_array_from(class chunked_source&			 source,
+										    const std::vector<std::string>&		 key_path,
+										    const std::function<bool(luco::node&)>& consumer) noexcept;
+
+			friend struct include_context;
+			friend struct projected_parsing;
+			friend class document;
+			friend struct incremental_parsing;
 
 		public:
 			inline static luco::node		  parse(const std::filesystem::path& path);
@@ -53,6 +126,58 @@ namespace luco
 			inline static expected<luco::node, error> try_parse(const std::filesystem::path& path) noexcept;
 			inline static expected<luco::node, error> try_parse(const std::string& raw_json) noexcept;
 			inline static expected<luco::node, error> try_parse(const char* raw_json) noexcept;
+			inline static luco::node		  parse(const std::filesystem::path& path, const parse_options& options);
+			inline static luco::node		  parse(const std::string& raw_json, const parse_options& options);
+			inline static luco::node		  parse(const char* raw_json, const parse_options& options);
+			inline static expected<luco::node, error> try_parse(const std::filesystem::path& path, const parse_options& options) noexcept;
+			inline static expected<luco::node, error> try_parse(const std::string& raw_json, const parse_options& options) noexcept;
+			inline static expected<luco::node, error> try_parse(const char* raw_json, const parse_options& options) noexcept;
+
+			static constexpr size_t			  default_block_size = 1 << 16;
+
+			/**
+			 * @brief parses everything left in a stream, reading it block by block. works with pipes and stdin
+			 * @param block_size the size of every read, one buffer of this size is reused for all of them
+			 * @param options checks done while parsing
+			 */
+			inline static luco::node parse(std::istream& stream, size_t block_size = default_block_size,
+						       const parse_options& options = parse_options());
+			inline static luco::node parse(std::FILE* file, size_t block_size = default_block_size,
+						       const parse_options& options = parse_options());
+			inline static luco::node parse_fd(int fd, size_t block_size = default_block_size,
+							  const parse_options& options = parse_options());
+			inline static expected<luco::node, error> try_parse(std::istream& stream, size_t block_size = default_block_size,
+									    const parse_options& options = parse_options()) noexcept;
+			inline static expected<luco::node, error> try_parse(std::FILE* file, size_t block_size = default_block_size,
+									    const parse_options& options = parse_options()) noexcept;
+			inline static expected<luco::node, error> try_parse_fd(int fd, size_t block_size = default_block_size,
+									       const parse_options& options = parse_options()) noexcept;
+			inline static luco::node		  parse(const std::filesystem::path& path, const class projection& projection);
+			inline static luco::node		  parse(const std::string& raw_json, const class projection& projection);
+			inline static luco::node		  parse(const char* raw_json, const class projection& projection);
+			inline static expected<luco::node, error> try_parse(const std::filesystem::path& path,
+									    const class projection& projection) noexcept;
+			inline static expected<luco::node, error> try_parse(const std::string& raw_json, const class projection& projection) noexcept;
+			inline static expected<luco::node, error> try_parse(const char* raw_json, const class projection& projection) noexcept;
+			inline static luco::node		  parse_json(const std::filesystem::path& path);
+			inline static luco::node		  parse_json(const std::string& raw_json);
+			inline static luco::node		  parse_json(const char* raw_json);
+			inline static expected<luco::node, error> try_parse_json(const std::filesystem::path& path) noexcept;
+			inline static expected<luco::node, error> try_parse_json(const std::string& raw_json) noexcept;
+			inline static expected<luco::node, error> try_parse_json(const char* raw_json) noexcept;
+			inline static void			  stream_array(const std::filesystem::path& path, const std::vector<std::string>& key_path,
+									       const std::function<bool(luco::node&)>& consumer);
+			inline static void			  stream_array(const std::string& raw_json, const std::vector<std::string>& key_path,
+									       const std::function<bool(luco::node&)>& consumer);
+			inline static void			  stream_array(const char* raw_json, const std::vector<std::string>& key_path,
+									       const std::function<bool(luco::node&)>& consumer);
+			inline static expected<monostate, error>  try_stream_array(const std::filesystem::path& path,
+										   const std::vector<std::string>& key_path,
+										   const std::function<bool(luco::node&)>& consumer) noexcept;
+			inline static expected<monostate, error>  try_stream_array(const std::string& raw_json, const std::vector<std::string>& key_path,
+										   const std::function<bool(luco::node&)>& consumer) noexcept;
+			inline static expected<monostate, error>  try_stream_array(const char* raw_json, const std::vector<std::string>& key_path,
+										   const std::function<bool(luco::node&)>& consumer) noexcept;
 	};
 
 	enum class luco_syntax {
@@ -160,7 +285,7 @@ namespace luco
 			std::set<char>			 _not	       = {};
 			std::set<luco_syntax>		 pop	       = {};
 			std::multimap<luco_syntax, char> expected      = {};
-			std::set<char>			 special_chars = {'{', '=', '}', '"', '\'', '\\'};
+			static constexpr std::string_view special_chars = "{=}\"'\\";
 
 			inline virtual bool		 is_end_of_token(struct parsing_data& _);
 			inline bool			 handle_is(struct parsing_data&, const std::set<luco_syntax>&);
@@ -212,6 +337,45 @@ namespace luco
 		append = 1 << 2,
 	};
 
+	/**
+	 * @struct include_context
+	 * @brief state shared by one top-level parse to resolve '@include' values. every included file is parsed once,
+	 * on its own thread while fewer than max_threads are running, and every place that includes it gets its own copy
+	 * of the resulting node
+	 */
+	struct include_context {
+			using included_file = std::shared_future<expected<luco::node, error>>;
+
+			std::mutex							  mutex;
+			std::map<std::filesystem::path, included_file>			  files;
+			std::map<std::filesystem::path, std::set<std::filesystem::path>> edges;
+			bool								  enabled	= false;
+			bool								  validate_utf8 = false;
+			std::filesystem::path						  root;
+			size_t								  max_threads = 1;
+			size_t								  threads     = 0;
+
+			include_context() = default;
+			inline include_context(const parse_options& options, const std::filesystem::path& source_path);
+
+			inline expected<included_file, error> request(const std::filesystem::path& origin, const std::string& include_path);
+			inline std::vector<std::filesystem::path> find_chain(const std::filesystem::path& from,
+									     const std::filesystem::path& to) const;
+			inline ~include_context();
+	};
+
+	/**
+	 * @struct source_span
+	 * @brief the location of a luco object or array in the parsed text, from its '{' to its '}'
+	 */
+	struct source_span {
+			size_t	   begin    = 0;
+			size_t	   end	    = 0;
+			size_t	   line	    = 1;
+			bool	   in_array = false;
+			luco::node node;
+	};
+
 	struct parsing_data {
 			std::string					    line;
 			size_t						    i					= 0;
@@ -224,8 +388,57 @@ namespace luco
 			std::pair<std::string, luco_value_type>		    raw_value		 = {"", luco_value_type::none};
 			class value					    value;
 			std::stack<std::pair<luco_syntax, std::pair<size_t, size_t>>> hierarchy;
+			struct include_context*					      includes = nullptr;
+			std::filesystem::path					      source_path;
+			std::vector<std::pair<luco::node, include_context::included_file>> pending_includes;
+			size_t								   line_offset = 0;
+			std::pair<size_t, size_t>					   opening_bracket_at = {0, 1};
+			std::stack<struct source_span>					   containers_at;
+			std::vector<struct source_span>*				   spans = nullptr;
+			bool								   validate_utf8 = false;
+			const luco::schema*						   schema = nullptr;
+			std::vector<const schema::entry*>				   schema_at;
 	};
 
+	inline void mark_opening_bracket(struct parsing_data& data)
+	{
+		data.opening_bracket_at = std::make_pair(data.line_offset + data.i, data.line_number);
+	}
+
+	inline struct source_span opened_span(const struct parsing_data& data, const luco::node& container)
+	{
+		return source_span{data.opening_bracket_at.first, 0, data.opening_bracket_at.second, data.luco_objs.top()->is_array(),
+				   container};
+	}
+
+	inline void push_container(struct parsing_data& data, luco::node* container)
+	{
+		if (data.spans != nullptr)
+		{
+			data.containers_at.push(opened_span(data, *container));
+		}
+		data.luco_objs.push(container);
+	}
+
+	inline void record_span(struct parsing_data& data, struct source_span&& span)
+	{
+		if (data.spans != nullptr)
+		{
+			span.end = data.line_offset + data.i;
+			data.spans->push_back(std::move(span));
+		}
+	}
+
+	inline void pop_container(struct parsing_data& data)
+	{
+		if (not data.containers_at.empty())
+		{
+			record_span(data, std::move(data.containers_at.top()));
+			data.containers_at.pop();
+		}
+		data.luco_objs.pop();
+	}
+
 	inline std::string error_location(const struct parsing_data& data, std::optional<std::pair<size_t, size_t>> location = std::nullopt)
 	{
 		size_t line_number = 1;
@@ -261,6 +474,87 @@ namespace luco
 		return err_str;
 	}
 
+	inline expected<monostate, error> validate_line_utf8(struct parsing_data& data)
+	{
+		const char* invalid = simd::find_invalid_utf8(data.line.data(), data.line.data() + data.line.size());
+		if (invalid == data.line.data() + data.line.size())
+		{
+			return monostate();
+		}
+
+		data.i = static_cast<size_t>(invalid - data.line.data()) + 1;
+		return unexpected(error(error_type::parsing_error, "{} invalid UTF-8 byte 0x{:02X}", error_location(data),
+					static_cast<unsigned char>(*invalid)));
+	}
+
+	/**
+	 * @brief follows the schema into an object or array that was just inserted into the top container
+	 * @param key the key it was inserted at, ignored in arrays
+	 * @param type whether an object or an array was inserted
+	 */
+	inline expected<monostate, error> enter_schema(struct parsing_data& data, const std::string& key, node_type type)
+	{
+		if (data.schema_at.empty())
+		{
+			return monostate();
+		}
+
+		const schema::entry* parent = data.schema_at.back();
+		const schema::entry* entry =
+		    parent == nullptr ? nullptr : data.schema->find(*parent, data.luco_objs.top()->is_object() ? key : schema::element);
+		if (entry != nullptr && entry->type)
+		{
+			return unexpected(error(error_type::parsing_error_wrong_type, "{} expected {} but found an object or array",
+						error_location(data), schema::type_name(entry->type.value())));
+		}
+		else if (entry != nullptr && entry->shape && entry->shape != type)
+		{
+			return unexpected(error(error_type::parsing_error_wrong_type, "{} expected {} but found {}", error_location(data),
+						entry->shape == node_type::object ? "an object" : "an array",
+						type == node_type::object ? "an object" : "an array"));
+		}
+		data.schema_at.push_back(entry);
+
+		return monostate();
+	}
+
+	/**
+	 * @brief checks a node against the entry the schema declares for it, reporting the broken rule with its location
+	 */
+	inline expected<monostate, error> check_schema(const struct parsing_data& data, const schema::entry* entry, const luco::node& node)
+	{
+		if (entry == nullptr)
+		{
+			return monostate();
+		}
+
+		auto ok = data.schema->check(*entry, node);
+		if (not ok)
+		{
+			return unexpected(error(ok.error().value() == error_type::wrong_type ? error_type::parsing_error_wrong_type
+											     : ok.error().value(),
+						"{} {}", error_location(data), ok.error().message()));
+		}
+
+		return monostate();
+	}
+
+	/**
+	 * @brief leaves the entry of an object or array once it's complete, checking its required keys and size
+	 */
+	inline expected<monostate, error> leave_schema(struct parsing_data& data, const luco::node& container)
+	{
+		if (data.schema_at.empty())
+		{
+			return monostate();
+		}
+
+		const schema::entry* entry = data.schema_at.back();
+		data.schema_at.pop_back();
+
+		return check_schema(data, entry, container);
+	}
+
 	inline std::string dump_data(const parsing_data& data)
 	{
 		std::string dump = "[data dump]\n";
@@ -317,7 +611,7 @@ namespace luco
 
 			assert(data.line[data.i] == ch);
 
-			if (auto itr = special_chars.find(ch); itr != special_chars.end())
+			if (special_chars.find(ch) != std::string_view::npos)
 			{
 				if (not this->is_escaped(data, ch))
 				{
@@ -345,7 +639,7 @@ namespace luco
 
 			assert(data.line[data.i] == expect.second);
 
-			if (auto itr = special_chars.find(expect.second); itr != special_chars.end())
+			if (special_chars.find(expect.second) != std::string_view::npos)
 			{
 				if (not this->is_escaped(data, expect.second))
 				{
@@ -381,11 +675,9 @@ namespace luco
 			escape_char	   = '\0';
 		};
 
-		std::set<char> special_chars = {'{', '=', '}', '"', '\'', '\\'};
-
 		if (data.i + 1 < data.line.size() && data.line[data.i + 1] == ch)
 		{
-			if (auto itr = special_chars.find(ch); itr == special_chars.end())
+			if (special_chars.find(ch) == std::string_view::npos)
 			{
 				reset_escape_char();
 				return false;
@@ -510,44 +802,110 @@ namespace luco
 				_int
 			};
 
-			inline static std::variant<std::string, bool, double, int64_t, null_type> get_type(const std::string& raw_value)
+			using simple_type = std::variant<std::string, bool, double, int64_t, null_type>;
+
+			/**
+			 * @return the typed value of a raw value, or an error if it's a number out of the range of its type
+			 */
+			inline static expected<simple_type, error> get_type(const std::string& raw_value) noexcept
 			{
 				if (luco_simple_types::is_null(raw_value))
 				{
-					return null_type();
+					return simple_type(null_type());
 				}
 				else if (auto is_number = luco_simple_types::is_number(raw_value); is_number != number_types::none)
 				{
-					switch (is_number)
+					const char* begin = raw_value.data();
+					const char* end	  = raw_value.data() + raw_value.size();
+					int64_t	    integer = 0;
+					double	    number  = 0;
+					auto [ptr, ec]	    = is_number == number_types::_int ? std::from_chars(begin, end, integer)
+											      : std::from_chars(begin, end, number);
+					if (ec != std::errc() || ptr != end)
 					{
-						case number_types::_int:
-							return std::stoll(raw_value);
-						case number_types::_float:
-							return std::stod(raw_value);
-						case number_types::none:
-							assert(false && "oopsie in luco type deduction: check the number_types enum");
-							return false;
+						return unexpected(error(error_type::parsing_error, "the number '{}' is out of range", raw_value));
 					}
-					return false;
+
+					return is_number == number_types::_int ? simple_type(integer) : simple_type(number);
 				}
 				else if (auto is_bool = luco_simple_types::is_boolean(raw_value); is_bool != boolean_types::none)
 				{
-					switch (is_bool)
+					return simple_type(is_bool == boolean_types::_true);
+				}
+				else
+				{
+					return simple_type(raw_value);
+				}
+			}
+
+			/**
+			 * @brief writes a key or a string value quoted and escaped the way the parser reads it back
+			 * @return an error if no luco text is read back as the same string, such as a value with a newline or '}'
+			 */
+			inline static expected<monostate, error> write_string(std::string& out, std::string_view string, bool key)
+			{
+				auto unrepresentable = [&]()
+				{ return unexpected(error(error_type::wrong_type, "the {} '{}' can't be written in luco", key ? "key" : "string", string)); };
+
+				// a string that isn't a valid number, such as one out of range, can't be read back
+				auto typed = key ? expected<luco_simple_types::simple_type, error>() : luco_simple_types::get_type(std::string(string));
+				if (not typed)
+				{
+					return unrepresentable();
+				}
+				else if (not string.empty() && string.find_first_of("={}#\"'\\\n\r") == std::string_view::npos)
+				{
+					bool bare = key && string.find_first_of(" \t") == std::string_view::npos;
+					out += bare ? "" : "\"";
+					out += string;
+					out += bare ? "" : "\"";
+					return monostate();
+				}
+
+				// escaped the way the parser unescapes, then read back by the parser itself since some characters, such as
+				// '}' or a newline, can't be written in every place
+				const char  quote   = string.find('"') != std::string_view::npos && string.find('\'') == std::string_view::npos ? '\'' : '"';
+				std::string written = std::string(1, quote);
+				for (char ch : string)
+				{
+					written += ch;
+					if (ch == quote || ch == '{' || ch == '\\' || (key && ch == '='))
 					{
-						case boolean_types::_true:
-							return true;
-						case boolean_types::_false:
-							return false;
-						case boolean_types::none:
-							assert(false && "oopsie in luco type deduction: check the boolean_types enum");
-							return false;
+						written += ch;
 					}
-					return false;
 				}
-				else
+				written += quote;
+
+				expected<luco::node, error> parsed = parser::try_parse(key ? written + " = 0\n" : "k = " + written + "\n");
+				if (not parsed || parsed.value().as_object()->size() != 1)
+				{
+					return unrepresentable();
+				}
+
+				const auto& [read_key, read_value] = *parsed.value().as_object()->begin();
+				if (key && read_key != string)
+				{
+					return unrepresentable();
+				}
+				else if (not key)
 				{
-					return raw_value;
+					// like node::dump_to_luco(), a string such as "5" or "true" is read back as the number or boolean
+					bool same = std::visit(
+					    [&read_value](const auto& value)
+					    {
+						    luco::value expected_value(value);
+						    return read_value.is_value() && read_value.as_value()->type() == expected_value.type() &&
+							   read_value.as_value()->stringify() == expected_value.stringify();
+					    },
+					    typed.value());
+					if (not same)
+					{
+						return unrepresentable();
+					}
 				}
+
+				out += written;
+				return monostate();
 			}
 
 			inline static number_types is_number(const std::string& data)
@@ -613,6 +971,42 @@ namespace luco
 				return false;
 			}
 
+			/**
+			 * @brief checks if an unquoted value is an include directive such as: key = @include "path/to/file.luco"
+			 * @return the path to be included or std::nullopt
+			 */
+			inline static std::optional<std::string> include_directive(const std::string&	   raw_value,
+										   const luco_value_type& key_value_type)
+			{
+				const std::string directive = "@include";
+				if ((key_value_type != luco_value_type::end_string_unqouted &&
+				     key_value_type != luco_value_type::unqouted_string) ||
+				    not raw_value.starts_with(directive))
+				{
+					return std::nullopt;
+				}
+
+				std::string path = raw_value.substr(directive.size());
+				if (not path.empty() && not token::is_empty(path.front()))
+				{
+					return std::nullopt;
+				}
+
+				size_t begin = path.find_first_not_of(" \t");
+				if (begin == std::string::npos)
+				{
+					return "";
+				}
+				path = path.substr(begin);
+
+				if (path.size() >= 2 && (path.front() == '"' || path.front() == '\'') && path.back() == path.front())
+				{
+					path = path.substr(1, path.size() - 2);
+				}
+
+				return path;
+			}
+
 			inline static bool is_quoted_string(const luco_value_type& key_value_type)
 			{
 				if (key_value_type == luco_value_type::qouted_string_2)
@@ -677,6 +1071,27 @@ namespace luco
 				}
 			}
 
+			/**
+			 * @brief appends the characters after data.i up to the next special one to the string in one go and moves
+			 * data.i to the last of them. they don't change the parsing state, so going through the tokens one at a
+			 * time would only append them too
+			 * @param string the key or value being read, its last character is the one at data.i
+			 */
+			inline static void append_span(struct parsing_data& data, std::pair<std::string, luco_value_type>& string)
+			{
+				if ((string.second != luco_value_type::unqouted_string && not is_quoted_string(string.second)) ||
+				    data.escaped_special_char != std::make_tuple(size_t(0), false, '\0'))
+				{
+					return;
+				}
+
+				const char* line = data.line.data();
+				const char* span = line + data.i + 1;
+				const char* end	 = simd::find_luco_special(span, line + data.line.size());
+				string.first.append(span, end);
+				data.i = static_cast<size_t>(end - line) - 1;
+			}
+
 			inline static bool expected_multi_line_string(luco_value_type& key_value_type)
 			{
 				if (key_value_type == luco_value_type::escaped_string_newline_qouted_1 ||
@@ -701,9 +1116,40 @@ namespace luco
 				return false;
 			}
 
+			/**
+			 * @brief reads two quotes followed by the end of the key or value as an empty quoted string. anywhere
+			 * else two quotes are an escaped one
+			 * @return true if it did, data.i is then at the closing quote
+			 */
+			inline static bool empty_quotes(struct parsing_data& data, luco_value_type& key_value_type)
+			{
+				const std::string& line = data.line;
+				const size_t	   i	= data.i;
+				if (key_value_type != luco_value_type::none || (line[i] != '"' && line[i] != '\'') || i + 1 >= line.size() ||
+				    line[i + 1] != line[i])
+				{
+					return false;
+				}
+
+				size_t next = line.find_first_not_of(" \t\r", i + 2);
+				if (next == std::string::npos || std::string_view("\n#}={").find(line[next]) == std::string_view::npos)
+				{
+					return false;
+				}
+
+				data.escaped_special_char = std::make_tuple(0, false, '\0');
+				key_value_type		  = line[i] == '"' ? luco_value_type::end_string_2 : luco_value_type::end_string_1;
+				data.i++;
+				return true;
+			}
+
 			inline static bool handle_empty_in_string(struct parsing_data& data, luco_value_type& key_value_type, char ch)
 			{
-				if (token::is_empty_newline(ch) &&
+				if (empty_quotes(data, key_value_type))
+				{
+					return true;
+				}
+				else if (token::is_empty_newline(ch) &&
 				    (key_value_type == luco_value_type::none || expected_multi_line_string(key_value_type)))
 				{
 					return false;
@@ -818,6 +1264,19 @@ namespace luco
 		private:
 			unsigned long brackets_count = 0;
 
+			/**
+			 * @brief moves data.i to right before the next character that can change the state of the comment, '#',
+			 * '{' and the end of it ('\n' or '}'). the characters in between don't touch the parsing state, so they're
+			 * skipped in one go instead of going through the tokens one at a time
+			 */
+			inline void skip_to_next_special(struct parsing_data& data)
+			{
+				const char  end_of_comment = this->is_registered_token(data, luco_syntax::comment) ? '\n' : '}';
+				const char* line	   = data.line.data();
+				const char* next = simd::find_any_of(line + data.i + 1, line + data.line.size(), '#', '{', end_of_comment);
+				data.i		 = static_cast<size_t>(next - line) - 1;
+			}
+
 			inline bool   is_end_of_token(struct parsing_data& data) override
 			{
 				if (not data.hierarchy.empty() && data.hierarchy.top().first == luco_syntax::comment &&
@@ -867,6 +1326,7 @@ namespace luco
 						this->unregister_token(data);
 						this->register_token(data, luco_syntax::nested_comment);
 					}
+					this->skip_to_next_special(data);
 					return true;
 				}
 				else if (this->is_registered_token(data, luco_syntax::nested_comment))
@@ -882,6 +1342,7 @@ namespace luco
 							this->brackets_count--;
 						}
 					}
+					this->skip_to_next_special(data);
 					return true;
 				}
 				else
@@ -892,7 +1353,12 @@ namespace luco
 
 			inline bool is_token(struct parsing_data& data) override
 			{
-				if (this->delimiter(data, '#'))
+				if (data.line[data.i] == '#' && inside_quotes(data))
+				{
+					// part of a quoted key or value
+					return false;
+				}
+				else if (this->delimiter(data, '#'))
 				{
 					return true;
 				}
@@ -901,6 +1367,22 @@ namespace luco
 					return false;
 				}
 			}
+
+			inline static bool inside_quotes(struct parsing_data& data)
+			{
+				if (data.hierarchy.top().first == luco_syntax::key)
+				{
+					return luco_simple_types::is_quoted_string(data.keys.top().second);
+				}
+				else if (data.hierarchy.top().first == luco_syntax::value ||
+					 data.hierarchy.top().first == luco_syntax::transient_bracket)
+				{
+					// the first item after a '{' is read as a value until it turns out to be a key
+					return luco_simple_types::is_quoted_string(data.raw_value.second);
+				}
+
+				return false;
+			}
 	};
 
 	class opening_bracket : public token {
@@ -940,7 +1422,7 @@ namespace luco
 					this->unregister_token(data);
 					this->register_token(data, luco_syntax::transient_bracket);
 				}
-				else if (this->is_end_of_token(data))
+				else if (this->is_end_of_token(data) && not luco_simple_types::expected_multi_line_string(data.raw_value.second))
 				{
 					this->unregister_token(data);
 					luco_simple_types::strip_if_unqouted_string(data.keys.top().first, data.keys.top().second);
@@ -968,7 +1450,12 @@ namespace luco
 						{
 							return unexpected(ok.error());
 						}
-						data.luco_objs.push(&ok.value().get());
+						else if (auto entered = enter_schema(data, data.keys.top().first, node_type::array); not entered)
+						{
+							return unexpected(entered.error());
+						}
+						push_container(data, &ok.value().get());
+						mark_opening_bracket(data);
 						this->register_token(data, luco_syntax::transient_bracket);
 						return true;
 					}
@@ -992,6 +1479,10 @@ namespace luco
 						{
 							ok = data.luco_objs.top()->push_back(luco::node(node_type::object));
 						}
+						if (auto entered = enter_schema(data, data.keys.top().first, node_type::object); not entered)
+						{
+							return unexpected(entered.error());
+						}
 						data.keys.push(std::move(data.raw_value));
 						data.raw_value.first.clear();
 						data.raw_value.second = luco_value_type::none;
@@ -1007,19 +1498,30 @@ namespace luco
 						{
 							ok = data.luco_objs.top()->push_back(luco::node(node_type::array));
 						}
+						if (auto entered = enter_schema(data, data.keys.top().first, node_type::array); not entered)
+						{
+							return unexpected(entered.error());
+						}
 					}
 
 					if (not ok)
 					{
 						return unexpected(ok.error());
 					}
-					data.luco_objs.push(&ok.value().get());
+					push_container(data, &ok.value().get());
+					if (this->delimiter(data, '{'))
+					{
+						mark_opening_bracket(data);
+					}
 					return true;
 				}
 
 				if (this->is_registered_token(data, luco_syntax::transient_bracket))
 				{
-					assert(not data.keys.empty());
+					if (data.keys.empty())
+					{
+						return unexpected(error(error_type::parsing_error, "{} found '{{' without a key", error_location(data)));
+					}
 
 					if (data.raw_value.second == luco_value_type::none && this->is_newline(data.line[data.i]))
 					{
@@ -1107,8 +1609,15 @@ namespace luco
 					 not luco_simple_types::expected_multi_line_string(data.keys.top().second))
 				{
 					this->unregister_token(data);
-					this->prepare_for_next_token(data, this->delimiter(data, '=') ? luco_syntax::equal_sign
-												      : luco_syntax::opening_bracket);
+					if (this->delimiter(data, '='))
+					{
+						this->prepare_for_next_token(data, luco_syntax::equal_sign);
+					}
+					else
+					{
+						mark_opening_bracket(data);
+						this->prepare_for_next_token(data, luco_syntax::opening_bracket);
+					}
 					return true;
 				}
 
@@ -1120,6 +1629,7 @@ namespace luco
 						if (not luco_simple_types::end_of_string(data.keys.top().second))
 						{
 							data.keys.top().first += data.line[data.i];
+							luco_simple_types::append_span(data, data.keys.top());
 						}
 						return true;
 					}
@@ -1181,8 +1691,51 @@ namespace luco
 			{
 				luco_simple_types::strip_if_unqouted_string(data.raw_value.first, data.raw_value.second);
 
-				std::variant<std::string, bool, double, int64_t, null_type> typed_value =
-				    luco_simple_types::get_type(data.raw_value.first);
+				std::optional<std::string> include_path =
+				    data.includes == nullptr ? std::nullopt
+							     : luco_simple_types::include_directive(data.raw_value.first, data.raw_value.second);
+
+				// only an include needs a placeholder object, a value replaces it otherwise
+				luco::node	     typed_value = include_path ? luco::node(node_type::object) : luco::node(luco_node());
+				const schema::entry* declared	 = include_path ? nullptr : this->declared_entry(data);
+				if (declared != nullptr && declared->type)
+				{
+					auto converted = schema::convert(data.raw_value.first, declared->type.value());
+					if (not converted)
+					{
+						return unexpected(error(error_type::parsing_error_wrong_type, "{} {}", error_location(data),
+									converted.error().message()));
+					}
+					typed_value = luco::node(converted.value());
+				}
+				else if (not include_path)
+				{
+					auto typed = luco_simple_types::get_type(data.raw_value.first);
+					if (not typed)
+					{
+						return unexpected(
+						    error(error_type::parsing_error, "{} {}", error_location(data), typed.error().message()));
+					}
+					typed_value = luco::node(typed.value());
+				}
+
+				if (auto checked = check_schema(data, declared, typed_value); not checked)
+				{
+					return unexpected(checked.error());
+				}
+
+				if (include_path)
+				{
+					auto file = data.includes->request(data.source_path, include_path.value());
+					if (not file)
+					{
+						return unexpected(error(error_type::parsing_error, "{} {}", error_location(data),
+									file.error().message()));
+					}
+
+					// the placeholder is swapped with the included node once the whole file is parsed
+					data.pending_includes.emplace_back(typed_value, file.value());
+				}
 
 				if (data.luco_objs.top()->type() == node_type::object)
 				{
@@ -1214,6 +1767,24 @@ namespace luco
 				return true;
 			}
 
+			/**
+			 * @return the entry the schema declares for the value being inserted, or nullptr
+			 */
+			inline const schema::entry* declared_entry(struct parsing_data& data)
+			{
+				if (data.schema_at.empty() || data.schema_at.back() == nullptr)
+				{
+					return nullptr;
+				}
+				else if (data.luco_objs.top()->is_object())
+				{
+					luco_simple_types::strip_if_unqouted_string(data.keys.top().first, data.keys.top().second);
+					return data.schema->find(*data.schema_at.back(), data.keys.top().first);
+				}
+
+				return data.schema->find(*data.schema_at.back(), schema::element);
+			}
+
 		public:
 			inline luco_value()
 			{
@@ -1263,6 +1834,7 @@ namespace luco
 						if (not luco_simple_types::end_of_string(data.raw_value.second))
 						{
 							data.raw_value.first += data.line[data.i];
+							luco_simple_types::append_span(data, data.raw_value);
 						}
 						return true;
 					}
@@ -1278,6 +1850,7 @@ namespace luco
 							}
 						}
 
+						mark_opening_bracket(data);
 						this->register_token(data, luco_syntax::transient_bracket);
 						return true;
 					}
@@ -1343,7 +1916,12 @@ namespace luco
 				if (this->is_registered_token(data, luco_syntax::closing_bracket))
 				{
 					this->unregister_token(data);
-					assert(not data.keys.empty());
+					if (data.keys.empty())
+					{
+						return unexpected(error(error_type::parsing_error,
+									"{} encountered more '}}' than there is '{{'",
+									error_location(data)));
+					}
 					data.keys.top().first.clear();
 					data.keys.top().second = luco_value_type::none;
 
@@ -1352,6 +1930,10 @@ namespace luco
 					{
 						return unexpected(error(error_type::parsing_error, "encountered '}' without a '{'"));
 					}
+					else if (auto left = leave_schema(data, *data.luco_objs.top()); not left)
+					{
+						return unexpected(left.error());
+					}
 					this->prepare_for_next_token(data, luco_syntax::none);
 
 					if (data.hierarchy.empty())
@@ -1365,14 +1947,30 @@ namespace luco
 				}
 				else if (this->is_registered_token(data, luco_syntax::transient_bracket) && this->delimiter(data, '}'))
 				{
-					assert(data.raw_value.first.empty() && data.raw_value.second == luco_value_type::none);
+					if (data.raw_value.second != luco_value_type::none)
+					{
+						return unexpected(error(error_type::parsing_error, "{} expected a newline before '}}'", error_location(data)));
+					}
 
 					this->unregister_token(data);
+					luco_simple_types::strip_if_unqouted_string(data.keys.top().first, data.keys.top().second);
 					auto ok = data.luco_objs.top()->insert(data.keys.top().first, luco::node(node_type::object));
 					if (not ok)
 					{
 						return unexpected(ok.error());
 					}
+					else if (auto entered = enter_schema(data, data.keys.top().first, node_type::object); not entered)
+					{
+						return unexpected(entered.error());
+					}
+					else if (auto left = leave_schema(data, ok.value().get()); not left)
+					{
+						return unexpected(left.error());
+					}
+					if (data.spans != nullptr)
+					{
+						record_span(data, opened_span(data, ok.value().get()));
+					}
 					return true;
 				}
 				else
@@ -1395,14 +1993,15 @@ namespace luco
 				}
 
 				assert(not data.luco_objs.empty());
-				data.luco_objs.pop();
+				pop_container(data);
 			}
 
 			inline bool is_token(struct parsing_data& data) override
 			{
 				assert(not data.hierarchy.empty());
 
-				if (this->handle_is(data, this->is) && delimiter(data, '}'))
+				// the root object isn't closed by a '}', it's reported as one without an object or array
+				if (this->handle_is(data, this->is) && data.luco_objs.size() > 1 && delimiter(data, '}'))
 				{
 					return true;
 				}
@@ -1421,6 +2020,25 @@ namespace luco
 			class comment	      comment;
 	};
 
+	/**
+	 * @struct incremental_parsing
+	 * @brief parses a luco text that arrives in chunks of any size. every line is parsed as soon as it's complete, so
+	 * nothing but the current line is kept besides the tree being built
+	 */
+	struct incremental_parsing {
+			luco::node	    luco_data = luco::node(node_type::object);
+			struct parsing_data data;
+			struct syntax	    syntax;
+
+			inline incremental_parsing(const std::filesystem::path& source_path, struct include_context& includes,
+						   const luco::schema* schema = nullptr);
+			incremental_parsing(const incremental_parsing&) = delete;
+
+			inline expected<monostate, error>  parse_line() noexcept;
+			inline expected<monostate, error>  feed(std::string_view chunk) noexcept;
+			inline expected<luco::node, error> finish() noexcept;
+	};
+
 	inline luco::expected<bool, luco::error> syntax_error(struct parsing_data& data, const struct syntax&)
 	{
 		if (token::is_empty_newline(data.line[data.i]))
@@ -1484,6 +2102,31 @@ namespace luco
 		}
 	}
 
+	/**
+	 * @brief checks that nothing is left open once the whole text is read
+	 */
+	inline expected<monostate, error> end_of_text(struct parsing_data& data)
+	{
+		if (data.hierarchy.top().first == luco_syntax::nested_comment)
+		{
+			return unexpected(error(luco::error_type::parsing_error, "{} non-ending nested comment was encountered at",
+						error_location(data, data.hierarchy.top().second)));
+		}
+		else if (luco_simple_types::expected_multi_line_string(data.raw_value.second) ||
+			 (not data.keys.empty() && luco_simple_types::expected_multi_line_string(data.keys.top().second)))
+		{
+			return unexpected(error(luco::error_type::parsing_error, "{} a '\\' line continuation reaches the end of the text",
+						error_location(data, std::make_pair(data.line_number, size_t(0)))));
+		}
+		else if (data.luco_objs.size() > 1)
+		{
+			return unexpected(error(luco::error_type::parsing_error, "{} '{{' isn't closed before the end of the text",
+						error_location(data, std::make_pair(data.line_number, size_t(0)))));
+		}
+
+		return monostate();
+	}
+
 	inline bool parser::done_or_not_ok(const expected<bool, error>& ok)
 	{
 		if ((ok && ok.value()) || not ok)
@@ -1544,7 +2187,7 @@ namespace luco
 		expected<luco::node, error> ok = luco::parser::try_parse(path);
 		if (not ok)
 		{
-			throw ok.error();
+			raise_error(ok.error());
 		}
 
 		return ok.value();
@@ -1555,7 +2198,7 @@ namespace luco
 		expected<luco::node, error> ok = luco::parser::try_parse(raw_json);
 		if (not ok)
 		{
-			throw ok.error();
+			raise_error(ok.error());
 		}
 
 		return ok.value();
@@ -1566,7 +2209,7 @@ namespace luco
 		expected<luco::node, error> ok = luco::parser::try_parse(raw_json);
 		if (not ok)
 		{
-			throw ok.error();
+			raise_error(ok.error());
 		}
 
 		return ok.value();
@@ -1574,102 +2217,244 @@ namespace luco
 
 	inline expected<luco::node, error> parser::try_parse(const std::filesystem::path& path) noexcept
 	{
-		luco::node		       luco_data = luco::node(node_type::object);
+		return luco::parser::try_parse(path, parse_options());
+	}
 
-		std::unique_ptr<std::ifstream> file	 = std::make_unique<std::ifstream>(path);
-		if (not file->is_open())
+	inline expected<luco::node, error> parser::parse_file(const std::filesystem::path& path, struct include_context& includes,
+							      const luco::schema* schema) noexcept
+	{
+		std::ifstream file(path);
+		if (not file.is_open())
 		{
 			return unexpected(luco::error(error_type::filesystem_error,
 						      std::format("couldn't open '{}', {}", path.string(), std::strerror(errno))));
 		}
-		struct parsing_data data;
-		struct syntax	    syntax;
-
-		data.hierarchy.push(std::make_pair(luco_syntax::object, std::make_pair(1, 0)));
-		data.luco_objs.push(&luco_data);
-		data.keys.push({"", luco_value_type::none});
-
-		expected<monostate, error> ok;
 
-		while (std::getline(*file, data.line))
+		auto read_block = [&file, &path](char* buffer, size_t size) -> expected<size_t, error>
 		{
-			data.line += "\n";
-			for (data.i = 0; data.i < data.line.size(); data.i++)
+			file.read(buffer, static_cast<std::streamsize>(size));
+			if (file.bad())
 			{
-				ok = luco::parser::parsing(data, syntax);
-				if (not ok)
-				{
-					return unexpected(ok.error());
-				}
-				else if (data.shift_index_backward_for_oldnewline)
-				{
-					data.shift_index_backward_for_oldnewline = false;
-					data.i--;
-				}
+				return unexpected(luco::error(error_type::filesystem_error,
+							      std::format("couldn't read '{}', {}", path.string(), std::strerror(errno))));
 			}
+			return static_cast<size_t>(file.gcount());
+		};
 
-			if (not file->eof())
-			{
-				data.line.clear();
-			}
+		return luco::parser::parse_blocks(read_block, default_block_size, path, includes, schema);
+	}
 
-			data.line_number++;
+	inline expected<luco::node, error> parser::parse_blocks(const std::function<expected<size_t, error>(char*, size_t)>& read_block,
+								size_t block_size, const std::filesystem::path& source_path,
+								struct include_context& includes, const luco::schema* schema) noexcept
+	{
+		struct incremental_parsing parsing(source_path, includes, schema);
+		std::string		   block(std::max<size_t>(block_size, 1), '\0');
+		while (true)
+		{
+			expected<size_t, error> size = read_block(block.data(), block.size());
+			if (not size)
+			{
+				return unexpected(size.error());
+			}
+			else if (size.value() == 0)
+			{
+				break;
+			}
+
+			auto ok = parsing.feed(std::string_view(block.data(), size.value()));
+			if (not ok)
+			{
+				return unexpected(ok.error());
+			}
 		}
 
-		if (data.hierarchy.top().first == luco_syntax::nested_comment)
+		return parsing.finish();
+	}
+
+	inline incremental_parsing::incremental_parsing(const std::filesystem::path& source_path, struct include_context& includes,
+							const luco::schema* schema)
+	{
+		std::error_code ec;
+
+		data.hierarchy.push(std::make_pair(luco_syntax::object, std::make_pair(1, 0)));
+		data.luco_objs.push(&luco_data);
+		data.keys.push({"", luco_value_type::none});
+		data.includes	   = includes.enabled ? &includes : nullptr;
+		data.source_path   = source_path.empty() ? source_path : std::filesystem::weakly_canonical(source_path, ec);
+		data.validate_utf8 = includes.validate_utf8;
+		if (schema != nullptr)
 		{
-			return unexpected(error(luco::error_type::parsing_error, "{} non-ending nested comment was encountered at",
-						error_location(data, data.hierarchy.top().second)));
+			data.schema = schema;
+			data.schema_at.push_back(&schema->root());
+		}
+	}
+
+	inline expected<monostate, error> incremental_parsing::parse_line() noexcept
+	{
+		if (data.validate_utf8)
+		{
+			auto ok = validate_line_utf8(data);
+			if (not ok)
+			{
+				return ok;
+			}
 		}
 
-		return luco_data;
+		for (data.i = 0; data.i < data.line.size(); data.i++)
+		{
+			auto ok = luco::parser::parsing(data, syntax);
+			if (not ok)
+			{
+				return unexpected(ok.error());
+			}
+			else if (data.shift_index_backward_for_oldnewline)
+			{
+				data.shift_index_backward_for_oldnewline = false;
+				data.i--;
+			}
+		}
+
+		data.line_offset += data.line.size();
+		data.line_number++;
+
+		return monostate();
 	}
 
-	inline expected<luco::node, error> parser::try_parse(const std::string& raw_json) noexcept
+	inline expected<monostate, error> incremental_parsing::feed(std::string_view chunk) noexcept
 	{
-		luco::node	    luco_data = luco::node(node_type::object);
+		size_t begin = 0;
+		for (size_t newline = chunk.find('\n'); newline != std::string_view::npos; newline = chunk.find('\n', begin))
+		{
+			data.line.append(chunk.substr(begin, newline + 1 - begin));
+			auto ok = this->parse_line();
+			if (not ok)
+			{
+				return ok;
+			}
 
+			data.line.clear();
+			begin = newline + 1;
+		}
+		data.line.append(chunk.substr(begin));
+
+		return monostate();
+	}
+
+	inline expected<luco::node, error> incremental_parsing::finish() noexcept
+	{
+		if (not data.line.empty())
+		{
+			data.line += '\n';
+			auto ok = this->parse_line();
+			if (not ok)
+			{
+				return unexpected(ok.error());
+			}
+		}
+
+		if (auto ended = end_of_text(data); not ended)
+		{
+			return unexpected(ended.error());
+		}
+		else if (auto checked = check_schema(data, data.schema_at.empty() ? nullptr : data.schema_at.front(), luco_data); not checked)
+		{
+			return unexpected(checked.error());
+		}
+
+		return luco::parser::resolve_includes(data, luco_data);
+	}
+
+	inline expected<luco::node, error> parser::try_parse(const std::string& raw_json) noexcept
+	{
 		struct parsing_data data;
-		struct syntax	    syntax;
+		return luco::parser::parse_string(raw_json, data);
+	}
 
-		data.hierarchy.push(std::make_pair(luco_syntax::object, std::make_pair(1, 0)));
+	inline expected<luco::node, error> parser::parse_string(const std::string& raw_json, struct parsing_data& data,
+								const parse_options& options) noexcept
+	{
+		luco::node	       luco_data = luco::node(node_type::object);
+
+		struct syntax	       syntax;
+		struct include_context includes(options, data.source_path);
+
+		data.hierarchy.push(std::make_pair(luco_syntax::object, std::make_pair(data.line_number, 0)));
 		data.luco_objs.push(&luco_data);
 		data.keys.push({"", luco_value_type::none});
+		data.includes	       = includes.enabled ? &includes : nullptr;
+		includes.validate_utf8 = data.validate_utf8;
 
 		expected<monostate, error> ok;
 
+		auto parse_line = [&](size_t end) -> expected<monostate, error>
+		{
+			data.line_offset = end - data.line.size();
+
+			if (data.validate_utf8)
+			{
+				ok = validate_line_utf8(data);
+				if (not ok)
+				{
+					return ok;
+				}
+			}
+
+			for (data.i = 0; data.i < data.line.size(); data.i++)
+			{
+				ok = luco::parser::parsing(data, syntax);
+				if (not ok)
+				{
+					return ok;
+				}
+				else if (data.shift_index_backward_for_oldnewline)
+				{
+					data.shift_index_backward_for_oldnewline = false;
+					data.i--;
+				}
+			}
+			if (data.line.back() == '\n')
+			{
+				data.line_number++;
+			}
+			data.line.clear();
+
+			return monostate();
+		};
+
+		// lines end at newlines like in a file, a doubled '}}' isn't cut in two
 		for (size_t i = 0; i < raw_json.size(); i++)
 		{
 			data.line += raw_json[i];
-			if (not data.line.empty() && (data.line.back() == '\n' || data.line.back() == ',' || data.line.back() == '}'))
+			if (data.line.back() == '\n')
 			{
-
-				for (data.i = 0; data.i < data.line.size(); data.i++)
+				if (ok = parse_line(i + 1); not ok)
 				{
-					ok = luco::parser::parsing(data, syntax);
-					if (not ok)
-					{
-						return unexpected(ok.error());
-					}
-					else if (data.shift_index_backward_for_oldnewline)
-					{
-						data.shift_index_backward_for_oldnewline = false;
-						data.i--;
-					}
+					return unexpected(ok.error());
 				}
-				data.line.clear();
+			}
+		}
 
-				data.line_number++;
+		// like in a file, the last line is read as if it ended with a newline
+		if (not data.line.empty())
+		{
+			data.line += '\n';
+			if (ok = parse_line(raw_json.size() + 1); not ok)
+			{
+				return unexpected(ok.error());
 			}
 		}
 
-		if (data.hierarchy.top().first == luco_syntax::nested_comment)
+		if (auto ended = end_of_text(data); not ended)
 		{
-			return unexpected(error(luco::error_type::parsing_error, "{} non-ending nested comment was encountered at",
-						error_location(data, data.hierarchy.top().second)));
+			return unexpected(ended.error());
+		}
+		else if (auto checked = check_schema(data, data.schema_at.empty() ? nullptr : data.schema_at.front(), luco_data); not checked)
+		{
+			return unexpected(checked.error());
 		}
 
-		return luco_data;
+		return luco::parser::resolve_includes(data, luco_data);
 	}
 
 	inline expected<luco::node, error> parser::try_parse(const char* raw_json) noexcept
@@ -1678,4 +2463,380 @@ namespace luco
 		std::string string_json(raw_json);
 		return luco::parser::try_parse(string_json);
 	}
+
+	inline expected<luco::node, error> parser::try_parse(const std::filesystem::path& path, const parse_options& options) noexcept
+	{
+		struct include_context includes(options, path);
+		return luco::parser::parse_file(path, includes, options.schema);
+	}
+
+	inline expected<luco::node, error> parser::try_parse(const std::string& raw_json, const parse_options& options) noexcept
+	{
+		struct parsing_data data;
+		data.validate_utf8 = options.validate_utf8;
+		if (options.schema != nullptr)
+		{
+			data.schema = options.schema;
+			data.schema_at.push_back(&options.schema->root());
+		}
+		return luco::parser::parse_string(raw_json, data, options);
+	}
+
+	inline expected<luco::node, error> parser::try_parse(const char* raw_json, const parse_options& options) noexcept
+	{
+		assert(raw_json != NULL);
+		std::string string_json(raw_json);
+		return luco::parser::try_parse(string_json, options);
+	}
+
+	inline luco::node parser::parse(const std::filesystem::path& path, const parse_options& options)
+	{
+		expected<luco::node, error> ok = luco::parser::try_parse(path, options);
+		if (not ok)
+		{
+			raise_error(ok.error());
+		}
+
+		return ok.value();
+	}
+
+	inline luco::node parser::parse(const std::string& raw_json, const parse_options& options)
+	{
+		expected<luco::node, error> ok = luco::parser::try_parse(raw_json, options);
+		if (not ok)
+		{
+			raise_error(ok.error());
+		}
+
+		return ok.value();
+	}
+
+	inline luco::node parser::parse(const char* raw_json, const parse_options& options)
+	{
+		expected<luco::node, error> ok = luco::parser::try_parse(raw_json, options);
+		if (not ok)
+		{
+			raise_error(ok.error());
+		}
+
+		return ok.value();
+	}
+
+	inline expected<luco::node, error> parser::resolve_includes(struct parsing_data& data, luco::node& luco_data)
+	{
+		if (data.pending_includes.empty())
+		{
+			return luco_data;
+		}
+
+		std::unordered_map<const void*, luco::node> resolved;
+		for (auto& [placeholder, file] : data.pending_includes)
+		{
+			const expected<luco::node, error>& included = file.get();
+			if (not included)
+			{
+				return unexpected(included.error());
+			}
+
+			resolved.emplace(placeholder.as_object().get(), included.value());
+		}
+		data.pending_includes.clear();
+
+		luco::parser::splice_includes(luco_data, resolved);
+
+		return luco_data;
+	}
+
+	inline void parser::splice_includes(luco::node& node, const std::unordered_map<const void*, luco::node>& resolved)
+	{
+		auto splice = [&resolved](luco::node& child)
+		{
+			if (child.is_object())
+			{
+				if (auto itr = resolved.find(child.as_object().get()); itr != resolved.end())
+				{
+					// the parsed file is shared by every place that includes it, so each one gets a copy it
+					// can modify on its own
+					child = luco::parser::copy_tree(itr->second);
+					return;
+				}
+			}
+
+			luco::parser::splice_includes(child, resolved);
+		};
+
+		if (node.is_object())
+		{
+			for (auto& [key, child] : *node.as_object())
+			{
+				splice(child);
+			}
+		}
+		else if (node.is_array())
+		{
+			for (auto& child : *node.as_array())
+			{
+				splice(child);
+			}
+		}
+	}
+
+	inline luco::node parser::copy_tree(const luco::node& node)
+	{
+		if (node.is_object())
+		{
+			luco::node copy(node_type::object);
+			for (const auto& [key, child] : *node.as_object())
+			{
+				copy.as_object()->insert(key, luco::parser::copy_tree(child));
+			}
+			return copy;
+		}
+		else if (node.is_array())
+		{
+			luco::node copy(node_type::array);
+			for (const auto& child : *node.as_array())
+			{
+				copy.as_array()->push_back(luco::parser::copy_tree(child));
+			}
+			return copy;
+		}
+
+		return luco::node(luco_node(std::make_shared<class value>(*node.as_value())));
+	}
+
+	inline include_context::include_context(const parse_options& options, const std::filesystem::path& source_path)
+	    : enabled(options.allow_includes), validate_utf8(options.validate_utf8)
+	{
+		if (not enabled)
+		{
+			return;
+		}
+
+		std::error_code ec;
+		root = options.include_root;
+		if (root.empty())
+		{
+			root = source_path.has_parent_path() ? source_path.parent_path() : std::filesystem::current_path(ec);
+		}
+		root	    = std::filesystem::weakly_canonical(std::filesystem::absolute(root, ec), ec);
+		max_threads = options.include_threads != 0 ? options.include_threads : std::max(1u, std::thread::hardware_concurrency());
+	}
+
+	inline expected<include_context::included_file, error> include_context::request(const std::filesystem::path& origin,
+											 const std::string&	      include_path)
+	{
+		if (include_path.empty())
+		{
+			return unexpected(error(error_type::parsing_error, "expected a path after '@include'"));
+		}
+
+		std::error_code	      ec;
+		std::filesystem::path base   = origin.empty() ? std::filesystem::current_path(ec) : origin.parent_path();
+		std::filesystem::path target = std::filesystem::weakly_canonical(base / include_path, ec);
+		if (ec)
+		{
+			return unexpected(
+			    error(error_type::filesystem_error, "couldn't resolve the included file '{}', {}", include_path, ec.message()));
+		}
+
+		// the paths are canonical so '..' and symlinks can't lead outside of the root
+		std::filesystem::path inside = target.lexically_relative(root);
+		if (inside.empty() || *inside.begin() == "..")
+		{
+			return unexpected(error(error_type::filesystem_error, "the included file '{}' is outside of '{}'", include_path,
+						root.string()));
+		}
+
+		std::lock_guard<std::mutex> lock(mutex);
+
+		// a file may only wait for files that don't (transitively) wait for it. otherwise the two parses would block
+		// each other forever
+		if (std::vector<std::filesystem::path> chain = this->find_chain(target, origin); not chain.empty() || target == origin)
+		{
+			std::string cycle = origin.string();
+			for (const auto& file : chain)
+			{
+				cycle += " -> " + file.string();
+			}
+			cycle += " -> " + origin.string();
+			return unexpected(error(error_type::parsing_error, "include cycle detected: {}", cycle));
+		}
+
+		edges[origin].insert(target);
+
+		if (auto itr = files.find(target); itr != files.end())
+		{
+			return itr->second;
+		}
+
+		auto parse_included = [this, target](bool counted) -> expected<luco::node, error>
+		{
+			expected<luco::node, error> included = luco::parser::parse_file(target, *this);
+			if (counted)
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+				threads--;
+			}
+
+			if (not included)
+			{
+				return unexpected(error(included.error().value(), "in included file '{}': {}", target.string(),
+							included.error().message()));
+			}
+			return included;
+		};
+
+		// past max_threads a file is parsed by the first thread waiting for it. the waiting thread never waits for
+		// a file that waits for it since cycles are rejected above
+		included_file file;
+		if (threads >= max_threads)
+		{
+			file = std::async(std::launch::deferred, parse_included, false).share();
+		}
+		else
+		{
+#ifdef LUCO_NO_EXCEPTIONS
+			// without exceptions a failed thread can't be caught, so the standard library picks the policy
+			threads++;
+			file = std::async(std::launch::async | std::launch::deferred, parse_included, true).share();
+#else
+			try
+			{
+				threads++;
+				file = std::async(std::launch::async, parse_included, true).share();
+			}
+			catch (const std::system_error&)
+			{
+				// no threads left, the file is parsed by the first one waiting for it
+				threads--;
+				file = std::async(std::launch::deferred, parse_included, false).share();
+			}
+#endif
+		}
+
+		files.emplace(target, file);
+
+		return file;
+	}
+
+	inline std::vector<std::filesystem::path> include_context::find_chain(const std::filesystem::path& from,
+									      const std::filesystem::path& to) const
+	{
+		auto itr = edges.find(from);
+		if (itr == edges.end())
+		{
+			return {};
+		}
+
+		for (const auto& next : itr->second)
+		{
+			if (next == to)
+			{
+				return {from};
+			}
+			else if (std::vector<std::filesystem::path> chain = this->find_chain(next, to); not chain.empty())
+			{
+				chain.insert(chain.begin(), from);
+				return chain;
+			}
+		}
+
+		return {};
+	}
+
+	inline include_context::~include_context()
+	{
+		// a failed parse returns without waiting for the files it requested. the ones parsing on their own thread
+		// still use this context so wait for them, including the files they request while waiting. a deferred file
+		// that nobody started is dropped instead of parsed for nothing, it only ever runs on a thread that asks for
+		// it and those are waited for here
+		size_t waited = 0;
+		while (true)
+		{
+			std::vector<included_file> pending;
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+				if (files.size() == waited)
+				{
+					break;
+				}
+				waited = files.size();
+				for (const auto& [path, file] : files)
+				{
+					if (file.wait_for(std::chrono::seconds(0)) != std::future_status::deferred)
+					{
+						pending.push_back(file);
+					}
+				}
+			}
+
+			for (const auto& file : pending)
+			{
+				file.wait();
+			}
+		}
+	}
+
+	inline expected<schema, error> schema::try_parse(const std::filesystem::path& path) noexcept
+	{
+		expected<luco::node, error> definition = luco::parser::try_parse(path);
+		if (not definition)
+		{
+			return unexpected(definition.error());
+		}
+
+		return schema::try_compile(definition.value());
+	}
+
+	inline expected<schema, error> schema::try_parse(const std::string& raw_luco) noexcept
+	{
+		expected<luco::node, error> definition = luco::parser::try_parse(raw_luco);
+		if (not definition)
+		{
+			return unexpected(definition.error());
+		}
+
+		return schema::try_compile(definition.value());
+	}
+
+	inline expected<schema, error> schema::try_parse(const char* raw_luco) noexcept
+	{
+		assert(raw_luco != NULL);
+		std::string string_luco(raw_luco);
+		return schema::try_parse(string_luco);
+	}
+
+	inline schema schema::parse(const std::filesystem::path& path)
+	{
+		expected<schema, error> ok = schema::try_parse(path);
+		if (not ok)
+		{
+			raise_error(ok.error());
+		}
+
+		return ok.value();
+	}
+
+	inline schema schema::parse(const std::string& raw_luco)
+	{
+		expected<schema, error> ok = schema::try_parse(raw_luco);
+		if (not ok)
+		{
+			raise_error(ok.error());
+		}
+
+		return ok.value();
+	}
+
+	inline schema schema::parse(const char* raw_luco)
+	{
+		expected<schema, error> ok = schema::try_parse(raw_luco);
+		if (not ok)
+		{
+			raise_error(ok.error());
+		}
+
+		return ok.value();
+	}
 }
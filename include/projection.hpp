@@ -0,0 +1,466 @@
+/*
+ * Copyright: 2025 nodeluna
+ * SPDX-License-Identifier: Apache-2.0
+ * repository: https://github.com/nodeluna/luco
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <set>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include "api.hpp"
+#include "parser.hpp"
+#include "scanner.hpp"
+#include "stream.hpp"
+#include "expected.hpp"
+#include "error.hpp"
+
+/**
+ * @brief the namespace for luco
+ */
+namespace luco
+{
+	/**
+	 * @class projection
+	 * @brief selects which key paths of a luco text get parsed, everything else is skipped without being allocated
+	 * @detail @cpp
+	 * luco::projection by_paths = {{"server", "port"}, {"database"}};
+	 * luco::projection by_predicate([](const luco::projection::key_path& path) { return path.back() == "port"; });
+	 * luco::node node = luco::parser::parse(std::filesystem::path("config.luco"), by_paths);
+	 * @ecpp
+	 */
+	class projection {
+		public:
+			using key_path = std::vector<std::string>;
+
+			/**
+			 * @enum decision
+			 * @brief what to do with the subtree at a key path
+			 */
+			enum class decision {
+				skip,
+				descend,
+				select,
+			};
+
+		private:
+			std::vector<key_path>		     _paths;
+			std::function<bool(const key_path&)> _predicate;
+
+		public:
+			/**
+			 * @brief selects the subtrees at the given key paths, only objects are descended into
+			 * @param paths the key paths, each one is a list of keys starting from the root
+			 */
+			inline projection(std::initializer_list<key_path> paths);
+
+			/**
+			 * @brief selects the subtrees at the given key paths, only objects are descended into
+			 * @param paths the key paths, each one is a list of keys starting from the root
+			 */
+			inline explicit projection(const std::vector<key_path>& paths);
+
+			/**
+			 * @brief selects every subtree whose key path satisfies the predicate. objects that aren't selected are
+			 * still scanned for selected keys
+			 * @param predicate called with the key path of every key found inside of objects
+			 */
+			inline explicit projection(std::function<bool(const key_path&)> predicate);
+
+			/**
+			 * @brief decides what to do with the subtree at a key path
+			 * @param path the key path from the root
+			 * @return decision
+			 */
+			inline decision match(const key_path& path) const;
+	};
+
+	/**
+	 * @struct projected_parsing
+	 * @brief the state of parser::try_parse() with a projection. the text is scanned block by block and only the selected
+	 * items are parsed
+	 * @detail in the objects it descends into, the scanner is only trusted with items laid out one per line whose keys
+	 * and values have no character the parser treats specially, and a selected item has to parse to the key it was
+	 * found as. any other text is parsed whole and then filtered, so the result is the one of parser::parse(). blocks
+	 * that aren't selected are skipped without being read, and when the text doesn't parse only because of them the
+	 * scanned result is kept
+	 */
+	struct projected_parsing {
+			/**
+			 * @enum frame_kind
+			 * @brief what an object or array the scan descended into turned out to be
+			 */
+			enum class frame_kind {
+				unknown, // nothing in it was scanned yet
+				object,
+				array,
+			};
+
+			luco::chunked_source&				     source;
+			const luco::projection&				     projection;
+			const std::filesystem::path&			     source_path;
+			const std::function<expected<luco::node, error>()>& parse_whole;
+			luco::node					     result = luco::node(node_type::object);
+			std::set<projection::key_path>			     seen   = {};
+
+			inline luco::node&		   parent_of(const projection::key_path& path);
+			inline bool			   select(size_t begin, size_t end, const projection::key_path& path);
+			inline bool			   scan(bool& plain);
+			inline void			   filter(const luco::node& object, projection::key_path& path);
+			inline expected<luco::node, error> parse() noexcept;
+	};
+}
+
+namespace luco
+{
+	inline projection::projection(std::initializer_list<key_path> paths) : _paths(paths)
+	{
+	}
+
+	inline projection::projection(const std::vector<key_path>& paths) : _paths(paths)
+	{
+	}
+
+	inline projection::projection(std::function<bool(const key_path&)> predicate) : _predicate(std::move(predicate))
+	{
+	}
+
+	inline projection::decision projection::match(const key_path& path) const
+	{
+		if (_predicate)
+		{
+			return _predicate(path) ? decision::select : decision::descend;
+		}
+
+		decision result = decision::skip;
+		for (const key_path& selected : _paths)
+		{
+			if (selected.size() < path.size() || not std::equal(path.begin(), path.end(), selected.begin()))
+			{
+				continue;
+			}
+			else if (selected.size() == path.size())
+			{
+				return decision::select;
+			}
+			result = decision::descend;
+		}
+
+		return result;
+	}
+
+	inline luco::node& projected_parsing::parent_of(const projection::key_path& path)
+	{
+		luco::node* parent = &result;
+		for (size_t i = 0; i + 1 < path.size(); i++)
+		{
+			auto object = parent->as_object();
+			if (auto itr = object->find(path[i]); itr != object->end())
+			{
+				parent = &itr->second;
+			}
+			else
+			{
+				parent = &object->insert(path[i], luco::node(node_type::object));
+			}
+		}
+
+		return *parent;
+	}
+
+	inline bool projected_parsing::select(size_t begin, size_t end, const projection::key_path& path)
+	{
+		std::string text(source.text().substr(begin, end - begin));
+		text += '\n';
+
+		struct parsing_data data;
+		data.line_number = source.line_at(begin);
+		data.source_path = source_path;
+
+		// the item has to be read as the one key the scanner found, otherwise the whole text is parsed instead and
+		// reports the error the way parser::parse() does
+		expected<luco::node, error> selected = luco::parser::parse_string(text, data);
+		if (not selected || selected.value().as_object()->size() != 1 || selected.value().as_object()->begin()->first != path.back())
+		{
+			return false;
+		}
+
+		this->parent_of(path).as_object()->insert(path.back(), selected.value().as_object()->begin()->second);
+
+		return true;
+	}
+
+	inline bool projected_parsing::scan(bool& plain)
+	{
+		std::vector<frame_kind> frames = {frame_kind::object};
+		projection::key_path	path;
+		size_t			pos   = 0;
+		size_t			keep  = scanner::incomplete; // where the selected item being skipped begins
+		bool			first = true;
+
+		// drops what was scanned and reads the next block, the selected item stays in the window
+		auto read_more = [&](size_t& at)
+		{
+			size_t from    = keep == scanner::incomplete ? at : keep;
+			size_t dropped = from;
+			if (not source.read_more(from))
+			{
+				return false;
+			}
+			at -= dropped;
+			keep = keep == scanner::incomplete ? keep : keep - dropped;
+			return true;
+		};
+
+		// skips a block spanning any number of refills, the scan continues from where the previous window ended
+		auto skip_block = [&](size_t block)
+		{
+			size_t brackets	 = 0;
+			size_t resume_at = block;
+			size_t end	 = luco::scanner(source.text(), source.eof()).skip_block(block, brackets, resume_at);
+			while (end == scanner::incomplete && read_more(resume_at))
+			{
+				end = luco::scanner(source.text(), source.eof()).skip_block(resume_at, brackets, resume_at);
+			}
+			return end;
+		};
+
+		// the text after an item ends its line
+		auto ends_line = [](std::string_view text, size_t end)
+		{ return end == text.size() || text[end] == '\n' || text[end] == '#'; };
+
+		while (true)
+		{
+			luco::scanner	    scanner(source.text(), source.eof());
+			luco::scanner::item item = scanner.next_item(pos, false);
+			if (item.end == scanner::incomplete)
+			{
+				if (not read_more(pos))
+				{
+					return false;
+				}
+				continue;
+			}
+
+			// every item starts on a line of its own
+			std::string_view text = scanner.text();
+			plain = plain && (first || item.kind == scanner::item_kind::end ||
+					  text.substr(pos, item.begin - pos).find('\n') != std::string_view::npos);
+			first = false;
+
+			switch (item.kind)
+			{
+				case scanner::item_kind::end:
+					return frames.size() == 1;
+				case scanner::item_kind::close:
+					if (frames.size() == 1)
+					{
+						return false;
+					}
+					path.pop_back();
+					frames.pop_back();
+					pos = item.end;
+					break;
+				case scanner::item_kind::value:
+				case scanner::item_kind::block:
+					// key paths don't go through arrays, so an array is only scanned to find its end
+					plain	      = plain && frames.back() != frame_kind::object;
+					frames.back() = frame_kind::array;
+					if (item.kind == scanner::item_kind::block)
+					{
+						pos = skip_block(item.block);
+					}
+					else if (item.end > pos)
+					{
+						plain = plain && scanner::plain(text.substr(item.begin, item.end - item.begin)) && ends_line(text, item.end);
+						pos   = item.end;
+					}
+					else
+					{
+						return false;
+					}
+					break;
+				case scanner::item_kind::key_value:
+				case scanner::item_kind::key_block:
+				{
+					plain	      = plain && frames.back() != frame_kind::array &&
+						scanner::plain(text.substr(item.begin, item.key_end - item.begin));
+					frames.back() = frame_kind::object;
+					if (item.kind == scanner::item_kind::key_value)
+					{
+						std::string_view value = text.substr(item.key_end + 1, item.end - item.key_end - 1);
+						value.remove_prefix(std::min(value.find_first_not_of(" \t"), value.size()));
+						plain = plain && scanner::plain(value) && ends_line(text, item.end);
+					}
+
+					// a key found again replaces what was selected for it
+					path.push_back(scanner.key(item));
+					projection::decision decision = projection.match(path);
+					if (decision == projection::decision::select ||
+					    (decision == projection::decision::descend && item.kind == scanner::item_kind::key_block))
+					{
+						plain = seen.insert(path).second && plain;
+					}
+					else if (decision == projection::decision::descend)
+					{
+						plain = plain && not seen.contains(path);
+					}
+
+					if (item.kind == scanner::item_kind::key_block && decision == projection::decision::descend)
+					{
+						frames.push_back(frame_kind::unknown);
+						pos = item.block + 1;
+						break;
+					}
+
+					keep = decision == projection::decision::select ? item.begin : scanner::incomplete;
+					pos  = item.kind == scanner::item_kind::key_block ? skip_block(item.block) : item.end;
+					if (pos == scanner::incomplete ||
+					    (decision == projection::decision::select && not this->select(keep, pos, path)))
+					{
+						return false;
+					}
+					keep = scanner::incomplete;
+					path.pop_back();
+					break;
+				}
+			}
+
+			if (pos == scanner::incomplete)
+			{
+				return false;
+			}
+		}
+	}
+
+	inline void projected_parsing::filter(const luco::node& object, projection::key_path& path)
+	{
+		for (const auto& [key, node] : *object.as_object())
+		{
+			path.push_back(key);
+			projection::decision decision = projection.match(path);
+			if (decision == projection::decision::select)
+			{
+				this->parent_of(path).as_object()->insert(key, node);
+			}
+			else if (decision == projection::decision::descend && node.is_object())
+			{
+				this->filter(node, path);
+			}
+			path.pop_back();
+		}
+	}
+
+	inline expected<luco::node, error> projected_parsing::parse() noexcept
+	{
+		bool plain   = true;
+		bool scanned = this->scan(plain);
+		if (scanned && plain)
+		{
+			return result;
+		}
+
+		expected<luco::node, error> whole = parse_whole();
+		if (not whole && scanned)
+		{
+			// the errors are in what the projection skips, it isn't read like with a text that's all plain
+			return result;
+		}
+		else if (not whole)
+		{
+			return unexpected(whole.error());
+		}
+
+		projection::key_path path;
+		result = luco::node(node_type::object);
+		this->filter(whole.value(), path);
+
+		return result;
+	}
+
+	inline expected<luco::node, error> parser::parse_projected(chunked_source& source, const class projection& projection,
+								  const std::filesystem::path&			     source_path,
+								  const std::function<expected<luco::node, error>()>& parse_whole) noexcept
+	{
+		struct projected_parsing parsing{source, projection, source_path, parse_whole};
+
+		return parsing.parse();
+	}
+
+	inline expected<luco::node, error> parser::try_parse(const std::filesystem::path& path,
+							     const class projection& projection) noexcept
+	{
+		std::unique_ptr<std::ifstream> file = std::make_unique<std::ifstream>(path, std::ios::binary);
+		if (not file->is_open())
+		{
+			return unexpected(luco::error(error_type::filesystem_error,
+						      std::format("couldn't open '{}', {}", path.string(), std::strerror(errno))));
+		}
+
+		std::error_code					   ec;
+		chunked_source					   source(std::move(file));
+		std::function<expected<luco::node, error>()> parse_whole = [&path]() { return luco::parser::try_parse(path); };
+
+		return luco::parser::parse_projected(source, projection, std::filesystem::weakly_canonical(path, ec), parse_whole);
+	}
+
+	inline expected<luco::node, error> parser::try_parse(const std::string& raw_json, const class projection& projection) noexcept
+	{
+		chunked_source					   source{std::string_view(raw_json)};
+		std::function<expected<luco::node, error>()> parse_whole = [&raw_json]() { return luco::parser::try_parse(raw_json); };
+
+		return luco::parser::parse_projected(source, projection, std::filesystem::path(), parse_whole);
+	}
+
+	inline expected<luco::node, error> parser::try_parse(const char* raw_json, const class projection& projection) noexcept
+	{
+		assert(raw_json != NULL);
+		return luco::parser::try_parse(std::string(raw_json), projection);
+	}
+
+	inline luco::node parser::parse(const std::filesystem::path& path, const class projection& projection)
+	{
+		expected<luco::node, error> ok = luco::parser::try_parse(path, projection);
+		if (not ok)
+		{
+			raise_error(ok.error());
+		}
+
+		return ok.value();
+	}
+
+	inline luco::node parser::parse(const std::string& raw_json, const class projection& projection)
+	{
+		expected<luco::node, error> ok = luco::parser::try_parse(raw_json, projection);
+		if (not ok)
+		{
+			raise_error(ok.error());
+		}
+
+		return ok.value();
+	}
+
+	inline luco::node parser::parse(const char* raw_json, const class projection& projection)
+	{
+		expected<luco::node, error> ok = luco::parser::try_parse(raw_json, projection);
+		if (not ok)
+		{
+			raise_error(ok.error());
+		}
+
+		return ok.value();
+	}
+}
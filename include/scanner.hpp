@@ -0,0 +1,564 @@
+/*
+ * Copyright: 2025 nodeluna
+ * SPDX-License-Identifier: Apache-2.0
+ * repository: https://github.com/nodeluna/luco
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include "simd.hpp"
+
+/**
+ * @brief the namespace for luco
+ */
+namespace luco
+{
+	/**
+	 * @class scanner
+	 * @brief finds where luco items start and end without building any node. it's used to skip whole subtrees at scan
+	 * speed, counting brackets while respecting quotes, escapes and comments the same way the parser does. it's usable in
+	 * constant expressions, see luco::static_document
+	 * @detail every skip method returns the position right after what it skipped, or scanner::incomplete when the text
+	 * ends before the item does and more text may follow (see the eof flag of the constructor)
+	 */
+	class scanner {
+		private:
+			std::string_view _text;
+			bool		 _eof;
+
+			constexpr bool is_doubled(size_t pos) const noexcept;
+
+		public:
+			static constexpr size_t incomplete = std::string_view::npos;
+
+			/**
+			 * @enum item_kind
+			 * @brief what an item inside an object or array is
+			 */
+			enum class item_kind {
+				key_value, // key = value
+				key_block, // key { ... } or key = { ... }
+				value,	   // a bare array element
+				block,	   // a bare { ... } array element
+				close,	   // the '}' closing the current object or array
+				end,	   // the end of the text
+			};
+
+			/**
+			 * @struct item
+			 * @brief the location of one item, [begin, end) covers the whole item without its trailing newline
+			 */
+			struct item {
+					item_kind kind	    = item_kind::end;
+					size_t	  begin	    = 0;
+					size_t	  end	    = 0;
+					size_t	  key_end   = 0; // where the key stops, for key_value and key_block
+					size_t	  block	    = 0; // the position of '{', for key_block and block
+			};
+
+			/**
+			 * @brief constructor for luco::scanner
+			 * @param text the luco text to scan, it isn't copied
+			 * @param eof whether the text is complete. when it isn't, values and comments reaching the end of the
+			 * text are incomplete instead of ending there
+			 */
+			constexpr explicit scanner(std::string_view text, bool eof = true) noexcept;
+
+			/**
+			 * @brief skips spaces, newlines and comments
+			 * @return the position of the next significant character or the size of the text
+			 */
+			constexpr size_t skip_blank(size_t pos) const noexcept;
+
+			/**
+			 * @brief skips a '#' comment, or a nested '#{ }' comment
+			 * @param pos the position of '#'
+			 */
+			constexpr size_t skip_comment(size_t pos) const noexcept;
+
+			/**
+			 * @brief skips a key or a value, quoted or not, including '\' line continuations
+			 * @return the position of the character that ended it: '=', '{', '}', '#', newline or the size of the text
+			 */
+			constexpr size_t skip_token(size_t pos) const noexcept;
+
+			/**
+			 * @brief skips an object or array with everything nested in it
+			 * @param pos the position of '{'
+			 * @return the position right after its matching '}'
+			 */
+			constexpr size_t skip_block(size_t pos) const noexcept;
+
+			/**
+			 * @brief skips an object or array in a text that may end before it does, continuing where the
+			 * previous call stopped once more text is available
+			 * @param pos the position of '{' on the first call, resume_at of the previous call afterwards
+			 * @param depth the number of brackets still open, 0 on the first call
+			 * @param resume_at when the text ends first, set to where the next call continues. the text before it
+			 * has been skipped and isn't needed anymore
+			 * @return the position right after the matching '}', or scanner::incomplete
+			 */
+			constexpr size_t skip_block(size_t pos, size_t& depth, size_t& resume_at) const noexcept;
+
+			/**
+			 * @brief finds the next item of the object or array being scanned
+			 * @param pos a position between two items
+			 * @param skip_blocks when false, the end of key_block and block items is left at 0 for the caller to
+			 * scan the block itself
+			 * @return the item, its end is scanner::incomplete if the text ends inside of it
+			 */
+			constexpr item next_item(size_t pos, bool skip_blocks = true) const noexcept;
+
+			/**
+			 * @return true if a key_value or value item ends with a '\\' line continuation that nothing follows
+			 */
+			constexpr bool continued(const item& item) const noexcept;
+
+			/**
+			 * @return true if a raw key or value has none of the characters the parser treats specially, other
+			 * than quotes wrapping all of it. the scanner and the parser read such a token the same way
+			 */
+			static constexpr bool plain(std::string_view raw) noexcept;
+
+			/**
+			 * @brief unescapes the key of a key_value or key_block item the way the parser does
+			 */
+			constexpr std::string key(const item& item) const;
+
+			/**
+			 * @brief unescapes the value of a key_value or value item the way the parser does, joining '\' line
+			 * continuations
+			 * @param quoted set to whether the value was quoted
+			 */
+			constexpr std::string value(const item& item, bool& quoted) const;
+
+			/**
+			 * @return the scanned text
+			 */
+			constexpr std::string_view text() const noexcept;
+	};
+}
+
+namespace luco
+{
+	constexpr scanner::scanner(std::string_view text, bool eof) noexcept : _text(text), _eof(eof)
+	{
+	}
+
+	constexpr bool scanner::is_doubled(size_t pos) const noexcept
+	{
+		return pos + 1 < _text.size() && _text[pos + 1] == _text[pos];
+	}
+
+	constexpr size_t scanner::skip_blank(size_t pos) const noexcept
+	{
+		while (pos < _text.size())
+		{
+			char ch = _text[pos];
+			if (ch == ' ' || ch == '\t' || ch == '\n' || ch == '\r')
+			{
+				pos++;
+			}
+			else if (ch == '#')
+			{
+				pos = this->skip_comment(pos);
+				if (pos == incomplete)
+				{
+					return incomplete;
+				}
+			}
+			else
+			{
+				return pos;
+			}
+		}
+
+		return _eof ? _text.size() : incomplete;
+	}
+
+	constexpr size_t scanner::skip_comment(size_t pos) const noexcept
+	{
+		size_t brackets = 0;
+		bool   nested	= false;
+		for (pos++; pos < _text.size(); pos++)
+		{
+			if (std::is_constant_evaluated())
+			{
+				pos = std::min(_text.find_first_of("\n{}", pos), _text.size());
+			}
+			else
+			{
+				pos = static_cast<size_t>(simd::find_any_of(_text.data() + pos, _text.data() + _text.size(), '\n', '{', '}') -
+							  _text.data());
+			}
+			if (pos == _text.size())
+			{
+				break;
+			}
+
+			char ch = _text[pos];
+			if (not nested && ch == '\n')
+			{
+				return pos + 1;
+			}
+			else if (ch != '\n' && this->is_doubled(pos))
+			{
+				// '{{' and '}}' are escaped like everywhere else and don't open or close anything
+				pos++;
+			}
+			else if (ch == '{' && not nested)
+			{
+				nested = true;
+			}
+			else if (ch == '{')
+			{
+				brackets++;
+			}
+			else if (ch == '}' && nested && brackets == 0)
+			{
+				return pos + 1;
+			}
+			else if (ch == '}' && nested)
+			{
+				brackets--;
+			}
+		}
+
+		return _eof && not nested ? _text.size() : incomplete;
+	}
+
+	constexpr size_t scanner::skip_token(size_t pos) const noexcept
+	{
+		// like in the parser only a token starting with a quote is quoted, and a '#' inside the quotes doesn't start a
+		// comment
+		char quote = '\0';
+		if (pos < _text.size() && (_text[pos] == '"' || _text[pos] == '\''))
+		{
+			quote = _text[pos++];
+		}
+
+		for (; pos < _text.size(); pos++)
+		{
+			char ch = _text[pos];
+			if (ch == '\\' && this->is_doubled(pos))
+			{
+				// an escaped '\\' doesn't continue the line
+				pos++;
+			}
+			else if (ch == '\\')
+			{
+				size_t next = _text.find_first_not_of(" \t\r", pos + 1);
+				if (next != std::string_view::npos && _text[next] == '\n')
+				{
+					pos = next;
+				}
+			}
+			else if (ch == '\n')
+			{
+				return pos;
+			}
+			else if (quote != '\0')
+			{
+				if (ch == quote && this->is_doubled(pos))
+				{
+					pos++;
+				}
+				else if (ch == quote)
+				{
+					quote = '\0';
+				}
+			}
+			else if (ch == '#')
+			{
+				return pos;
+			}
+			else if ((ch == '=' || ch == '{' || ch == '}') && this->is_doubled(pos))
+			{
+				pos++;
+			}
+			else if (ch == '=' || ch == '{' || ch == '}')
+			{
+				return pos;
+			}
+		}
+
+		return _eof ? _text.size() : incomplete;
+	}
+
+	constexpr size_t scanner::skip_block(size_t pos) const noexcept
+	{
+		size_t depth	 = 0;
+		size_t resume_at = pos;
+		return this->skip_block(pos, depth, resume_at);
+	}
+
+	constexpr size_t scanner::skip_block(size_t pos, size_t& depth, size_t& resume_at) const noexcept
+	{
+		do
+		{
+			if (pos >= _text.size())
+			{
+				resume_at = pos;
+				return incomplete;
+			}
+			else if (_text[pos] == '{')
+			{
+				depth++;
+				pos++;
+			}
+			else if (_text[pos] == '}')
+			{
+				depth--;
+				pos++;
+				continue;
+			}
+
+			// the brackets before pos are counted in depth, only what follows is scanned again after a refill
+			resume_at = pos;
+			pos	  = this->skip_blank(pos);
+			if (pos == incomplete || pos == _text.size())
+			{
+				return incomplete;
+			}
+			else if (_text[pos] == '{' || _text[pos] == '}')
+			{
+				continue;
+			}
+
+			pos = this->skip_token(pos);
+			if (pos == incomplete || pos == _text.size())
+			{
+				return incomplete;
+			}
+			else if (_text[pos] == '=')
+			{
+				pos = _text.find_first_not_of(" \t", pos + 1);
+				if (pos == std::string_view::npos)
+				{
+					return incomplete;
+				}
+				else if (_text[pos] != '{')
+				{
+					pos = this->skip_token(pos);
+					if (pos == incomplete || pos == _text.size())
+					{
+						return incomplete;
+					}
+				}
+			}
+		} while (depth != 0);
+
+		return pos;
+	}
+
+	constexpr scanner::item scanner::next_item(size_t pos, bool skip_blocks) const noexcept
+	{
+		item item;
+		item.begin = this->skip_blank(pos);
+		if (item.begin == incomplete)
+		{
+			item.begin = _text.size();
+			item.end   = incomplete;
+			return item;
+		}
+		else if (item.begin == _text.size())
+		{
+			item.end = item.begin;
+			return item;
+		}
+		else if (_text[item.begin] == '}')
+		{
+			item.kind = item_kind::close;
+			item.end  = item.begin + 1;
+			return item;
+		}
+		else if (_text[item.begin] == '{')
+		{
+			item.kind  = item_kind::block;
+			item.block = item.begin;
+			item.end   = skip_blocks ? this->skip_block(item.block) : 0;
+			return item;
+		}
+
+		size_t token_end = this->skip_token(item.begin);
+		if (token_end == incomplete)
+		{
+			item.kind = item_kind::value;
+			item.end  = incomplete;
+			return item;
+		}
+		else if (token_end == _text.size() || _text[token_end] == '\n' || _text[token_end] == '}' || _text[token_end] == '#')
+		{
+			item.kind = item_kind::value;
+			item.end  = token_end;
+			return item;
+		}
+
+		item.key_end = token_end;
+		if (_text[token_end] == '{')
+		{
+			item.kind  = item_kind::key_block;
+			item.block = token_end;
+			item.end   = skip_blocks ? this->skip_block(item.block) : 0;
+			return item;
+		}
+
+		size_t value = _text.find_first_not_of(" \t", token_end + 1);
+		if (value == std::string_view::npos)
+		{
+			item.kind = item_kind::key_value;
+			item.end  = _eof ? _text.size() : incomplete;
+		}
+		else if (_text[value] == '{')
+		{
+			item.kind  = item_kind::key_block;
+			item.block = value;
+			item.end   = skip_blocks ? this->skip_block(item.block) : 0;
+		}
+		else
+		{
+			item.kind = item_kind::key_value;
+			item.end  = this->skip_token(value);
+		}
+
+		return item;
+	}
+
+	constexpr bool scanner::continued(const item& item) const noexcept
+	{
+		size_t last = item.end == 0 ? std::string_view::npos : _text.find_last_not_of(" \t\r\n", item.end - 1);
+		if (last == std::string_view::npos || last < item.begin || _text[last] != '\\')
+		{
+			return false;
+		}
+
+		// pairs of them are escaped ones
+		size_t run = 0;
+		for (size_t i = last + 1; i > item.begin && _text[i - 1] == '\\'; i--)
+		{
+			run++;
+		}
+
+		return run % 2 == 1;
+	}
+
+	constexpr bool scanner::plain(std::string_view raw) noexcept
+	{
+		while (not raw.empty() && (raw.back() == ' ' || raw.back() == '\t' || raw.back() == '\r'))
+		{
+			raw.remove_suffix(1);
+		}
+
+		// a '#' inside of quotes doesn't start a comment
+		std::string_view special = "={}#\"'\\";
+		if (not raw.empty() && (raw.front() == '"' || raw.front() == '\''))
+		{
+			if (raw.size() < 2 || raw.back() != raw.front())
+			{
+				return false;
+			}
+			raw	= raw.substr(1, raw.size() - 2);
+			special = "={}\"'\\";
+		}
+
+		return not raw.empty() && raw.find_first_of(special) == std::string_view::npos;
+	}
+
+	constexpr std::string scanner::key(const item& item) const
+	{
+		std::string_view raw = _text.substr(item.begin, item.key_end - item.begin);
+		while (not raw.empty() && (raw.back() == ' ' || raw.back() == '\t'))
+		{
+			raw.remove_suffix(1);
+		}
+
+		std::string key;
+		key.reserve(raw.size());
+		char quote = '\0';
+		if (not raw.empty() && (raw.front() == '"' || raw.front() == '\''))
+		{
+			quote = raw.front();
+			raw.remove_prefix(1);
+			if (not raw.empty() && raw.back() == quote)
+			{
+				raw.remove_suffix(1);
+			}
+		}
+
+		for (size_t i = 0; i < raw.size(); i++)
+		{
+			key += raw[i];
+			if (i + 1 < raw.size() && raw[i + 1] == raw[i] && (raw[i] == quote || raw[i] == '=' || raw[i] == '{' || raw[i] == '}'))
+			{
+				i++;
+			}
+		}
+
+		return key;
+	}
+
+	constexpr std::string scanner::value(const item& item, bool& quoted) const
+	{
+		size_t begin = item.kind == item_kind::key_value ? item.key_end + 1 : item.begin;
+		begin	     = std::min(_text.find_first_not_of(" \t", begin), item.end);
+
+		std::string_view raw = _text.substr(begin, item.end - begin);
+		while (not raw.empty() && (raw.back() == ' ' || raw.back() == '\t' || raw.back() == '\r'))
+		{
+			raw.remove_suffix(1);
+		}
+
+		std::string value;
+		value.reserve(raw.size());
+		char quote = '\0';
+		quoted	   = not raw.empty() && (raw.front() == '"' || raw.front() == '\'');
+		if (quoted)
+		{
+			quote = raw.front();
+			raw.remove_prefix(1);
+			if (not raw.empty() && raw.back() == quote)
+			{
+				raw.remove_suffix(1);
+			}
+		}
+
+		for (size_t i = 0; i < raw.size(); i++)
+		{
+			if (raw[i] == '\\' && i + 1 < raw.size() && raw[i + 1] == '\\')
+			{
+				value += raw[i++];
+			}
+			else if (raw[i] == '\\')
+			{
+				// a continuation drops the newline and the indentation of the next line
+				size_t next = raw.find_first_not_of(" \t\r", i + 1);
+				if (next != std::string_view::npos && raw[next] == '\n')
+				{
+					next = raw.find_first_not_of(" \t", next + 1);
+					i    = (next == std::string_view::npos ? raw.size() : next) - 1;
+				}
+			}
+			else if (i + 1 < raw.size() && raw[i + 1] == raw[i] &&
+				 (raw[i] == '"' || raw[i] == '\'' || raw[i] == '=' || raw[i] == '{' || raw[i] == '}'))
+			{
+				value += raw[i++];
+			}
+			else
+			{
+				value += raw[i];
+			}
+		}
+
+		return value;
+	}
+
+	constexpr std::string_view scanner::text() const noexcept
+	{
+		return _text;
+	}
+}
@@ -0,0 +1,800 @@
+/*
+ * Copyright: 2025 nodeluna
+ * SPDX-License-Identifier: Apache-2.0
+ * repository: https://github.com/nodeluna/luco
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <charconv>
+#include <cstdint>
+#include <filesystem>
+#include <initializer_list>
+#include <memory>
+#include <optional>
+#include <regex>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+#include "api.hpp"
+#include "expected.hpp"
+#include "error.hpp"
+
+/**
+ * @brief the namespace for luco
+ */
+namespace luco
+{
+	/**
+	 * @class schema
+	 * @brief declares the type of the values at some key paths and the rules they follow. the parser converts those
+	 * values straight to the declared type instead of guessing it, and reports the ones that don't fit
+	 * @detail @cpp
+	 * luco::schema types = {
+	 *     {{"server", "port"}, luco::value_type::integer},
+	 *     {{"server", "name"}, luco::value_type::string}, // "5" stays a string
+	 *     {{"replicas", luco::schema::element, "weight"}, luco::value_type::double_t},
+	 * };
+	 * luco::parse_options options;
+	 * options.schema = &types;
+	 * luco::node node = luco::parser::parse(std::filesystem::path("config.luco"), options);
+	 * @ecpp
+	 *
+	 * a schema can also be written in luco, see schema::try_parse()
+	 */
+	class schema {
+		public:
+			using key_path = std::vector<std::string>;
+
+			/**
+			 * @brief the key standing for every element of an array in a key_path
+			 */
+			static constexpr const char* element = "[]";
+
+			/**
+			 * @brief the longest string a pattern is matched against. std::regex matches recursively, one stack
+			 * frame per character, so a longer string is a schema violation instead of a stack overflow
+			 */
+			static constexpr size_t pattern_limit = 1024;
+
+			/**
+			 * @struct entry
+			 * @brief the rules declared at one key path. all the entries of a schema are stored flat and the keys
+			 * of an entry, or element for the elements of its array, lead to the indices of the entries nested in it
+			 */
+			struct entry {
+					std::optional<value_type>		    type;
+					std::optional<node_type>		    shape;
+					bool					    required = false;
+					bool					    closed   = false;
+					std::optional<double>			    min;
+					std::optional<double>			    max;
+					std::vector<luco::value>		    one_of;
+					std::shared_ptr<const std::regex>	    pattern;
+					std::string				    pattern_source;
+					std::vector<std::pair<std::string, size_t>> keys;
+			};
+
+		private:
+			std::vector<entry> _entries = std::vector<entry>(1);
+
+			inline size_t			  child(size_t at, std::string_view key);
+			inline expected<monostate, error> compile_rule(const luco::node& rule, size_t at, const std::string& path);
+			inline void			  infer_rule(const luco::node& sample, size_t at);
+			inline expected<monostate, error> check_value(const entry& rule, const class value& value) const;
+			inline expected<monostate, error> check_size(const entry& rule, size_t size, const char* unit) const;
+
+		public:
+			inline schema() = default;
+
+			/**
+			 * @brief constructor for luco::schema
+			 * @param types pairs of a key path and the type of the value at it
+			 */
+			inline schema(std::initializer_list<std::pair<key_path, value_type>> types);
+
+			/**
+			 * @brief compiles a schema written in luco. every rule is an object that may hold:
+			 * type = string, integer, double, number, boolean, null, object, array or any
+			 * required = true, closed = true (no keys but the declared ones)
+			 * min, max (of a number, or of the length of a string or the size of an array or object)
+			 * enum { the allowed values }, pattern = a regex matched against the whole string, of at most pattern_limit
+			 * characters
+			 * keys { key { rule } }, elements { rule }
+			 * @param definition the rule of the root object
+			 * @return the schema, or an error if the definition isn't a valid schema
+			 */
+			inline static expected<schema, error> try_compile(const luco::node& definition) noexcept;
+
+			/**
+			 * @brief compiles a schema written in luco
+			 * @see try_compile()
+			 */
+			inline static schema compile(const luco::node& definition);
+
+			/**
+			 * @brief builds the schema a representative config follows: the type of every value and the shape of
+			 * every object and array. array elements share one entry, integers and doubles mixed in it become
+			 * numbers and any other mix becomes strings. nothing is required
+			 * @param sample the root object of the config
+			 */
+			inline static schema infer(const luco::node& sample);
+
+			/**
+			 * @brief parses a schema written in luco
+			 * @detail @cpp
+			 * keys {
+			 *     server {
+			 *         required = true
+			 *         keys {
+			 *             port {
+			 *                 type = integer
+			 *                 min = 1
+			 *                 max = 65535
+			 *             }
+			 *         }
+			 *     }
+			 * }
+			 * @ecpp
+			 * @see try_compile()
+			 */
+			inline static expected<schema, error> try_parse(const std::filesystem::path& path) noexcept;
+			inline static expected<schema, error> try_parse(const std::string& raw_luco) noexcept;
+			inline static expected<schema, error> try_parse(const char* raw_luco) noexcept;
+			inline static schema		      parse(const std::filesystem::path& path);
+			inline static schema		      parse(const std::string& raw_luco);
+			inline static schema		      parse(const char* raw_luco);
+
+			/**
+			 * @brief declares the type of the value at a key path, replacing what was declared there before
+			 * @param type value_type::string, integer, double_t, number (an integer or a double), boolean or null
+			 */
+			inline schema& declare(const key_path& path, value_type type);
+
+			/**
+			 * @return the type declared at a key path
+			 */
+			inline std::optional<value_type> type_of(const key_path& path) const;
+
+			/**
+			 * @return the entry of the root object
+			 */
+			inline const entry& root() const noexcept;
+
+			/**
+			 * @return the entry of a key nested in an entry, or nullptr if nothing is declared under it
+			 */
+			inline const entry* find(const entry& at, std::string_view key) const noexcept;
+
+			/**
+			 * @brief checks a node against the rules of one entry without looking into its children
+			 * @return an error of error_type::wrong_type or error_type::schema_violation on the first broken rule
+			 */
+			inline expected<monostate, error> check(const entry& rule, const luco::node& node) const;
+
+			/**
+			 * @brief validates a whole tree in one pass over the nodes that have rules, without recursion
+			 * @return the first broken rule, prefixed with the path of the node breaking it
+			 */
+			inline expected<monostate, error> try_validate(const luco::node& node) const noexcept;
+
+			/**
+			 * @brief validates a whole tree
+			 * @see try_validate()
+			 */
+			inline void validate(const luco::node& node) const;
+
+			/**
+			 * @brief converts the text of a value to a declared type without guessing. quoting doesn't matter
+			 * @param raw_value the text of the value, without its quotes
+			 * @return the converted value, or an error if the text doesn't fit the type
+			 */
+			inline static expected<std::variant<std::string, bool, double, int64_t, null_type>, error> convert(const std::string& raw_value,
+															 value_type	    type);
+
+			/**
+			 * @return the name of a type as used in errors
+			 */
+			inline static std::string type_name(value_type type);
+	};
+}
+
+namespace luco
+{
+	inline schema::schema(std::initializer_list<std::pair<key_path, value_type>> types)
+	{
+		for (const auto& [path, type] : types)
+		{
+			this->declare(path, type);
+		}
+	}
+
+	inline size_t schema::child(size_t at, std::string_view key)
+	{
+		auto& keys = _entries[at].keys;
+		auto  itr  = std::lower_bound(keys.begin(), keys.end(), key, [](const auto& pair, std::string_view k) { return pair.first < k; });
+		if (itr != keys.end() && itr->first == key)
+		{
+			return itr->second;
+		}
+
+		size_t index = _entries.size();
+		keys.insert(itr, std::make_pair(std::string(key), index));
+		_entries.emplace_back();
+
+		return index;
+	}
+
+	inline expected<monostate, error> schema::compile_rule(const luco::node& rule, size_t at, const std::string& path)
+	{
+		auto invalid = [&path](const std::string& why)
+		{ return unexpected(error(error_type::parsing_error, "invalid schema at '{}', {}", path.empty() ? "the root" : path, why)); };
+
+		if (not rule.is_object())
+		{
+			return invalid("a rule should be an object");
+		}
+
+		for (auto& [keyword, setting] : *rule.as_object())
+		{
+			if (keyword == "keys" || keyword == "elements")
+			{
+				if (not setting.is_object())
+				{
+					return invalid(std::format("'{}' should be an object", keyword));
+				}
+				else if (keyword == "elements")
+				{
+					auto ok = this->compile_rule(setting, this->child(at, element), path + element);
+					if (not ok)
+					{
+						return ok;
+					}
+					continue;
+				}
+
+				for (auto& [key, nested] : *setting.as_object())
+				{
+					auto ok = this->compile_rule(nested, this->child(at, key), path.empty() ? key : path + "." + key);
+					if (not ok)
+					{
+						return ok;
+					}
+				}
+				continue;
+			}
+			else if (keyword == "enum")
+			{
+				if (not setting.is_array())
+				{
+					return invalid("'enum' should be an array of values");
+				}
+				for (auto& allowed : *setting.as_array())
+				{
+					if (not allowed.is_value())
+					{
+						return invalid("'enum' should be an array of values");
+					}
+					_entries[at].one_of.push_back(*allowed.as_value());
+				}
+				continue;
+			}
+			else if (not setting.is_value())
+			{
+				return invalid(std::format("'{}' should be a value", keyword));
+			}
+
+			class value& value = *setting.as_value();
+			entry&	     rules = _entries[at];
+			if (keyword == "type" && (value.is_string() || value.is_null()))
+			{
+				// type = null reads as a null value, not as the string "null"
+				const std::string name = value.is_null() ? "null" : value.as_string();
+				if (name == "string" || name == "integer" || name == "double" || name == "number" || name == "boolean" ||
+				    name == "null")
+				{
+					rules.type = name == "string"	 ? value_type::string
+						     : name == "integer" ? value_type::integer
+						     : name == "double"	 ? value_type::double_t
+						     : name == "number"	 ? value_type::number
+						     : name == "boolean" ? value_type::boolean
+									 : value_type::null;
+				}
+				else if (name == "object" || name == "array")
+				{
+					rules.shape = name == "object" ? node_type::object : node_type::array;
+				}
+				else if (name != "any")
+				{
+					return invalid(std::format("unknown type '{}'", name));
+				}
+			}
+			else if ((keyword == "required" || keyword == "closed") && value.is_boolean())
+			{
+				(keyword == "required" ? rules.required : rules.closed) = value.as_boolean();
+			}
+			else if ((keyword == "min" || keyword == "max") && value.is_number())
+			{
+				(keyword == "min" ? rules.min : rules.max) = value.as_number();
+			}
+			else if (keyword == "pattern" && value.is_string())
+			{
+				rules.pattern_source = value.as_string();
+#ifdef LUCO_NO_EXCEPTIONS
+				// std::regex reports an invalid pattern only by throwing, without exceptions it aborts
+				rules.pattern = std::make_shared<const std::regex>(rules.pattern_source);
+#else
+				try
+				{
+					rules.pattern = std::make_shared<const std::regex>(rules.pattern_source);
+				}
+				catch (const std::regex_error& e)
+				{
+					return invalid(std::format("the pattern '{}' isn't a valid regex, {}", rules.pattern_source, e.what()));
+				}
+#endif
+			}
+			else if (keyword == "type" || keyword == "required" || keyword == "closed" || keyword == "min" || keyword == "max" ||
+				 keyword == "pattern")
+			{
+				return invalid(std::format("'{}' can't be '{}'", keyword, value.stringify()));
+			}
+			else
+			{
+				return invalid(std::format("unknown rule '{}'", keyword));
+			}
+		}
+
+		entry& rules	    = _entries[at];
+		bool   has_elements = this->find(rules, element) != nullptr;
+		bool   has_keys	    = rules.keys.size() > (has_elements ? 1 : 0);
+		if ((has_keys || has_elements) && rules.type)
+		{
+			return invalid(std::format("{} can't have keys or elements", type_name(rules.type.value())));
+		}
+		else if (has_keys && has_elements)
+		{
+			return invalid("a rule can't have both keys and elements");
+		}
+		else if ((has_keys && rules.shape == node_type::array) || (has_elements && rules.shape == node_type::object))
+		{
+			return invalid("the type doesn't match the keys or elements");
+		}
+		else if (not rules.shape && (has_keys || has_elements))
+		{
+			rules.shape = has_keys ? node_type::object : node_type::array;
+		}
+
+		return monostate();
+	}
+
+	inline expected<schema, error> schema::try_compile(const luco::node& definition) noexcept
+	{
+		schema compiled;
+		auto   ok = compiled.compile_rule(definition, 0, "");
+		if (not ok)
+		{
+			return unexpected(ok.error());
+		}
+
+		return compiled;
+	}
+
+	inline schema schema::compile(const luco::node& definition)
+	{
+		expected<schema, error> ok = schema::try_compile(definition);
+		if (not ok)
+		{
+			raise_error(ok.error());
+		}
+
+		return ok.value();
+	}
+
+	inline void schema::infer_rule(const luco::node& sample, size_t at)
+	{
+		if (const auto* value = std::get_if<std::shared_ptr<class value>>(&sample._node))
+		{
+			value_type type	   = (*value)->type();
+			entry&	   rules   = _entries[at];
+			bool	   numbers = (type == value_type::integer || type == value_type::double_t) &&
+				       (rules.type == value_type::integer || rules.type == value_type::double_t || rules.type == value_type::number);
+			if (not rules.type || rules.type == type)
+			{
+				rules.type = type;
+			}
+			else
+			{
+				rules.type = numbers ? value_type::number : value_type::string;
+			}
+		}
+		else if (const auto* object = std::get_if<std::shared_ptr<luco::object>>(&sample._node))
+		{
+			_entries[at].shape = node_type::object;
+			for (auto& [key, nested] : **object)
+			{
+				this->infer_rule(nested, this->child(at, key));
+			}
+		}
+		else
+		{
+			_entries[at].shape = node_type::array;
+			for (auto& nested : *std::get<std::shared_ptr<luco::array>>(sample._node))
+			{
+				this->infer_rule(nested, this->child(at, element));
+			}
+		}
+	}
+
+	inline schema schema::infer(const luco::node& sample)
+	{
+		schema inferred;
+		inferred.infer_rule(sample, 0);
+
+		return inferred;
+	}
+
+	inline schema& schema::declare(const key_path& path, value_type type)
+	{
+		size_t at = 0;
+		for (const std::string& key : path)
+		{
+			at = this->child(at, key);
+		}
+		_entries[at].type = type;
+
+		return *this;
+	}
+
+	inline std::optional<value_type> schema::type_of(const key_path& path) const
+	{
+		const entry* at = &_entries.front();
+		for (const std::string& key : path)
+		{
+			at = this->find(*at, key);
+			if (at == nullptr)
+			{
+				return std::nullopt;
+			}
+		}
+
+		return at->type;
+	}
+
+	inline const schema::entry& schema::root() const noexcept
+	{
+		return _entries.front();
+	}
+
+	inline const schema::entry* schema::find(const entry& at, std::string_view key) const noexcept
+	{
+		auto itr =
+		    std::lower_bound(at.keys.begin(), at.keys.end(), key, [](const auto& pair, std::string_view k) { return pair.first < k; });
+
+		return itr == at.keys.end() || itr->first != key ? nullptr : &_entries[itr->second];
+	}
+
+	inline expected<monostate, error> schema::check_size(const entry& rule, size_t size, const char* unit) const
+	{
+		if (rule.min && static_cast<double>(size) < rule.min.value())
+		{
+			return unexpected(
+			    error(error_type::schema_violation, "expected at least {} {} but found {}", rule.min.value(), unit, size));
+		}
+		else if (rule.max && static_cast<double>(size) > rule.max.value())
+		{
+			return unexpected(
+			    error(error_type::schema_violation, "expected at most {} {} but found {}", rule.max.value(), unit, size));
+		}
+
+		return monostate();
+	}
+
+	inline expected<monostate, error> schema::check_value(const entry& rule, const class value& value) const
+	{
+		auto same_as = [](const class value& value)
+		{
+			return [&value](const auto& allowed)
+			{
+				using type = std::decay_t<decltype(allowed)>;
+				if constexpr (std::is_same_v<type, monostate>)
+				{
+					return true;
+				}
+				else
+				{
+					return allowed == std::get<type>(value._value);
+				}
+			};
+		};
+
+		if (const auto* string = std::get_if<std::string>(&value._value))
+		{
+			auto ok = this->check_size(rule, string->size(), "characters");
+			if (not ok)
+			{
+				return ok;
+			}
+			else if (rule.pattern && string->size() > pattern_limit)
+			{
+				return unexpected(error(error_type::schema_violation, "a string of {} characters is too long to match the pattern '{}'",
+							string->size(), rule.pattern_source));
+			}
+			else if (rule.pattern && not std::regex_match(*string, *rule.pattern))
+			{
+				return unexpected(
+				    error(error_type::schema_violation, "'{}' doesn't match the pattern '{}'", *string, rule.pattern_source));
+			}
+		}
+		else if (value.is_number())
+		{
+			double number = value.is_integer() ? static_cast<double>(std::get<int64_t>(value._value)) : std::get<double>(value._value);
+			if ((rule.min && number < rule.min.value()) || (rule.max && number > rule.max.value()))
+			{
+				return unexpected(error(error_type::schema_violation, "expected {} {} but found {}",
+							rule.min && number < rule.min.value() ? "at least" : "at most",
+							rule.min && number < rule.min.value() ? rule.min.value() : rule.max.value(),
+							value.stringify()));
+			}
+		}
+
+		if (not rule.one_of.empty() &&
+		    std::none_of(rule.one_of.begin(), rule.one_of.end(), [&value, &same_as](const class value& allowed)
+				 { return allowed._value.index() == value._value.index() && std::visit(same_as(value), allowed._value); }))
+		{
+			std::string allowed;
+			for (const class value& one : rule.one_of)
+			{
+				allowed += (allowed.empty() ? "" : ", ") + one.stringify();
+			}
+			return unexpected(
+			    error(error_type::schema_violation, "expected one of {} but found '{}'", allowed, value.stringify()));
+		}
+
+		return monostate();
+	}
+
+	inline expected<monostate, error> schema::check(const entry& rule, const luco::node& node) const
+	{
+		if (const auto* value = std::get_if<std::shared_ptr<class value>>(&node._node))
+		{
+			value_type type = (*value)->type();
+			if (rule.shape)
+			{
+				return unexpected(error(error_type::wrong_type, "expected {} but found {} '{}'",
+							rule.shape == node_type::object ? "an object" : "an array", type_name(type),
+							(*value)->stringify()));
+			}
+			else if (rule.type && rule.type != type &&
+				 not(rule.type == value_type::number && (type == value_type::integer || type == value_type::double_t)))
+			{
+				return unexpected(error(error_type::wrong_type, "expected {} but found {} '{}'", type_name(rule.type.value()),
+							type_name(type), (*value)->stringify()));
+			}
+
+			return this->check_value(rule, **value);
+		}
+
+		const bool is_object = std::holds_alternative<std::shared_ptr<luco::object>>(node._node);
+		if (rule.type || (rule.shape && rule.shape != (is_object ? node_type::object : node_type::array)))
+		{
+			return unexpected(error(error_type::wrong_type, "expected {} but found {}",
+						rule.type ? type_name(rule.type.value()) : (is_object ? "an array" : "an object"),
+						is_object ? "an object" : "an array"));
+		}
+		else if (not is_object)
+		{
+			return this->check_size(rule, std::get<std::shared_ptr<luco::array>>(node._node)->size(), "elements");
+		}
+
+		luco::object& object = *std::get<std::shared_ptr<luco::object>>(node._node);
+		for (const auto& [key, index] : rule.keys)
+		{
+			if (_entries[index].required && object.find(key) == object.end())
+			{
+				return unexpected(error(error_type::schema_violation, "missing the required key '{}'", key));
+			}
+		}
+		if (rule.closed)
+		{
+			for (const auto& [key, _] : object)
+			{
+				if (this->find(rule, key) == nullptr)
+				{
+					return unexpected(error(error_type::schema_violation, "the key '{}' isn't allowed", key));
+				}
+			}
+		}
+
+		return this->check_size(rule, object.size(), "keys");
+	}
+
+	inline expected<monostate, error> schema::try_validate(const luco::node& node) const noexcept
+	{
+		struct frame {
+				const luco::node* node;
+				const entry*	  rule;
+				std::string_view  key;
+				size_t		  index;
+				size_t		  next;
+		};
+		std::vector<frame> stack;
+
+		auto broken = [&stack](const error& why, const frame& at)
+		{
+			std::string path;
+			for (size_t i = 1; i <= stack.size(); i++)
+			{
+				const frame& step = i < stack.size() ? stack[i] : at;
+				if (step.key.empty())
+				{
+					path += std::format("[{}]", step.index);
+				}
+				else
+				{
+					path += (path.empty() ? "" : ".") + std::string(step.key);
+				}
+			}
+			return unexpected(error(why.value(), "{}: {}", path.empty() ? "the root" : path, why.message()));
+		};
+
+		frame root = {&node, &_entries.front(), std::string_view(), 0, 0};
+		if (auto ok = this->check(*root.rule, node); not ok)
+		{
+			return broken(ok.error(), root);
+		}
+		stack.push_back(root);
+
+		while (not stack.empty())
+		{
+			frame&		  top  = stack.back();
+			frame		  next = {nullptr, nullptr, std::string_view(), 0, 0};
+			const luco::node& at   = *top.node;
+
+			if (const auto* object = std::get_if<std::shared_ptr<luco::object>>(&at._node))
+			{
+				for (; top.next < top.rule->keys.size() && next.node == nullptr; top.next++)
+				{
+					const auto& [key, index] = top.rule->keys[top.next];
+					auto itr		 = (*object)->find(key);
+					if (itr != (*object)->end())
+					{
+						next = {&itr->second, &_entries[index], key, 0, 0};
+					}
+				}
+			}
+			else if (const auto* array = std::get_if<std::shared_ptr<luco::array>>(&at._node))
+			{
+				const entry* elements = this->find(*top.rule, element);
+				if (elements != nullptr && top.next < (*array)->size())
+				{
+					next = {&(**array)[top.next], elements, std::string_view(), top.next, 0};
+					top.next++;
+				}
+			}
+
+			if (next.node == nullptr)
+			{
+				stack.pop_back();
+				continue;
+			}
+			else if (auto ok = this->check(*next.rule, *next.node); not ok)
+			{
+				return broken(ok.error(), next);
+			}
+			else if (not next.rule->keys.empty())
+			{
+				stack.push_back(next);
+			}
+		}
+
+		return monostate();
+	}
+
+	inline void schema::validate(const luco::node& node) const
+	{
+		expected<monostate, error> ok = this->try_validate(node);
+		if (not ok)
+		{
+			raise_error(ok.error());
+		}
+	}
+
+	inline expected<std::variant<std::string, bool, double, int64_t, null_type>, error> schema::convert(const std::string& raw_value,
+														    value_type	       type)
+	{
+		using variant	     = std::variant<std::string, bool, double, int64_t, null_type>;
+		const char* begin    = raw_value.data();
+		const char* end	     = raw_value.data() + raw_value.size();
+		auto	    mismatch = [&]()
+		{ return unexpected(error(error_type::parsing_error_wrong_type, "expected {} but found '{}'", type_name(type), raw_value)); };
+
+		switch (type)
+		{
+			case value_type::string:
+				return variant(raw_value);
+			case value_type::integer:
+			{
+				int64_t integer = 0;
+				auto [ptr, ec]	= std::from_chars(begin, end, integer);
+				if (ec != std::errc() || ptr != end || raw_value.empty())
+				{
+					return mismatch();
+				}
+				return variant(integer);
+			}
+			case value_type::number:
+			{
+				int64_t integer = 0;
+				auto [ptr, ec]	= std::from_chars(begin, end, integer);
+				if (ec == std::errc() && ptr == end && not raw_value.empty())
+				{
+					return variant(integer);
+				}
+			}
+				[[fallthrough]];
+			case value_type::double_t:
+			{
+				double number  = 0;
+				auto [ptr, ec] = std::from_chars(begin, end, number);
+				if (ec != std::errc() || ptr != end || raw_value.empty())
+				{
+					return mismatch();
+				}
+				return variant(number);
+			}
+			case value_type::boolean:
+				if (raw_value == "true" || raw_value == "on")
+				{
+					return variant(true);
+				}
+				else if (raw_value == "false" || raw_value == "off")
+				{
+					return variant(false);
+				}
+				return mismatch();
+			case value_type::null:
+				if (raw_value == "null")
+				{
+					return variant(null_type());
+				}
+				return mismatch();
+			case value_type::none:
+			case value_type::temp_escape_type:
+			case value_type::unknown:
+				break;
+		}
+
+		return unexpected(error(error_type::wrong_type, "{} can't be declared in a luco::schema", type_name(type)));
+	}
+
+	inline std::string schema::type_name(value_type type)
+	{
+		switch (type)
+		{
+			case value_type::string:
+				return "a string";
+			case value_type::integer:
+				return "an integer";
+			case value_type::double_t:
+				return "a double";
+			case value_type::number:
+				return "a number";
+			case value_type::boolean:
+				return "a boolean";
+			case value_type::null:
+				return "null";
+			case value_type::none:
+			case value_type::temp_escape_type:
+			case value_type::unknown:
+				break;
+		}
+
+		return "an unsupported type";
+	}
+}
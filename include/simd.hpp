@@ -0,0 +1,352 @@
+/*
+ * Copyright: 2025 nodeluna
+ * SPDX-License-Identifier: Apache-2.0
+ * repository: https://github.com/nodeluna/luco
+ */
+
+#pragma once
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define LUCO_SSE2
+#endif
+
+/**
+ * @brief the namespace for luco
+ */
+namespace luco
+{
+	/**
+	 * @class simd
+	 * @brief byte scanning loops used by the tokenizers. they use AVX2 or SSE2 when the compiler targets them and fall
+	 * back to plain loops otherwise
+	 */
+	class simd {
+		private:
+			inline static bool is_string_special(char ch) noexcept
+			{
+				return ch == '"' || ch == '\\' || static_cast<unsigned char>(ch) < 0x20;
+			}
+
+			inline static bool is_luco_special(char ch) noexcept
+			{
+				return ch == '{' || ch == '}' || ch == '=' || ch == '"' || ch == '\'' || ch == '\\' || ch == '#' || ch == '\n' ||
+				       ch == '\0';
+			}
+
+			inline static bool is_json_whitespace(char ch) noexcept
+			{
+				return ch == ' ' || ch == '\n' || ch == '\t' || ch == '\r';
+			}
+
+		public:
+			/**
+			 * @brief finds the first '"', '\' or control character
+			 * @return a pointer to it, or end
+			 */
+			inline static const char* find_string_special(const char* begin, const char* end) noexcept;
+
+			/**
+			 * @brief skips ' ', '\n', '\t' and '\r'
+			 * @return a pointer to the first other character, or end
+			 */
+			inline static const char* skip_json_whitespace(const char* begin, const char* end) noexcept;
+
+			/**
+			 * @brief finds the first character that can end or change a luco key or value: '{', '}', '=', '"', ''',
+			 * '\', '#', newline or '\0'
+			 * @return a pointer to it, or end
+			 */
+			inline static const char* find_luco_special(const char* begin, const char* end) noexcept;
+
+			/**
+			 * @brief finds the first of three characters
+			 * @return a pointer to it, or end
+			 */
+			inline static const char* find_any_of(const char* begin, const char* end, char a, char b, char c) noexcept;
+
+			/**
+			 * @brief finds the first byte that doesn't start a valid UTF-8 sequence. overlong forms, surrogates, code
+			 * points above U+10FFFF and sequences cut short by end are invalid
+			 * @return a pointer to it, or end if [begin, end) is valid UTF-8
+			 */
+			inline static const char* find_invalid_utf8(const char* begin, const char* end) noexcept;
+	};
+}
+
+namespace luco
+{
+	inline const char* simd::find_string_special(const char* begin, const char* end) noexcept
+	{
+#if defined(__AVX2__)
+		const __m256i quote	= _mm256_set1_epi8('"');
+		const __m256i backslash = _mm256_set1_epi8('\\');
+		const __m256i control	= _mm256_set1_epi8(0x1F);
+		for (; end - begin >= 32; begin += 32)
+		{
+			__m256i	 chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(begin));
+			__m256i	 found = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(chunk, quote), _mm256_cmpeq_epi8(chunk, backslash)),
+							 _mm256_cmpeq_epi8(_mm256_max_epu8(chunk, control), control));
+			uint32_t mask  = static_cast<uint32_t>(_mm256_movemask_epi8(found));
+			if (mask != 0)
+			{
+				return begin + std::countr_zero(mask);
+			}
+		}
+#elif defined(LUCO_SSE2)
+		const __m128i quote	= _mm_set1_epi8('"');
+		const __m128i backslash = _mm_set1_epi8('\\');
+		const __m128i control	= _mm_set1_epi8(0x1F);
+		for (; end - begin >= 16; begin += 16)
+		{
+			__m128i	 chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(begin));
+			__m128i	 found = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(chunk, quote), _mm_cmpeq_epi8(chunk, backslash)),
+						      _mm_cmpeq_epi8(_mm_max_epu8(chunk, control), control));
+			uint32_t mask  = static_cast<uint32_t>(_mm_movemask_epi8(found));
+			if (mask != 0)
+			{
+				return begin + std::countr_zero(mask);
+			}
+		}
+#endif
+		while (begin != end && not simd::is_string_special(*begin))
+		{
+			begin++;
+		}
+
+		return begin;
+	}
+
+	inline const char* simd::skip_json_whitespace(const char* begin, const char* end) noexcept
+	{
+		// most runs are a single space or a newline followed by indentation, so only long runs go through the vector loop
+		while (begin != end && simd::is_json_whitespace(*begin))
+		{
+			begin++;
+			if (begin != end && *begin != ' ' && *begin != '\t')
+			{
+				continue;
+			}
+#if defined(__AVX2__)
+			const __m256i space = _mm256_set1_epi8(' ');
+			const __m256i tab   = _mm256_set1_epi8('\t');
+			const __m256i nl    = _mm256_set1_epi8('\n');
+			const __m256i cr    = _mm256_set1_epi8('\r');
+			for (; end - begin >= 32; begin += 32)
+			{
+				__m256i	 chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(begin));
+				__m256i	 blank = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(chunk, space), _mm256_cmpeq_epi8(chunk, tab)),
+								 _mm256_or_si256(_mm256_cmpeq_epi8(chunk, nl), _mm256_cmpeq_epi8(chunk, cr)));
+				uint32_t mask  = ~static_cast<uint32_t>(_mm256_movemask_epi8(blank));
+				if (mask != 0)
+				{
+					return begin + std::countr_zero(mask);
+				}
+			}
+#elif defined(LUCO_SSE2)
+			const __m128i space = _mm_set1_epi8(' ');
+			const __m128i tab   = _mm_set1_epi8('\t');
+			const __m128i nl    = _mm_set1_epi8('\n');
+			const __m128i cr    = _mm_set1_epi8('\r');
+			for (; end - begin >= 16; begin += 16)
+			{
+				__m128i	 chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(begin));
+				__m128i	 blank = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(chunk, space), _mm_cmpeq_epi8(chunk, tab)),
+							      _mm_or_si128(_mm_cmpeq_epi8(chunk, nl), _mm_cmpeq_epi8(chunk, cr)));
+				uint32_t mask  = ~static_cast<uint32_t>(_mm_movemask_epi8(blank)) & 0xFFFF;
+				if (mask != 0)
+				{
+					return begin + std::countr_zero(mask);
+				}
+			}
+#endif
+		}
+
+		return begin;
+	}
+
+	inline const char* simd::find_luco_special(const char* begin, const char* end) noexcept
+	{
+#if defined(__AVX2__)
+		const __m256i specials[] = {_mm256_set1_epi8('{'), _mm256_set1_epi8('}'),  _mm256_set1_epi8('='),
+					    _mm256_set1_epi8('"'), _mm256_set1_epi8('\''), _mm256_set1_epi8('\\'),
+					    _mm256_set1_epi8('#'), _mm256_set1_epi8('\n'), _mm256_setzero_si256()};
+		for (; end - begin >= 32; begin += 32)
+		{
+			__m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(begin));
+			__m256i found = _mm256_setzero_si256();
+			for (const __m256i& special : specials)
+			{
+				found = _mm256_or_si256(found, _mm256_cmpeq_epi8(chunk, special));
+			}
+			uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(found));
+			if (mask != 0)
+			{
+				return begin + std::countr_zero(mask);
+			}
+		}
+#elif defined(LUCO_SSE2)
+		const __m128i specials[] = {_mm_set1_epi8('{'), _mm_set1_epi8('}'),  _mm_set1_epi8('='),
+					    _mm_set1_epi8('"'), _mm_set1_epi8('\''), _mm_set1_epi8('\\'),
+					    _mm_set1_epi8('#'), _mm_set1_epi8('\n'), _mm_setzero_si128()};
+		for (; end - begin >= 16; begin += 16)
+		{
+			__m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(begin));
+			__m128i found = _mm_setzero_si128();
+			for (const __m128i& special : specials)
+			{
+				found = _mm_or_si128(found, _mm_cmpeq_epi8(chunk, special));
+			}
+			uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(found));
+			if (mask != 0)
+			{
+				return begin + std::countr_zero(mask);
+			}
+		}
+#endif
+		while (begin != end && not simd::is_luco_special(*begin))
+		{
+			begin++;
+		}
+
+		return begin;
+	}
+
+	inline const char* simd::find_any_of(const char* begin, const char* end, char a, char b, char c) noexcept
+	{
+#if defined(__AVX2__)
+		const __m256i first  = _mm256_set1_epi8(a);
+		const __m256i second = _mm256_set1_epi8(b);
+		const __m256i third  = _mm256_set1_epi8(c);
+		for (; end - begin >= 32; begin += 32)
+		{
+			__m256i	 chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(begin));
+			__m256i	 found = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(chunk, first), _mm256_cmpeq_epi8(chunk, second)),
+							 _mm256_cmpeq_epi8(chunk, third));
+			uint32_t mask  = static_cast<uint32_t>(_mm256_movemask_epi8(found));
+			if (mask != 0)
+			{
+				return begin + std::countr_zero(mask);
+			}
+		}
+#elif defined(LUCO_SSE2)
+		const __m128i first  = _mm_set1_epi8(a);
+		const __m128i second = _mm_set1_epi8(b);
+		const __m128i third  = _mm_set1_epi8(c);
+		for (; end - begin >= 16; begin += 16)
+		{
+			__m128i	 chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(begin));
+			__m128i	 found = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(chunk, first), _mm_cmpeq_epi8(chunk, second)),
+						      _mm_cmpeq_epi8(chunk, third));
+			uint32_t mask  = static_cast<uint32_t>(_mm_movemask_epi8(found));
+			if (mask != 0)
+			{
+				return begin + std::countr_zero(mask);
+			}
+		}
+#endif
+		while (begin != end && *begin != a && *begin != b && *begin != c)
+		{
+			begin++;
+		}
+
+		return begin;
+	}
+
+	inline const char* simd::find_invalid_utf8(const char* begin, const char* end) noexcept
+	{
+		while (begin != end)
+		{
+			// ASCII is skipped a vector or a word at a time, only the multi-byte sequences are decoded
+#if defined(__AVX2__)
+			for (; end - begin >= 32; begin += 32)
+			{
+				__m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(begin));
+				if (_mm256_movemask_epi8(chunk) != 0)
+				{
+					break;
+				}
+			}
+#elif defined(LUCO_SSE2)
+			for (; end - begin >= 16; begin += 16)
+			{
+				__m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(begin));
+				if (_mm_movemask_epi8(chunk) != 0)
+				{
+					break;
+				}
+			}
+#endif
+			for (; end - begin >= 8; begin += 8)
+			{
+				uint64_t word;
+				std::memcpy(&word, begin, sizeof(word));
+				if ((word & 0x8080808080808080) != 0)
+				{
+					break;
+				}
+			}
+
+			while (begin != end && static_cast<unsigned char>(*begin) < 0x80)
+			{
+				begin++;
+			}
+			if (begin == end)
+			{
+				break;
+			}
+
+			const unsigned char lead = static_cast<unsigned char>(*begin);
+			size_t		    size = 0;
+			if ((lead & 0xE0) == 0xC0)
+			{
+				size = 2;
+			}
+			else if ((lead & 0xF0) == 0xE0)
+			{
+				size = 3;
+			}
+			else if ((lead & 0xF8) == 0xF0)
+			{
+				size = 4;
+			}
+			else
+			{
+				return begin;
+			}
+
+			if (static_cast<size_t>(end - begin) < size)
+			{
+				return begin;
+			}
+
+			uint32_t code_point = lead & (0x7F >> size);
+			for (size_t i = 1; i < size; i++)
+			{
+				const unsigned char next = static_cast<unsigned char>(begin[i]);
+				if ((next & 0xC0) != 0x80)
+				{
+					return begin;
+				}
+				code_point = (code_point << 6) | (next & 0x3F);
+			}
+
+			constexpr uint32_t smallest[] = {0, 0, 0x80, 0x800, 0x10000};
+			if (code_point < smallest[size] || code_point > 0x10FFFF || (code_point >= 0xD800 && code_point <= 0xDFFF))
+			{
+				return begin;
+			}
+
+			begin += size;
+		}
+
+		return end;
+	}
+}
@@ -0,0 +1,931 @@
+/*
+ * Copyright: 2025 nodeluna
+ * SPDX-License-Identifier: Apache-2.0
+ * repository: https://github.com/nodeluna/luco
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+#include "api.hpp"
+#include "scanner.hpp"
+#include "expected.hpp"
+#include "error.hpp"
+
+/**
+ * @brief the namespace for luco
+ */
+namespace luco
+{
+	/**
+	 * @struct static_entry
+	 * @brief one node of a luco::static_document. the nodes are stored flat, every object or array has its children
+	 * next to each other and the members of an object are sorted by key. offsets are used instead of pointers so
+	 * that a table can be copied anywhere
+	 */
+	struct static_entry {
+			node_type  type	    = node_type::object;
+			value_type value    = value_type::none;
+			uint32_t   key	    = 0; // the offset of the key in the characters, for the members of an object
+			uint32_t   key_size = 0;
+			uint32_t   first    = 0; // the first child of an object or array, or the offset of a string
+			uint32_t   size	    = 0; // the number of children, or the size of a string
+			int64_t	   integer  = 0; // an integer, or 1 and 0 for a boolean
+			double	   number   = 0;
+	};
+
+	/**
+	 * @class static_node
+	 * @brief a read-only view of a node of a luco::static_document, usable in constant expressions
+	 * @detail @cpp
+	 * using namespace luco::literals;
+	 * constexpr luco::static_node defaults = "server {\n\tport = 8080\n}\n"_luco;
+	 * static_assert(defaults.at("server").at("port").as_integer() == 8080);
+	 * @ecpp
+	 */
+	class static_node {
+		private:
+			const static_entry* _entries = nullptr;
+			const char*	    _chars   = nullptr;
+			uint32_t	    _at	     = 0;
+
+			constexpr const static_entry& entry() const noexcept;
+
+		public:
+			/**
+			 * @class iterator
+			 * @brief iterates over the children of an object or array, in key order for objects
+			 */
+			class iterator {
+				private:
+					const static_entry* _entries = nullptr;
+					const char*	    _chars   = nullptr;
+					uint32_t	    _at	     = 0;
+
+				public:
+					constexpr iterator(const static_entry* entries, const char* chars, uint32_t at) noexcept;
+					constexpr static_node operator*() const noexcept;
+					constexpr iterator&   operator++() noexcept;
+					constexpr bool	      operator==(const iterator& other) const noexcept;
+			};
+
+			/**
+			 * @brief constructor for luco::static_node
+			 * @param entries the table of a static document, the root is its first entry
+			 * @param chars the characters of its keys and strings
+			 * @param at the index of the node in the table
+			 */
+			constexpr static_node(const static_entry* entries, const char* chars, uint32_t at = 0) noexcept;
+
+			constexpr node_type type() const noexcept;
+			constexpr bool	    is_object() const noexcept;
+			constexpr bool	    is_array() const noexcept;
+			constexpr bool	    is_value() const noexcept;
+			constexpr bool	    is_string() const noexcept;
+			constexpr bool	    is_integer() const noexcept;
+			constexpr bool	    is_double() const noexcept;
+			constexpr bool	    is_number() const noexcept;
+			constexpr bool	    is_boolean() const noexcept;
+			constexpr bool	    is_null() const noexcept;
+
+			/**
+			 * @return the number of children of an object or array, 0 for a value
+			 */
+			constexpr size_t size() const noexcept;
+
+			/**
+			 * @return the key of a member of an object, empty otherwise
+			 */
+			constexpr std::string_view key() const noexcept;
+
+			/**
+			 * @return whether an object has a key
+			 */
+			constexpr bool contains(std::string_view key) const noexcept;
+
+			/**
+			 * @brief finds a key of an object with a binary search
+			 * @throws luco::error if it isn't an object or doesn't have the key, which fails to compile in a
+			 * constant expression
+			 */
+			constexpr static_node at(std::string_view key) const;
+
+			/**
+			 * @brief finds a key known at compile time, like node::at<"key">()
+			 */
+			template<fixed_string key>
+			constexpr static_node at() const;
+
+			/**
+			 * @throws luco::error if it isn't an array or the index is out of its range
+			 */
+			constexpr static_node at(size_t index) const;
+
+			/**
+			 * @throws luco::error if the node doesn't hold the type
+			 */
+			constexpr std::string_view as_string() const;
+			constexpr int64_t	   as_integer() const;
+			constexpr double	   as_double() const;
+			constexpr double	   as_number() const;
+			constexpr bool		   as_boolean() const;
+
+			constexpr iterator begin() const noexcept;
+			constexpr iterator end() const noexcept;
+
+			/**
+			 * @brief copies the node and everything in it into a luco::node
+			 * @detail the keys of an object are inserted sorted as they're stored, so with LUCO_ORDERED_OBJECTS the
+			 * copy doesn't keep the order of the source
+			 */
+			inline luco::node to_node() const;
+	};
+
+	/**
+	 * @brief reports what's wrong with the text of a static document. it isn't constexpr, so reaching it while
+	 * parsing at compile time is a compile error that points at the reason
+	 */
+	inline void static_document_error(const char* why)
+	{
+		raise_error(error(error_type::parsing_error, why));
+	}
+
+	/**
+	 * @struct static_parsing
+	 * @brief parses a luco text into the table of a luco::static_document with luco::scanner. at compile time an
+	 * error is a compile error, at runtime it's kept in failure
+	 */
+	struct static_parsing {
+			std::vector<static_entry> entries = std::vector<static_entry>(1);
+			std::string		  chars;
+			const char*		  failure = nullptr;
+
+			constexpr bool fail(const char* why);
+			constexpr bool store(std::string_view text, uint32_t& offset);
+			constexpr bool to_double(const std::string& raw, double& number);
+			constexpr bool type_value(static_entry& entry, const std::string& raw, bool quoted);
+			constexpr bool read_block(const luco::scanner& scanner, size_t opening, static_entry& at, std::vector<static_entry>& table,
+						  size_t& end);
+
+			/**
+			 * @return false if the text isn't a valid static document, the reason is in failure
+			 */
+			constexpr bool parse(std::string_view text);
+	};
+
+	/**
+	 * @class static_document
+	 * @brief a luco text parsed at compile time into a constant table, so reading it needs no parsing or allocation
+	 * at runtime. syntax errors are compile errors
+	 * @detail @cpp
+	 * using defaults = luco::static_document<"server {\n\tport = 8080\n}\n">;
+	 * static_assert(defaults::root().at("server").at("port").as_integer() == 8080);
+	 * @ecpp
+	 * the values are typed like parser::parse() types them. @include isn't supported and keys can't be repeated.
+	 * the text is parsed in one constant evaluation, which compilers bound: with gcc's default
+	 * -fconstexpr-ops-limit a text of about 20 KB compiles, a larger one needs a higher limit (or clang's
+	 * -fconstexpr-steps) or luco::embed
+	 */
+	template<fixed_string text>
+	class static_document {
+		private:
+			// the text is parsed once into tables as large as it could need, every entry takes at least one
+			// character of it and the stored keys and strings are never longer than their text. only the used part
+			// is kept in _image
+			struct parsed_image {
+					static_entry entries[text.view().size() + 1];
+					char	     chars[text.view().size() + 1];
+					size_t	     entry_count = 0;
+					size_t	     char_count	 = 0;
+			};
+
+			static constexpr parsed_image _parsed = []()
+			{
+				static_parsing parsing;
+				parsing.parse(text.view());
+
+				parsed_image built{};
+				std::copy(parsing.entries.begin(), parsing.entries.end(), built.entries);
+				std::copy(parsing.chars.begin(), parsing.chars.end(), built.chars);
+				built.entry_count = parsing.entries.size();
+				built.char_count  = parsing.chars.size();
+				return built;
+			}();
+
+			struct image {
+					static_entry entries[_parsed.entry_count];
+					char	     chars[_parsed.char_count + 1];
+			};
+
+			static constexpr image _image = []()
+			{
+				image built{};
+				std::copy_n(_parsed.entries, _parsed.entry_count, built.entries);
+				std::copy_n(_parsed.chars, _parsed.char_count, built.chars);
+				return built;
+			}();
+
+		public:
+			/**
+			 * @return the root object
+			 */
+			static constexpr static_node root() noexcept
+			{
+				return static_node(_image.entries, _image.chars);
+			}
+	};
+
+	/**
+	 * @brief the namespace of luco's literal operators
+	 */
+	namespace literals
+	{
+		/**
+		 * @brief parses a luco text at compile time
+		 * @return the root object of a luco::static_document
+		 */
+		template<fixed_string text>
+		consteval static_node operator""_luco() noexcept
+		{
+			return static_document<text>::root();
+		}
+	}
+}
+
+namespace luco
+{
+	constexpr static_node::iterator::iterator(const static_entry* entries, const char* chars, uint32_t at) noexcept
+	    : _entries(entries), _chars(chars), _at(at)
+	{
+	}
+
+	constexpr static_node static_node::iterator::operator*() const noexcept
+	{
+		return static_node(_entries, _chars, _at);
+	}
+
+	constexpr static_node::iterator& static_node::iterator::operator++() noexcept
+	{
+		_at++;
+		return *this;
+	}
+
+	constexpr bool static_node::iterator::operator==(const iterator& other) const noexcept
+	{
+		return _entries == other._entries && _at == other._at;
+	}
+
+	constexpr static_node::static_node(const static_entry* entries, const char* chars, uint32_t at) noexcept
+	    : _entries(entries), _chars(chars), _at(at)
+	{
+	}
+
+	constexpr const static_entry& static_node::entry() const noexcept
+	{
+		return _entries[_at];
+	}
+
+	constexpr node_type static_node::type() const noexcept
+	{
+		return this->entry().type;
+	}
+
+	constexpr bool static_node::is_object() const noexcept
+	{
+		return this->entry().type == node_type::object;
+	}
+
+	constexpr bool static_node::is_array() const noexcept
+	{
+		return this->entry().type == node_type::array;
+	}
+
+	constexpr bool static_node::is_value() const noexcept
+	{
+		return this->entry().type == node_type::value;
+	}
+
+	constexpr bool static_node::is_string() const noexcept
+	{
+		return this->is_value() && this->entry().value == value_type::string;
+	}
+
+	constexpr bool static_node::is_integer() const noexcept
+	{
+		return this->is_value() && this->entry().value == value_type::integer;
+	}
+
+	constexpr bool static_node::is_double() const noexcept
+	{
+		return this->is_value() && this->entry().value == value_type::double_t;
+	}
+
+	constexpr bool static_node::is_number() const noexcept
+	{
+		return this->is_integer() || this->is_double();
+	}
+
+	constexpr bool static_node::is_boolean() const noexcept
+	{
+		return this->is_value() && this->entry().value == value_type::boolean;
+	}
+
+	constexpr bool static_node::is_null() const noexcept
+	{
+		return this->is_value() && this->entry().value == value_type::null;
+	}
+
+	constexpr size_t static_node::size() const noexcept
+	{
+		return this->is_value() ? 0 : this->entry().size;
+	}
+
+	constexpr std::string_view static_node::key() const noexcept
+	{
+		return std::string_view(_chars + this->entry().key, this->entry().key_size);
+	}
+
+	constexpr bool static_node::contains(std::string_view key) const noexcept
+	{
+		if (not this->is_object())
+		{
+			return false;
+		}
+
+		uint32_t low  = this->entry().first;
+		uint32_t high = low + this->entry().size;
+		while (low < high)
+		{
+			uint32_t middle = low + (high - low) / 2;
+			auto	 found	= static_node(_entries, _chars, middle).key();
+			if (found == key)
+			{
+				return true;
+			}
+			(found < key ? low = middle + 1 : high = middle);
+		}
+
+		return false;
+	}
+
+	constexpr static_node static_node::at(std::string_view key) const
+	{
+		if (not this->is_object())
+		{
+			raise_error(
+			    error(error_type::wrong_type, "wrong type: trying to find the key '{}' in something that isn't an object", key));
+		}
+
+		uint32_t low  = this->entry().first;
+		uint32_t high = low + this->entry().size;
+		while (low < high)
+		{
+			uint32_t middle = low + (high - low) / 2;
+			auto	 found	= static_node(_entries, _chars, middle).key();
+			if (found == key)
+			{
+				return static_node(_entries, _chars, middle);
+			}
+			(found < key ? low = middle + 1 : high = middle);
+		}
+
+		raise_error(error::key_not_found(key));
+	}
+
+	template<fixed_string key>
+	constexpr static_node static_node::at() const
+	{
+		return this->at(key.view());
+	}
+
+	constexpr static_node static_node::at(size_t index) const
+	{
+		if (not this->is_array())
+		{
+			raise_error(error(error_type::wrong_type, "wrong type: trying to index something that isn't an array"));
+		}
+		else if (index >= this->entry().size)
+		{
+			raise_error(error::index_not_found(index));
+		}
+
+		return static_node(_entries, _chars, this->entry().first + static_cast<uint32_t>(index));
+	}
+
+	constexpr std::string_view static_node::as_string() const
+	{
+		if (not this->is_string())
+		{
+			raise_error(error(error_type::wrong_type, "wrong type: the node isn't a string"));
+		}
+
+		return std::string_view(_chars + this->entry().first, this->entry().size);
+	}
+
+	constexpr int64_t static_node::as_integer() const
+	{
+		if (not this->is_integer())
+		{
+			raise_error(error(error_type::wrong_type, "wrong type: the node isn't an integer"));
+		}
+
+		return this->entry().integer;
+	}
+
+	constexpr double static_node::as_double() const
+	{
+		if (not this->is_double())
+		{
+			raise_error(error(error_type::wrong_type, "wrong type: the node isn't a double"));
+		}
+
+		return this->entry().number;
+	}
+
+	constexpr double static_node::as_number() const
+	{
+		if (not this->is_number())
+		{
+			raise_error(error(error_type::wrong_type, "wrong type: the node isn't a number"));
+		}
+
+		return this->is_integer() ? static_cast<double>(this->entry().integer) : this->entry().number;
+	}
+
+	constexpr bool static_node::as_boolean() const
+	{
+		if (not this->is_boolean())
+		{
+			raise_error(error(error_type::wrong_type, "wrong type: the node isn't a boolean"));
+		}
+
+		return this->entry().integer != 0;
+	}
+
+	constexpr static_node::iterator static_node::begin() const noexcept
+	{
+		return iterator(_entries, _chars, this->entry().first);
+	}
+
+	constexpr static_node::iterator static_node::end() const noexcept
+	{
+		return iterator(_entries, _chars, this->entry().first + static_cast<uint32_t>(this->size()));
+	}
+
+	inline luco::node static_node::to_node() const
+	{
+		switch (this->type())
+		{
+			case node_type::object:
+			{
+				luco::node object(node_type::object);
+				for (static_node member : *this)
+				{
+					object.insert(std::string(member.key()), member.to_node());
+				}
+				return object;
+			}
+			case node_type::array:
+			{
+				luco::node array(node_type::array);
+				for (static_node element : *this)
+				{
+					array.push_back(element.to_node());
+				}
+				return array;
+			}
+			case node_type::value:
+				break;
+		}
+
+		if (this->is_string())
+		{
+			return luco::node(std::string(this->as_string()));
+		}
+		else if (this->is_integer())
+		{
+			return luco::node(this->as_integer());
+		}
+		else if (this->is_double())
+		{
+			return luco::node(this->as_double());
+		}
+		else if (this->is_boolean())
+		{
+			return luco::node(this->as_boolean());
+		}
+
+		return luco::node(null_type());
+	}
+
+	constexpr bool static_parsing::fail(const char* why)
+	{
+		if (std::is_constant_evaluated())
+		{
+			static_document_error(why);
+		}
+
+		failure = why;
+		return false;
+	}
+
+	constexpr bool static_parsing::store(std::string_view text, uint32_t& offset)
+	{
+		if (chars.size() + text.size() > std::numeric_limits<uint32_t>::max())
+		{
+			return this->fail("the text of a static document can't be larger than 4 GiB");
+		}
+
+		offset = static_cast<uint32_t>(chars.size());
+		chars.append(text);
+
+		return true;
+	}
+
+	constexpr bool static_parsing::type_value(static_entry& entry, const std::string& raw, bool quoted)
+	{
+		entry.type = node_type::value;
+		if (not quoted && raw.starts_with("@include"))
+		{
+			return this->fail("@include isn't supported in a static document");
+		}
+
+		// the same deduction as parser::parse(), quoted or not
+		size_t digits = 0;
+		size_t dots   = 0;
+		for (char c : raw)
+		{
+			(c == '.' ? dots : digits) += c == '.' || (c >= '0' && c <= '9');
+		}
+
+		if (raw == "null")
+		{
+			entry.value = value_type::null;
+		}
+		else if (not raw.empty() && digits + dots == raw.size() && dots <= 1)
+		{
+			if (digits == 0)
+			{
+				return this->fail("'.' isn't a number");
+			}
+
+			if (dots != 0)
+			{
+				entry.value = value_type::double_t;
+				return this->to_double(raw, entry.number);
+			}
+
+			uint64_t mantissa = 0;
+			for (char c : raw)
+			{
+				if (mantissa > (std::numeric_limits<uint64_t>::max() - 9) / 10)
+				{
+					return this->fail("an integer of a static document is out of the range of int64_t");
+				}
+				mantissa = mantissa * 10 + static_cast<uint64_t>(c - '0');
+			}
+
+			if (mantissa > static_cast<uint64_t>(std::numeric_limits<int64_t>::max()))
+			{
+				return this->fail("an integer of a static document is out of the range of int64_t");
+			}
+			entry.value   = value_type::integer;
+			entry.integer = static_cast<int64_t>(mantissa);
+		}
+		else if (raw == "true" || raw == "on" || raw == "false" || raw == "off")
+		{
+			entry.value   = value_type::boolean;
+			entry.integer = raw == "true" || raw == "on";
+		}
+		else
+		{
+			entry.value = value_type::string;
+		}
+
+		return true;
+	}
+
+	constexpr bool static_parsing::to_double(const std::string& raw, double& number)
+	{
+		// std::from_chars() isn't constexpr for doubles. the value is digits / 10^exponent, rounded once to the
+		// nearest double like std::from_chars() rounds it
+		std::string digits;
+		size_t	    exponent = 0;
+		bool	    fraction = false;
+		for (char c : raw)
+		{
+			if (c == '.')
+			{
+				fraction = true;
+				continue;
+			}
+			exponent += fraction;
+			if (c != '0' || not digits.empty())
+			{
+				digits += c;
+			}
+		}
+		for (; exponent != 0 && not digits.empty() && digits.back() == '0'; exponent--)
+		{
+			digits.pop_back();
+		}
+
+		if (digits.empty())
+		{
+			number = 0;
+			return true;
+		}
+		else if (digits.size() <= 15 && exponent <= 22)
+		{
+			// both are exact doubles, so the division is the only rounding
+			uint64_t mantissa = 0;
+			double	 scale	  = 1;
+			for (char c : digits)
+			{
+				mantissa = mantissa * 10 + static_cast<uint64_t>(c - '0');
+			}
+			for (size_t i = 0; i < exponent; i++)
+			{
+				scale *= 10;
+			}
+			number = static_cast<double>(mantissa) / scale;
+			return true;
+		}
+
+		// otherwise digits and 10^exponent become big integers and the 53 bits of the quotient are divided out of them
+		using big_integer = std::vector<uint32_t>;
+		auto multiply_add = [](big_integer& n, uint32_t factor, uint32_t add)
+		{
+			uint64_t carry = add;
+			for (uint32_t& limb : n)
+			{
+				carry += static_cast<uint64_t>(limb) * factor;
+				limb  = static_cast<uint32_t>(carry);
+				carry >>= 32;
+			}
+			if (carry != 0)
+			{
+				n.push_back(static_cast<uint32_t>(carry));
+			}
+		};
+		auto bits = [](const big_integer& n) -> int64_t
+		{ return n.empty() ? 0 : static_cast<int64_t>(n.size() - 1) * 32 + std::bit_width(n.back()); };
+		auto shifted = [](const big_integer& n, int64_t shift)
+		{
+			big_integer out(static_cast<size_t>(shift / 32), 0);
+			uint32_t    carry = 0;
+			for (uint32_t limb : n)
+			{
+				out.push_back(shift % 32 == 0 ? limb : (limb << (shift % 32)) | carry);
+				carry = shift % 32 == 0 ? 0 : limb >> (32 - shift % 32);
+			}
+			if (carry != 0)
+			{
+				out.push_back(carry);
+			}
+			return out;
+		};
+		auto compare = [](const big_integer& a, const big_integer& b)
+		{
+			if (a.size() != b.size())
+			{
+				return a.size() < b.size() ? -1 : 1;
+			}
+			for (size_t i = a.size(); i-- > 0;)
+			{
+				if (a[i] != b[i])
+				{
+					return a[i] < b[i] ? -1 : 1;
+				}
+			}
+			return 0;
+		};
+		auto subtract = [](big_integer& a, const big_integer& b)
+		{
+			int64_t borrow = 0;
+			for (size_t i = 0; i < a.size(); i++)
+			{
+				int64_t limb = static_cast<int64_t>(a[i]) - borrow - (i < b.size() ? static_cast<int64_t>(b[i]) : 0);
+				borrow	     = limb < 0;
+				a[i]	     = static_cast<uint32_t>(limb + (borrow << 32));
+			}
+			while (not a.empty() && a.back() == 0)
+			{
+				a.pop_back();
+			}
+		};
+
+		big_integer numerator;
+		big_integer denominator = {1};
+		for (char c : digits)
+		{
+			multiply_add(numerator, 10, static_cast<uint32_t>(c - '0'));
+		}
+		for (size_t i = 0; i < exponent; i++)
+		{
+			multiply_add(denominator, 10, 0);
+		}
+
+		// the quotient is numerator * 2^shift / denominator, 53 bits long unless the value is subnormal
+		int64_t	 shift	  = 53 - (bits(numerator) - bits(denominator));
+		uint64_t quotient = 0;
+		for (bool again = true; again;)
+		{
+			shift		    = std::min<int64_t>(shift, 1074);
+			big_integer dividend = numerator;
+			big_integer divisor  = denominator;
+			// not a conditional expression of the two, gcc 12 frees its temporary twice in a constant expression
+			if (shift > 0)
+			{
+				dividend = shifted(numerator, shift);
+			}
+			else if (shift < 0)
+			{
+				divisor = shifted(denominator, -shift);
+			}
+			quotient = 0;
+			for (int bit = 54; bit >= 0; bit--)
+			{
+				big_integer part = shifted(divisor, bit);
+				if (compare(dividend, part) >= 0)
+				{
+					subtract(dividend, part);
+					quotient |= uint64_t(1) << bit;
+				}
+			}
+
+			again = quotient >= uint64_t(1) << 53;
+			shift -= again;
+			if (not again)
+			{
+				// to nearest, ties to even
+				int half = compare(shifted(dividend, 1), divisor);
+				quotient += half > 0 || (half == 0 && (quotient & 1) != 0);
+			}
+		}
+
+		if (quotient == uint64_t(1) << 53)
+		{
+			quotient >>= 1;
+			shift--;
+		}
+		if (quotient == 0 || 52 - shift > 1023)
+		{
+			return this->fail("a double of a static document is out of the range of double");
+		}
+
+		number = static_cast<double>(quotient);
+		for (; shift > 0; shift--)
+		{
+			number /= 2;
+		}
+		for (; shift < 0; shift++)
+		{
+			number *= 2;
+		}
+
+		return true;
+	}
+
+	constexpr bool static_parsing::read_block(const luco::scanner& scanner, size_t opening, static_entry& at,
+						  std::vector<static_entry>& table, size_t& end)
+	{
+		// the block is read in one pass: the children of a nested block are read as they're met instead of being
+		// skipped and scanned again, and are moved behind the children of this one once their number is known. the
+		// indices of a table are relative to its start until then
+		const bool		  top	 = opening == scanner::incomplete;
+		bool			  object = true;
+		std::vector<static_entry> children;
+		std::vector<static_entry> descendants;
+		auto			  relocate = [](std::vector<static_entry>& entries, size_t from, size_t offset)
+		{
+			for (size_t i = from; i < entries.size(); i++)
+			{
+				entries[i].first += entries[i].type == node_type::value ? 0 : static_cast<uint32_t>(offset);
+			}
+		};
+
+		for (size_t pos = top ? 0 : opening + 1;;)
+		{
+			scanner::item item = scanner.next_item(pos, false);
+			if (item.end == scanner::incomplete || (item.kind == scanner::item_kind::end && not top))
+			{
+				return this->fail("a '{' isn't closed before the end of the text");
+			}
+			else if (item.kind == scanner::item_kind::close && top)
+			{
+				return this->fail("found '}' without being in an [object] or [array]");
+			}
+			else if (item.kind == scanner::item_kind::end || item.kind == scanner::item_kind::close)
+			{
+				end = item.end;
+				break;
+			}
+
+			const bool keyed = item.kind == scanner::item_kind::key_value || item.kind == scanner::item_kind::key_block;
+			object		 = children.empty() ? keyed : object;
+			if (keyed != object)
+			{
+				return this->fail("an object or array mixes keys with elements");
+			}
+			else if (top && not object)
+			{
+				return this->fail("expected 'key' in the [global object]");
+			}
+
+			static_entry child;
+			if (object)
+			{
+				std::string key = scanner.key(item);
+				child.key_size	= static_cast<uint32_t>(key.size());
+				if (not this->store(key, child.key))
+				{
+					return false;
+				}
+			}
+
+			if (item.kind == scanner::item_kind::key_value || item.kind == scanner::item_kind::value)
+			{
+				bool	    quoted = false;
+				std::string raw	   = scanner.value(item, quoted);
+				if (not this->type_value(child, raw, quoted))
+				{
+					return false;
+				}
+				else if (child.value == value_type::string)
+				{
+					child.size = static_cast<uint32_t>(raw.size());
+					if (not this->store(raw, child.first))
+					{
+						return false;
+					}
+				}
+				pos = item.end;
+			}
+			else
+			{
+				const size_t		  before = descendants.size();
+				std::vector<static_entry> nested;
+				if (not this->read_block(scanner, item.block, child, nested, pos))
+				{
+					return false;
+				}
+				descendants.insert(descendants.end(), nested.begin(), nested.end());
+				relocate(descendants, before, before);
+				child.first += static_cast<uint32_t>(before);
+			}
+			children.push_back(child);
+		}
+
+		if (table.size() + children.size() + descendants.size() > std::numeric_limits<uint32_t>::max())
+		{
+			return this->fail("a static document can't have more than 2^32 nodes");
+		}
+
+		at.type	 = object ? node_type::object : node_type::array;
+		at.first = static_cast<uint32_t>(table.size());
+		at.size	 = static_cast<uint32_t>(children.size());
+		const size_t from = table.size();
+		table.insert(table.end(), children.begin(), children.end());
+		table.insert(table.end(), descendants.begin(), descendants.end());
+		relocate(table, from, from + children.size());
+
+		if (object)
+		{
+			auto key_of = [this](const static_entry& entry) { return std::string_view(chars).substr(entry.key, entry.key_size); };
+			auto begin  = table.begin() + static_cast<std::ptrdiff_t>(from);
+			auto last   = begin + static_cast<std::ptrdiff_t>(children.size());
+			std::sort(begin, last, [&](const static_entry& a, const static_entry& b) { return key_of(a) < key_of(b); });
+			if (std::adjacent_find(begin, last, [&](const static_entry& a, const static_entry& b) { return key_of(a) == key_of(b); }) !=
+			    last)
+			{
+				return this->fail("a key is repeated in an object of a static document");
+			}
+		}
+
+		return true;
+	}
+
+	constexpr bool static_parsing::parse(std::string_view text)
+	{
+		luco::scanner scanner(text);
+		static_entry  root;
+		size_t	      end = 0;
+		if (not this->read_block(scanner, scanner::incomplete, root, entries, end))
+		{
+			return false;
+		}
+		entries.front() = root;
+
+		return true;
+	}
+}
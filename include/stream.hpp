@@ -0,0 +1,379 @@
+/*
+ * Copyright: 2025 nodeluna
+ * SPDX-License-Identifier: Apache-2.0
+ * repository: https://github.com/nodeluna/luco
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "api.hpp"
+#include "parser.hpp"
+#include "scanner.hpp"
+#include "expected.hpp"
+#include "error.hpp"
+
+/**
+ * @brief the namespace for luco
+ */
+namespace luco
+{
+	/**
+	 * @class chunked_source
+	 * @brief a window over a luco text that is read block by block, text before the window is dropped once it's been
+	 * consumed so memory stays bounded by the largest item plus one block
+	 */
+	class chunked_source {
+		private:
+			std::unique_ptr<std::ifstream> _file;
+			std::string		       _buffer;
+			std::string_view	       _text;
+			size_t			       _line	= 1;
+			size_t			       _column	= 1;
+			size_t			       _counted = 0;
+			bool			       _eof	= true;
+
+		public:
+			static constexpr size_t block_size = 1 << 16;
+
+			/**
+			 * @brief reads the file block by block
+			 */
+			inline explicit chunked_source(std::unique_ptr<std::ifstream> file);
+
+			/**
+			 * @brief uses the whole string as the window, it isn't copied
+			 */
+			inline explicit chunked_source(std::string_view text) noexcept;
+
+			/**
+			 * @return the text currently in the window
+			 */
+			inline std::string_view text() const noexcept;
+
+			/**
+			 * @return whether the window reaches the end of the text
+			 */
+			inline bool eof() const noexcept;
+
+			/**
+			 * @brief drops the text before pos and appends the next block. a block is at least as big as the text
+			 * kept, so an item spanning many blocks is scanned again a bounded number of times
+			 * @param pos a position in the window, the window starts there afterwards
+			 * @return false if the text ended already
+			 */
+			inline bool read_more(size_t& pos);
+
+			/**
+			 * @return the line number of a position in the window
+			 */
+			inline size_t line_at(size_t pos) noexcept;
+
+			/**
+			 * @return the column of the first character in the window
+			 */
+			inline size_t column() const noexcept;
+	};
+}
+
+namespace luco
+{
+	inline chunked_source::chunked_source(std::unique_ptr<std::ifstream> file) : _file(std::move(file)), _eof(false)
+	{
+	}
+
+	inline chunked_source::chunked_source(std::string_view text) noexcept : _text(text)
+	{
+	}
+
+	inline std::string_view chunked_source::text() const noexcept
+	{
+		return _text;
+	}
+
+	inline bool chunked_source::eof() const noexcept
+	{
+		return _eof;
+	}
+
+	inline bool chunked_source::read_more(size_t& pos)
+	{
+		if (_eof)
+		{
+			return false;
+		}
+
+		this->line_at(pos);
+		size_t newline = _text.substr(0, pos).rfind('\n');
+		_column	       = newline == std::string_view::npos ? _column + pos : pos - newline;
+		_buffer.erase(0, pos);
+		_counted = 0;
+		pos	 = 0;
+
+		size_t size = _buffer.size();
+		size_t read = std::max(block_size, size);
+		_buffer.resize(size + read);
+		_file->read(_buffer.data() + size, static_cast<std::streamsize>(read));
+		_buffer.resize(size + static_cast<size_t>(_file->gcount()));
+		_eof  = not *_file;
+		_text = _buffer;
+
+		return true;
+	}
+
+	inline size_t chunked_source::line_at(size_t pos) noexcept
+	{
+		if (pos >= _counted)
+		{
+			_line += std::count(_text.begin() + _counted, _text.begin() + pos, '\n');
+		}
+		else
+		{
+			_line -= std::count(_text.begin() + pos, _text.begin() + _counted, '\n');
+		}
+		_counted = pos;
+
+		return _line;
+	}
+
+	inline size_t chunked_source::column() const noexcept
+	{
+		return _column;
+	}
+
+	inline expected<monostate, error> parser::stream_array_from(chunked_source& source, const std::vector<std::string>& key_path,
+							       const std::function<bool(luco::node&)>& consumer) noexcept
+	{
+		if (key_path.empty())
+		{
+			return unexpected(error(error_type::key_not_found, "the key path of the streamed array is empty"));
+		}
+
+		size_t pos   = 0;
+		size_t depth = 0;
+		auto   not_closed_at_line = [](size_t line)
+		{ return unexpected(error(error_type::parsing_error, "line {}: '{{' isn't closed before the end of the text", line)); };
+		auto not_closed = [&](size_t at) { return not_closed_at_line(source.line_at(at)); };
+
+		// skips a block spanning any number of refills, dropping what it skipped so only the current item is in
+		// memory. the scan continues from where the previous window ended
+		auto skip_sibling = [&](size_t block) -> expected<size_t, error>
+		{
+			size_t line	 = source.line_at(block);
+			size_t brackets	 = 0;
+			size_t resume_at = block;
+			size_t end	 = luco::scanner(source.text(), source.eof()).skip_block(block, brackets, resume_at);
+			while (end == scanner::incomplete)
+			{
+				if (not source.read_more(resume_at))
+				{
+					return not_closed_at_line(line);
+				}
+				end = luco::scanner(source.text(), source.eof()).skip_block(resume_at, brackets, resume_at);
+			}
+			return end;
+		};
+
+		// descends to the array one key at a time, skipping everything around it
+		while (depth < key_path.size())
+		{
+			luco::scanner	    scanner(source.text(), source.eof());
+			luco::scanner::item item = scanner.next_item(pos, false);
+			if (item.end == scanner::incomplete)
+			{
+				if (not source.read_more(pos))
+				{
+					return not_closed(item.begin);
+				}
+				continue;
+			}
+
+			switch (item.kind)
+			{
+				case scanner::item_kind::end:
+					if (depth != 0)
+					{
+						return not_closed(item.begin);
+					}
+					return unexpected(error(error_type::key_not_found, "key '{}' wasn't found", key_path[depth]));
+				case scanner::item_kind::close:
+					if (depth == 0)
+					{
+						return unexpected(error(error_type::parsing_error,
+									"line {}: found '}}' without being in an [object] or [array]",
+									source.line_at(item.begin)));
+					}
+					return unexpected(error(error_type::key_not_found, "key '{}' wasn't found", key_path[depth]));
+				case scanner::item_kind::value:
+				case scanner::item_kind::block:
+					return unexpected(error(error_type::wrong_type, "line {}: key '{}' is inside of an array",
+								source.line_at(item.begin), key_path[depth]));
+				case scanner::item_kind::key_value:
+				case scanner::item_kind::key_block:
+					if (scanner.key(item) != key_path[depth] && item.kind == scanner::item_kind::key_block)
+					{
+						expected<size_t, error> end = skip_sibling(item.block);
+						if (not end)
+						{
+							return unexpected(end.error());
+						}
+						pos = end.value();
+					}
+					else if (scanner.key(item) != key_path[depth])
+					{
+						pos = item.end;
+					}
+					else if (item.kind == scanner::item_kind::key_block)
+					{
+						pos = item.block + 1;
+						depth++;
+					}
+					else
+					{
+						return unexpected(error(error_type::wrong_type, "line {}: key '{}' isn't an array",
+									source.line_at(item.begin), key_path[depth]));
+					}
+					break;
+			}
+		}
+
+		// every element is parsed on its own as the only element of a wrapper array
+		while (true)
+		{
+			luco::scanner	    scanner(source.text(), source.eof());
+			luco::scanner::item item = scanner.next_item(pos);
+			if (item.end == scanner::incomplete)
+			{
+				if (not source.read_more(pos))
+				{
+					return not_closed(item.begin);
+				}
+				continue;
+			}
+
+			// an element that doesn't move past pos, or that a continuation at the end of the text cuts short,
+			// would be read again and again
+			if ((item.kind == scanner::item_kind::value || item.kind == scanner::item_kind::block) && item.end <= pos)
+			{
+				return unexpected(error(error_type::parsing_error, "line {}: the text can't be read past this point",
+							source.line_at(item.begin)));
+			}
+			else if (item.kind == scanner::item_kind::value && item.end == source.text().size() && scanner.continued(item))
+			{
+				return unexpected(error(error_type::parsing_error, "line {}: a '\\' line continuation reaches the end of the text",
+							source.line_at(item.begin)));
+			}
+
+			switch (item.kind)
+			{
+				case scanner::item_kind::end:
+					return not_closed(item.begin);
+				case scanner::item_kind::close:
+					return monostate();
+				case scanner::item_kind::key_value:
+				case scanner::item_kind::key_block:
+					return unexpected(error(error_type::wrong_type, "line {}: key '{}' is an object, not an array",
+								source.line_at(item.begin), key_path.back()));
+				case scanner::item_kind::value:
+				case scanner::item_kind::block:
+					break;
+			}
+
+			std::string element = "k {\n";
+			element.append(source.text().substr(item.begin, item.end - item.begin));
+			element.append("\n}\n");
+
+			struct parsing_data data;
+			data.line_number = source.line_at(item.begin) - 1;
+
+			expected<luco::node, error> wrapper = luco::parser::parse_string(element, data);
+			if (not wrapper)
+			{
+				return unexpected(wrapper.error());
+			}
+
+			auto wrapper_root = wrapper.value().as_object();
+			if (wrapper_root->size() != 1 || not wrapper_root->begin()->second.is_array() ||
+			    wrapper_root->begin()->second.as_array()->size() != 1)
+			{
+				return unexpected(error(error_type::parsing_error, "line {}: invalid array element", source.line_at(item.begin)));
+			}
+			else if (not consumer(wrapper_root->begin()->second.as_array()->front()))
+			{
+				return monostate();
+			}
+
+			pos = item.end;
+		}
+	}
+
+	inline expected<monostate, error> parser::try_stream_array(const std::filesystem::path& path, const std::vector<std::string>& key_path,
+								   const std::function<bool(luco::node&)>& consumer) noexcept
+	{
+		std::unique_ptr<std::ifstream> file = std::make_unique<std::ifstream>(path, std::ios::binary);
+		if (not file->is_open())
+		{
+			return unexpected(luco::error(error_type::filesystem_error,
+						      std::format("couldn't open '{}', {}", path.string(), std::strerror(errno))));
+		}
+
+		chunked_source source(std::move(file));
+		return luco::parser::stream_array_from(source, key_path, consumer);
+	}
+
+	inline expected<monostate, error> parser::try_stream_array(const std::string& raw_json, const std::vector<std::string>& key_path,
+								   const std::function<bool(luco::node&)>& consumer) noexcept
+	{
+		chunked_source source{std::string_view(raw_json)};
+		return luco::parser::stream_array_from(source, key_path, consumer);
+	}
+
+	inline expected<monostate, error> parser::try_stream_array(const char* raw_json, const std::vector<std::string>& key_path,
+								   const std::function<bool(luco::node&)>& consumer) noexcept
+	{
+		assert(raw_json != NULL);
+		chunked_source source{std::string_view(raw_json)};
+		return luco::parser::stream_array_from(source, key_path, consumer);
+	}
+
+	inline void parser::stream_array(const std::filesystem::path& path, const std::vector<std::string>& key_path,
+					 const std::function<bool(luco::node&)>& consumer)
+	{
+		expected<monostate, error> ok = luco::parser::try_stream_array(path, key_path, consumer);
+		if (not ok)
+		{
+			raise_error(ok.error());
+		}
+	}
+
+	inline void parser::stream_array(const std::string& raw_json, const std::vector<std::string>& key_path,
+					 const std::function<bool(luco::node&)>& consumer)
+	{
+		expected<monostate, error> ok = luco::parser::try_stream_array(raw_json, key_path, consumer);
+		if (not ok)
+		{
+			raise_error(ok.error());
+		}
+	}
+
+	inline void parser::stream_array(const char* raw_json, const std::vector<std::string>& key_path,
+					 const std::function<bool(luco::node&)>& consumer)
+	{
+		expected<monostate, error> ok = luco::parser::try_stream_array(raw_json, key_path, consumer);
+		if (not ok)
+		{
+			raise_error(ok.error());
+		}
+	}
+}
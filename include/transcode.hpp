@@ -0,0 +1,728 @@
+/*
+ * Copyright: 2025 nodeluna
+ * SPDX-License-Identifier: Apache-2.0
+ * repository: https://github.com/nodeluna/luco
+ */
+
+#pragma once
+
+#include <cctype>
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+#include "api.hpp"
+#include "parser.hpp"
+#include "scanner.hpp"
+#include "stream.hpp"
+#include "json.hpp"
+#include "simd.hpp"
+#include "expected.hpp"
+#include "error.hpp"
+
+/**
+ * @brief the namespace for luco
+ */
+namespace luco
+{
+	/**
+	 * @class transcoder
+	 * @brief converts luco text to JSON and back in a single pass without building a luco::node tree. the input is
+	 * read block by block and the output is handed to out_func in blocks, so memory is bounded by the nesting depth
+	 * and the largest single value rather than by the size of the document
+	 * @detail the output is laid out like node::dump_to_json() and node::dump_to_luco(), but keys are written in the
+	 * order they appear in the input instead of sorted, and duplicate keys are kept. @include values are written as
+	 * plain strings. keys and values are read the way parser::parse() reads them, and a JSON string the parser couldn't
+	 * read back (like one containing '=' or '}' in a value) is an error instead of broken luco
+	 */
+	class transcoder {
+		public:
+			using output = std::function<void(std::string)>;
+
+		private:
+			struct frame {
+					bool   array;
+					bool   empty;
+					size_t indent;
+			};
+
+			inline static void			 json_string(std::string& out, std::string_view string);
+			inline static expected<std::pair<std::string, luco::node>, error> parse_item(std::string_view text, size_t line,
+												      bool element);
+			inline static size_t			 json_token_end(std::string_view text, size_t pos, bool eof) noexcept;
+			inline static expected<monostate, error> luco_to_json_from(chunked_source& source, const output& out_func,
+										   const std::pair<char, size_t>& indent_conf) noexcept;
+			inline static expected<monostate, error> json_to_luco_from(chunked_source& source, const output& out_func,
+										   const std::pair<char, size_t>& indent_conf) noexcept;
+
+		public:
+			/**
+			 * @brief converts a luco file to JSON
+			 * @param out_func receives the JSON text block by block
+			 * @param indent_conf indentation config for writing {char, size}
+			 * @throw luco::error
+			 */
+			inline static void luco_to_json(const std::filesystem::path& path, const output& out_func,
+							const std::pair<char, size_t>& indent_conf = {' ', 4});
+			inline static void luco_to_json(const std::string& raw_luco, const output& out_func,
+							const std::pair<char, size_t>& indent_conf = {' ', 4});
+			inline static void luco_to_json(const char* raw_luco, const output& out_func,
+							const std::pair<char, size_t>& indent_conf = {' ', 4});
+
+			/**
+			 * @brief converts a luco file to JSON
+			 * @param out_func receives the JSON text block by block
+			 * @param indent_conf indentation config for writing {char, size}
+			 * @return luco::monostate or luco::error. out_func may have received part of the text already
+			 */
+			inline static expected<monostate, error> try_luco_to_json(const std::filesystem::path& path, const output& out_func,
+										  const std::pair<char, size_t>& indent_conf = {' ', 4}) noexcept;
+			inline static expected<monostate, error> try_luco_to_json(const std::string& raw_luco, const output& out_func,
+										  const std::pair<char, size_t>& indent_conf = {' ', 4}) noexcept;
+			inline static expected<monostate, error> try_luco_to_json(const char* raw_luco, const output& out_func,
+										  const std::pair<char, size_t>& indent_conf = {' ', 4}) noexcept;
+
+			/**
+			 * @brief converts a JSON file to luco, the root of the JSON text has to be an object
+			 * @param out_func receives the luco text block by block
+			 * @param indent_conf indentation config for writing {char, size}
+			 * @throw luco::error
+			 */
+			inline static void json_to_luco(const std::filesystem::path& path, const output& out_func,
+							const std::pair<char, size_t>& indent_conf = {' ', 4});
+			inline static void json_to_luco(const std::string& raw_json, const output& out_func,
+							const std::pair<char, size_t>& indent_conf = {' ', 4});
+			inline static void json_to_luco(const char* raw_json, const output& out_func,
+							const std::pair<char, size_t>& indent_conf = {' ', 4});
+
+			/**
+			 * @brief converts a JSON file to luco, the root of the JSON text has to be an object
+			 * @param out_func receives the luco text block by block
+			 * @param indent_conf indentation config for writing {char, size}
+			 * @return luco::monostate or luco::error. out_func may have received part of the text already
+			 */
+			inline static expected<monostate, error> try_json_to_luco(const std::filesystem::path& path, const output& out_func,
+										  const std::pair<char, size_t>& indent_conf = {' ', 4}) noexcept;
+			inline static expected<monostate, error> try_json_to_luco(const std::string& raw_json, const output& out_func,
+										  const std::pair<char, size_t>& indent_conf = {' ', 4}) noexcept;
+			inline static expected<monostate, error> try_json_to_luco(const char* raw_json, const output& out_func,
+										  const std::pair<char, size_t>& indent_conf = {' ', 4}) noexcept;
+	};
+}
+
+namespace luco
+{
+	inline void transcoder::json_string(std::string& out, std::string_view string)
+	{
+		const char* cur = string.data();
+		const char* end = string.data() + string.size();
+
+		out += '"';
+		while (true)
+		{
+			const char* special = simd::find_string_special(cur, end);
+			out.append(cur, special);
+			if (special == end)
+			{
+				break;
+			}
+
+			switch (*special)
+			{
+				case '"':
+					out += "\\\"";
+					break;
+				case '\\':
+					out += "\\\\";
+					break;
+				case '\n':
+					out += "\\n";
+					break;
+				case '\r':
+					out += "\\r";
+					break;
+				case '\t':
+					out += "\\t";
+					break;
+				default:
+					out += std::format("\\u{:04x}", static_cast<unsigned char>(*special));
+					break;
+			}
+			cur = special + 1;
+		}
+		out += '"';
+	}
+
+	inline expected<std::pair<std::string, luco::node>, error> transcoder::parse_item(std::string_view text, size_t line, bool element)
+	{
+		std::string item = element ? "k {\n" : "";
+		item.append(text);
+		item += element ? "\n}\n" : "\n";
+
+		expected<luco::node, error> parsed = parser::try_parse(item);
+		if (not parsed)
+		{
+			return unexpected(error(parsed.error().value(), "line {}: {}", line, parsed.error().message()));
+		}
+
+		auto root = parsed.value().as_object();
+		if (root->size() != 1 || (element && (not root->begin()->second.is_array() || root->begin()->second.as_array()->size() != 1)))
+		{
+			return unexpected(error(error_type::parsing_error, "line {}: invalid item '{}'", line, text));
+		}
+		else if (element)
+		{
+			return std::make_pair(std::string(), root->begin()->second.as_array()->front());
+		}
+
+		return std::make_pair(root->begin()->first, root->begin()->second);
+	}
+
+	inline size_t transcoder::json_token_end(std::string_view text, size_t pos, bool eof) noexcept
+	{
+		const char* cur = text.data() + pos;
+		const char* end = text.data() + text.size();
+		if (*cur == '"')
+		{
+			for (cur++; cur < end; cur++)
+			{
+				cur = simd::find_string_special(cur, end);
+				if (cur == end)
+				{
+					break;
+				}
+				else if (*cur == '"')
+				{
+					return static_cast<size_t>(cur + 1 - text.data());
+				}
+				else if (*cur == '\\' && ++cur == end)
+				{
+					break;
+				}
+			}
+		}
+		else
+		{
+			while (cur != end && (std::isalnum(static_cast<unsigned char>(*cur)) || *cur == '-' || *cur == '+' || *cur == '.'))
+			{
+				cur++;
+			}
+			if (cur != end)
+			{
+				return static_cast<size_t>(cur - text.data());
+			}
+		}
+
+		return eof ? text.size() : scanner::incomplete;
+	}
+
+	inline expected<monostate, error> transcoder::luco_to_json_from(chunked_source& source, const output& out_func,
+									const std::pair<char, size_t>& indent_conf) noexcept
+	{
+		std::vector<frame> frames = {{false, true, 0}};
+		std::string	   buffer = "{";
+		size_t		   pos	  = 0;
+
+		auto flush = [&](bool force)
+		{
+			if (force || buffer.size() >= chunked_source::block_size)
+			{
+				out_func(std::move(buffer));
+				buffer.clear();
+			}
+		};
+		auto not_closed = [&](size_t at)
+		{ return unexpected(error(error_type::parsing_error, "line {}: '{{' isn't closed before the end of the text", source.line_at(at))); };
+
+		while (true)
+		{
+			luco::scanner	    scanner(source.text(), source.eof());
+			luco::scanner::item item = scanner.next_item(pos, false);
+
+			// an object and an array are only told apart by their first item
+			luco::scanner::item first;
+			if (item.end != scanner::incomplete && (item.kind == scanner::item_kind::key_block || item.kind == scanner::item_kind::block))
+			{
+				first = scanner.next_item(item.block + 1, false);
+			}
+
+			if (item.end == scanner::incomplete || first.end == scanner::incomplete)
+			{
+				if (not source.read_more(pos))
+				{
+					return not_closed(item.begin);
+				}
+				continue;
+			}
+
+			// every item moves past pos, so the loop can't come back to the same place
+			const size_t next = item.kind == scanner::item_kind::key_block || item.kind == scanner::item_kind::block ? item.block + 1 : item.end;
+			if (item.kind != scanner::item_kind::end && next <= pos)
+			{
+				return unexpected(error(error_type::parsing_error, "line {}: the text can't be read past this point", source.line_at(item.begin)));
+			}
+			else if ((item.kind == scanner::item_kind::key_value || item.kind == scanner::item_kind::value) && item.end == source.text().size() &&
+				 scanner.continued(item))
+			{
+				return unexpected(error(error_type::parsing_error, "line {}: a '\\' line continuation reaches the end of the text",
+							source.line_at(item.begin)));
+			}
+
+			const bool array = frames.back().array;
+			switch (item.kind)
+			{
+				case scanner::item_kind::end:
+					if (frames.size() != 1)
+					{
+						return not_closed(item.begin);
+					}
+					buffer += "\n}";
+					flush(true);
+					return monostate();
+				case scanner::item_kind::close:
+					if (frames.size() == 1)
+					{
+						return unexpected(error(error_type::parsing_error,
+									"line {}: found '}}' without being in an [object] or [array]",
+									source.line_at(item.begin)));
+					}
+					buffer += '\n';
+					buffer.append(frames.back().indent, indent_conf.first);
+					buffer += array ? ']' : '}';
+					frames.pop_back();
+					pos = item.end;
+					flush(false);
+					continue;
+				case scanner::item_kind::key_value:
+				case scanner::item_kind::key_block:
+					if (array)
+					{
+						return unexpected(error(error_type::parsing_error, "line {}: found key '{}' inside of an array",
+									source.line_at(item.begin), scanner.key(item)));
+					}
+					break;
+				case scanner::item_kind::value:
+				case scanner::item_kind::block:
+					if (not array)
+					{
+						return unexpected(error(error_type::parsing_error, "line {}: found a value without a key inside of an object",
+									source.line_at(item.begin)));
+					}
+					break;
+			}
+
+			const bool	 scalar	     = item.kind == scanner::item_kind::key_value || item.kind == scanner::item_kind::value;
+			const size_t	 value_begin = item.kind == scanner::item_kind::key_value ? item.key_end + 1 : item.begin;
+			std::string_view raw_key     = array ? std::string_view() : source.text().substr(item.begin, item.key_end - item.begin);
+			std::string_view raw_value   = scalar ? source.text().substr(value_begin, item.end - value_begin) : std::string_view();
+			raw_value.remove_prefix(std::min(raw_value.find_first_not_of(" \t"), raw_value.size()));
+
+			bool	    quoted = false;
+			std::string key	   = array ? std::string() : scanner.key(item);
+			std::string value;
+			if (scalar)
+			{
+				value = scanner.value(item, quoted);
+				if (value.empty() && not quoted)
+				{
+					// the parser drops keys without a value
+					pos = item.end;
+					continue;
+				}
+			}
+
+			// keys and values with special characters are read by the parser itself, so the transcoder accepts and
+			// unescapes exactly what parser::parse() does
+			std::optional<luco::node> read;
+			if ((not array && not scanner::plain(raw_key)) || (scalar && not scanner::plain(raw_value)))
+			{
+				std::string_view text = item.kind == scanner::item_kind::key_block ? raw_key : source.text().substr(item.begin, item.end - item.begin);
+				auto parsed = transcoder::parse_item(item.kind == scanner::item_kind::key_block ? std::string(text) + " = 0" : std::string(text),
+								     source.line_at(item.begin), item.kind == scanner::item_kind::value);
+				if (not parsed)
+				{
+					return unexpected(parsed.error());
+				}
+				else if (scalar && not parsed.value().second.is_value())
+				{
+					return unexpected(error(error_type::parsing_error, "line {}: invalid value '{}'", source.line_at(item.begin), raw_value));
+				}
+
+				key = std::move(parsed.value().first);
+				if (scalar)
+				{
+					read = std::move(parsed.value().second);
+				}
+			}
+
+			buffer += frames.back().empty ? "\n" : ",\n";
+			buffer.append(frames.back().indent + indent_conf.second, indent_conf.first);
+			frames.back().empty = false;
+			if (not array)
+			{
+				transcoder::json_string(buffer, key);
+				buffer += ": ";
+			}
+
+			if (item.kind == scanner::item_kind::key_block || item.kind == scanner::item_kind::block)
+			{
+				bool block_array = first.kind == scanner::item_kind::value || first.kind == scanner::item_kind::block;
+				buffer += block_array ? '[' : '{';
+				frames.push_back({block_array, true, frames.back().indent + indent_conf.second});
+				pos = item.block + 1;
+				continue;
+			}
+
+			if (read)
+			{
+				const auto& value = read->as_value();
+				if (value->is_string())
+				{
+					transcoder::json_string(buffer, value->as_string());
+				}
+				else
+				{
+					buffer += value->stringify();
+				}
+				pos = item.end;
+				flush(false);
+				continue;
+			}
+
+			auto typed = luco_simple_types::get_type(value);
+			if (not typed)
+			{
+				return unexpected(error(error_type::parsing_error, "line {}: the number '{}' is out of range", source.line_at(item.begin), value));
+			}
+
+			std::visit(
+			    [&buffer](auto&& typed)
+			    {
+				    if constexpr (std::is_same_v<std::decay_t<decltype(typed)>, std::string>)
+				    {
+					    transcoder::json_string(buffer, typed);
+				    }
+				    else
+				    {
+					    buffer += luco::value(typed).stringify();
+				    }
+			    },
+			    typed.value());
+			pos = item.end;
+			flush(false);
+		}
+	}
+
+	inline expected<monostate, error> transcoder::json_to_luco_from(chunked_source& source, const output& out_func,
+									const std::pair<char, size_t>& indent_conf) noexcept
+	{
+		std::vector<frame> frames;
+		std::string	   buffer;
+		size_t		   pos	  = 0;
+		json_reader	   reader(source.text(), source.line_at(0), source.column());
+
+		auto flush = [&](bool force)
+		{
+			if (force || buffer.size() >= chunked_source::block_size)
+			{
+				out_func(std::move(buffer));
+				buffer.clear();
+			}
+		};
+		auto refill = [&]()
+		{
+			if (not source.read_more(pos))
+			{
+				return false;
+			}
+			reader = json_reader(source.text(), source.line_at(0), source.column());
+			return true;
+		};
+		auto fail = [&](std::string_view what) { return unexpected(reader.fail(source.text().data() + pos, what)); };
+		// skips whitespace, returns false at the end of the text
+		auto peek = [&]()
+		{
+			while (true)
+			{
+				std::string_view text = source.text();
+				pos		      = static_cast<size_t>(simd::skip_json_whitespace(text.data() + pos, text.data() + text.size()) - text.data());
+				if (pos < text.size())
+				{
+					return true;
+				}
+				else if (not refill())
+				{
+					return false;
+				}
+			}
+		};
+		// points the reader at a token once all of it is in the window
+		auto whole_token = [&]()
+		{
+			while (transcoder::json_token_end(source.text(), pos, source.eof()) == scanner::incomplete && refill())
+			{
+			}
+			reader._cur = source.text().data() + pos;
+		};
+		auto consumed = [&]() { pos = static_cast<size_t>(reader._cur - source.text().data()); };
+
+		if (not peek() || source.text()[pos] != '{')
+		{
+			return fail("expected a JSON object as the root of a luco text");
+		}
+		pos++;
+		frames.push_back({false, true, 0});
+
+		bool after_value = false;
+		while (not frames.empty())
+		{
+			frame& top = frames.back();
+			if (not peek())
+			{
+				return fail(after_value ? (top.array ? "expected ',' or ']' after an array element" : "expected ',' or '}' after an object member")
+							: "expected a JSON value");
+			}
+
+			char ch = source.text()[pos];
+			if (ch == (top.array ? ']' : '}') && (after_value || top.empty))
+			{
+				pos++;
+				if (frames.size() != 1)
+				{
+					buffer.append(top.indent, indent_conf.first);
+					buffer += "}\n";
+				}
+				frames.pop_back();
+				after_value = true;
+				flush(false);
+				continue;
+			}
+			else if (after_value && ch == ',')
+			{
+				pos++;
+				after_value = false;
+				continue;
+			}
+			else if (after_value)
+			{
+				return fail(top.array ? "expected ',' or ']' after an array element" : "expected ',' or '}' after an object member");
+			}
+
+			// the same layout as node::dump_to_luco()
+			top.empty = false;
+			buffer.append(top.array || top.indent != 0 ? top.indent + indent_conf.second : 0, indent_conf.first);
+			if (not top.array)
+			{
+				if (ch != '"')
+				{
+					return fail("expected a '\"' starting an object key");
+				}
+
+				whole_token();
+				auto key = reader.read_string();
+				if (not key)
+				{
+					return unexpected(key.error());
+				}
+				consumed();
+
+				if (not peek() || source.text()[pos] != ':')
+				{
+					return fail("expected ':' after an object key");
+				}
+				pos++;
+				if (not peek())
+				{
+					return fail("expected a JSON value");
+				}
+
+				ch	= source.text()[pos];
+				auto ok = luco_simple_types::write_string(buffer, key.value(), true);
+				if (not ok)
+				{
+					return ok;
+				}
+				buffer += ch == '{' || ch == '[' ? " " : " = ";
+			}
+
+			if (ch == '{' || ch == '[')
+			{
+				pos++;
+				buffer += "{\n";
+				size_t indent = top.indent + indent_conf.second;
+				frames.push_back({ch == '[', true, indent});
+				continue;
+			}
+
+			whole_token();
+			std::string_view text = source.text().substr(pos);
+			if (ch == '"')
+			{
+				auto string = reader.read_string();
+				if (not string)
+				{
+					return unexpected(string.error());
+				}
+				consumed();
+
+				auto ok = luco_simple_types::write_string(buffer, string.value(), false);
+				if (not ok)
+				{
+					return ok;
+				}
+			}
+			else if (text.starts_with("true") || text.starts_with("false") || text.starts_with("null"))
+			{
+				size_t size = text[0] == 'f' ? 5 : 4;
+				buffer.append(text.substr(0, size));
+				pos += size;
+			}
+			else
+			{
+				auto number = reader.read_number_value();
+				if (not number)
+				{
+					return unexpected(number.error());
+				}
+				consumed();
+
+				std::visit([&buffer](auto value) { buffer += luco::value(value).stringify(); }, number.value());
+			}
+			buffer += '\n';
+			after_value = true;
+			flush(false);
+		}
+
+		if (peek())
+		{
+			return fail("expected the end of the text after the JSON value");
+		}
+		flush(true);
+
+		return monostate();
+	}
+
+	inline expected<monostate, error> transcoder::try_luco_to_json(const std::filesystem::path& path, const output& out_func,
+								       const std::pair<char, size_t>& indent_conf) noexcept
+	{
+		std::unique_ptr<std::ifstream> file = std::make_unique<std::ifstream>(path, std::ios::binary);
+		if (not file->is_open())
+		{
+			return unexpected(luco::error(error_type::filesystem_error,
+						      std::format("couldn't open '{}', {}", path.string(), std::strerror(errno))));
+		}
+
+		chunked_source source(std::move(file));
+		return transcoder::luco_to_json_from(source, out_func, indent_conf);
+	}
+
+	inline expected<monostate, error> transcoder::try_luco_to_json(const std::string& raw_luco, const output& out_func,
+								       const std::pair<char, size_t>& indent_conf) noexcept
+	{
+		chunked_source source{std::string_view(raw_luco)};
+		return transcoder::luco_to_json_from(source, out_func, indent_conf);
+	}
+
+	inline expected<monostate, error> transcoder::try_luco_to_json(const char* raw_luco, const output& out_func,
+								       const std::pair<char, size_t>& indent_conf) noexcept
+	{
+		assert(raw_luco != NULL);
+		chunked_source source{std::string_view(raw_luco)};
+		return transcoder::luco_to_json_from(source, out_func, indent_conf);
+	}
+
+	inline expected<monostate, error> transcoder::try_json_to_luco(const std::filesystem::path& path, const output& out_func,
+								       const std::pair<char, size_t>& indent_conf) noexcept
+	{
+		std::unique_ptr<std::ifstream> file = std::make_unique<std::ifstream>(path, std::ios::binary);
+		if (not file->is_open())
+		{
+			return unexpected(luco::error(error_type::filesystem_error,
+						      std::format("couldn't open '{}', {}", path.string(), std::strerror(errno))));
+		}
+
+		chunked_source source(std::move(file));
+		return transcoder::json_to_luco_from(source, out_func, indent_conf);
+	}
+
+	inline expected<monostate, error> transcoder::try_json_to_luco(const std::string& raw_json, const output& out_func,
+								       const std::pair<char, size_t>& indent_conf) noexcept
+	{
+		chunked_source source{std::string_view(raw_json)};
+		return transcoder::json_to_luco_from(source, out_func, indent_conf);
+	}
+
+	inline expected<monostate, error> transcoder::try_json_to_luco(const char* raw_json, const output& out_func,
+								       const std::pair<char, size_t>& indent_conf) noexcept
+	{
+		assert(raw_json != NULL);
+		chunked_source source{std::string_view(raw_json)};
+		return transcoder::json_to_luco_from(source, out_func, indent_conf);
+	}
+
+	inline void transcoder::luco_to_json(const std::filesystem::path& path, const output& out_func, const std::pair<char, size_t>& indent_conf)
+	{
+		expected<monostate, error> ok = transcoder::try_luco_to_json(path, out_func, indent_conf);
+		if (not ok)
+		{
+			raise_error(ok.error());
+		}
+	}
+
+	inline void transcoder::luco_to_json(const std::string& raw_luco, const output& out_func, const std::pair<char, size_t>& indent_conf)
+	{
+		expected<monostate, error> ok = transcoder::try_luco_to_json(raw_luco, out_func, indent_conf);
+		if (not ok)
+		{
+			raise_error(ok.error());
+		}
+	}
+
+	inline void transcoder::luco_to_json(const char* raw_luco, const output& out_func, const std::pair<char, size_t>& indent_conf)
+	{
+		expected<monostate, error> ok = transcoder::try_luco_to_json(raw_luco, out_func, indent_conf);
+		if (not ok)
+		{
+			raise_error(ok.error());
+		}
+	}
+
+	inline void transcoder::json_to_luco(const std::filesystem::path& path, const output& out_func, const std::pair<char, size_t>& indent_conf)
+	{
+		expected<monostate, error> ok = transcoder::try_json_to_luco(path, out_func, indent_conf);
+		if (not ok)
+		{
+			raise_error(ok.error());
+		}
+	}
+
+	inline void transcoder::json_to_luco(const std::string& raw_json, const output& out_func, const std::pair<char, size_t>& indent_conf)
+	{
+		expected<monostate, error> ok = transcoder::try_json_to_luco(raw_json, out_func, indent_conf);
+		if (not ok)
+		{
+			raise_error(ok.error());
+		}
+	}
+
+	inline void transcoder::json_to_luco(const char* raw_json, const output& out_func, const std::pair<char, size_t>& indent_conf)
+	{
+		expected<monostate, error> ok = transcoder::try_json_to_luco(raw_json, out_func, indent_conf);
+		if (not ok)
+		{
+			raise_error(ok.error());
+		}
+	}
+}
@@ -0,0 +1,90 @@
+/*
+ * Copyright: 2025 nodeluna
+ * SPDX-License-Identifier: Apache-2.0
+ * repository: https://github.com/nodeluna/luco
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <variant>
+#include "api.hpp"
+#include "expected.hpp"
+#include "error.hpp"
+
+/**
+ * @brief the namespace for luco
+ */
+namespace luco
+{
+	/**
+	 * @brief calls the overload of a visitor for what a node holds, with one switch over the kind of node and the
+	 * type of its value instead of a chain of is_*() and as_*() calls
+	 * @param visitor callable with luco::object&, luco::array&, std::string&, double&, int64_t&, bool& and null_type&.
+	 * an empty luco::value is visited as luco::monostate& if the visitor takes it, as null otherwise
+	 * @return what the visitor returns, every overload should return the same type
+	 * @detail @cpp
+	 * struct counter {
+	 *	size_t strings = 0;
+	 *	void operator()(luco::object& object) { for (auto& [key, child] : object) luco::visit(*this, child); }
+	 *	void operator()(luco::array& array) { for (auto& child : array) luco::visit(*this, child); }
+	 *	void operator()(std::string&) { strings++; }
+	 *	void operator()(auto&) {}
+	 * };
+	 * @ecpp
+	 * the references are to the node itself, so a visitor can change a value in place without changing its type
+	 */
+	template<typename visitor_t>
+	decltype(auto) visit(visitor_t&& visitor, const luco::node& node);
+}
+
+namespace luco
+{
+	template<typename visitor_t>
+	decltype(auto) visit(visitor_t&& visitor, const luco::node& node)
+	{
+		using result_t = std::invoke_result_t<visitor_t, luco::object&>;
+		static_assert(std::is_same_v<std::variant_alternative_t<0, decltype(value::_value)>, std::string> &&
+				  std::is_same_v<std::variant_alternative_t<5, decltype(value::_value)>, monostate> &&
+				  std::is_same_v<std::variant_alternative_t<1, luco_node>, std::shared_ptr<luco::array>>,
+			      "luco::visit() follows the order of the alternatives of luco::value and luco::node");
+
+		// the index of the value's alternative, then the array and the object after them
+		constexpr size_t value_kinds = std::variant_size_v<decltype(value::_value)>;
+		const size_t	 held	     = node._node.index();
+		auto		 val	     = held == 0 ? std::get_if<0>(&node._node)->get() : nullptr;
+		const size_t	 tag	     = val != nullptr ? val->_value.index() : value_kinds + held - 1;
+
+		switch (tag)
+		{
+			case 0:
+				return static_cast<result_t>(visitor(*std::get_if<0>(&val->_value)));
+			case 1:
+				return static_cast<result_t>(visitor(*std::get_if<1>(&val->_value)));
+			case 2:
+				return static_cast<result_t>(visitor(*std::get_if<2>(&val->_value)));
+			case 3:
+				return static_cast<result_t>(visitor(*std::get_if<3>(&val->_value)));
+			case 4:
+				return static_cast<result_t>(visitor(*std::get_if<4>(&val->_value)));
+			case 5:
+				if constexpr (std::is_invocable_v<visitor_t, monostate&>)
+				{
+					return static_cast<result_t>(visitor(*std::get_if<5>(&val->_value)));
+				}
+				else
+				{
+					null_type null;
+					return static_cast<result_t>(visitor(null));
+				}
+			case value_kinds:
+				return static_cast<result_t>(visitor(**std::get_if<1>(&node._node)));
+			default:
+				return static_cast<result_t>(visitor(**std::get_if<2>(&node._node)));
+		}
+	}
+}
@@ -13,19 +13,71 @@ export module luco;
 export namespace luco
 {
 	using luco::array;
+	using luco::array_arena;
 	using luco::array_values;
+	using luco::async_parse;
+	using luco::chunked_source;
+	using luco::codegen;
+	using luco::container_allocator;
+	using luco::count_if;
+	using luco::document;
+	using luco::embed;
 	using luco::error;
 	using luco::error_type;
+	using luco::executor;
 	using luco::expected;
+	using luco::fixed_string;
+	using luco::for_each;
+	using luco::inline_allocator;
+	using luco::inline_arena;
+	using luco::inline_elements;
+	using luco::inline_executor;
+	using luco::inline_keys;
+	using luco::is_execution_policy;
+	using luco::json_reader;
 	using luco::monostate;
 	using luco::node;
 	using luco::null;
 	using luco::null_type;
 	using luco::object;
+	using luco::object_arena;
 	using luco::object_pairs;
+	using luco::ordered_map;
+	using luco::parse_awaitable;
+	using luco::parse_options;
 	using luco::parser;
+	using luco::projection;
+	using luco::scanner;
+	using luco::schema;
+	using luco::simd;
+	using luco::source_span;
+	using luco::static_document;
+	using luco::static_entry;
+	using luco::static_image;
+	using luco::static_node;
+	using luco::text_edit;
+	using luco::thread_pool;
 	using luco::token;
+	using luco::transcoder;
+	using luco::transform_values;
+	using luco::tree_walk;
+	using luco::typed_reader;
+	using luco::typed_writer;
 	using luco::unexpected;
 	using luco::value;
 	using luco::value_type;
+	using luco::visit;
+
+	namespace execution
+	{
+		using luco::execution::par;
+		using luco::execution::parallel_policy;
+		using luco::execution::seq;
+		using luco::execution::sequenced_policy;
+	}
+
+	namespace literals
+	{
+		using luco::literals::operator""_luco;
+	}
 }
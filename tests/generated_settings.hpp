@@ -0,0 +1,225 @@
+// generated by luco::codegen, don't edit
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <luco.hpp>
+
+namespace generated
+{
+	struct settings_server {
+		bool debug = false;
+		std::string name;
+		int64_t port = 0;
+		double ratio = 0;
+	};
+
+	inline int settings_server_member(std::string_view key) noexcept
+	{
+		switch (key.size())
+		{
+			case 4:
+				switch (key[0])
+				{
+					case 'n':
+						return key == "name" ? 1 : -1;
+					case 'p':
+						return key == "port" ? 2 : -1;
+				}
+				break;
+			case 5:
+				switch (key[0])
+				{
+					case 'd':
+						return key == "debug" ? 0 : -1;
+					case 'r':
+						return key == "ratio" ? 3 : -1;
+				}
+				break;
+		}
+
+		return -1;
+	}
+
+	inline luco::expected<size_t, luco::error> luco_read(const luco::typed_reader& reader, size_t opening, settings_server& out)
+	{
+		size_t pos = opening == luco::scanner::incomplete ? 0 : opening + 1;
+		while (true)
+		{
+			auto item = reader.next(pos, opening, true);
+			if (not item)
+			{
+				return luco::unexpected(item.error());
+			}
+			else if (item.value().kind == luco::scanner::item_kind::close || item.value().kind == luco::scanner::item_kind::end)
+			{
+				return item.value().end;
+			}
+
+			luco::expected<size_t, luco::error> end = luco::unexpected(luco::error(luco::error_type::none, ""));
+			switch (settings_server_member(reader.key(item.value())))
+			{
+				case 0:
+					end = reader.read(item.value(), out.debug);
+					break;
+				case 1:
+					end = reader.read(item.value(), out.name);
+					break;
+				case 2:
+					end = reader.read(item.value(), out.port);
+					break;
+				case 3:
+					end = reader.read(item.value(), out.ratio);
+					break;
+				default:
+					end = reader.skip(item.value());
+					break;
+			}
+
+			if (not end)
+			{
+				return end;
+			}
+			pos = end.value();
+		}
+	}
+
+	inline void luco_write(luco::typed_writer& writer, const settings_server& value)
+	{
+		writer.write("debug", value.debug);
+		writer.write("name", value.name);
+		writer.write("port", value.port);
+		writer.write("ratio", value.ratio);
+	}
+
+	struct settings {
+		std::string a_key;
+		settings_server server;
+		std::vector<std::string> tags;
+	};
+
+	inline int settings_member(std::string_view key) noexcept
+	{
+		switch (key.size())
+		{
+			case 4:
+				if (key == "tags")
+				{
+					return 2;
+				}
+				break;
+			case 5:
+				if (key == "a key")
+				{
+					return 0;
+				}
+				break;
+			case 6:
+				if (key == "server")
+				{
+					return 1;
+				}
+				break;
+		}
+
+		return -1;
+	}
+
+	inline luco::expected<size_t, luco::error> luco_read(const luco::typed_reader& reader, size_t opening, settings& out)
+	{
+		size_t pos = opening == luco::scanner::incomplete ? 0 : opening + 1;
+		while (true)
+		{
+			auto item = reader.next(pos, opening, true);
+			if (not item)
+			{
+				return luco::unexpected(item.error());
+			}
+			else if (item.value().kind == luco::scanner::item_kind::close || item.value().kind == luco::scanner::item_kind::end)
+			{
+				return item.value().end;
+			}
+
+			luco::expected<size_t, luco::error> end = luco::unexpected(luco::error(luco::error_type::none, ""));
+			switch (settings_member(reader.key(item.value())))
+			{
+				case 0:
+					end = reader.read(item.value(), out.a_key);
+					break;
+				case 1:
+					end = reader.read(item.value(), out.server);
+					break;
+				case 2:
+					end = reader.read(item.value(), out.tags);
+					break;
+				default:
+					end = reader.skip(item.value());
+					break;
+			}
+
+			if (not end)
+			{
+				return end;
+			}
+			pos = end.value();
+		}
+	}
+
+	inline void luco_write(luco::typed_writer& writer, const settings& value)
+	{
+		writer.write("a key", value.a_key);
+		writer.write("server", value.server);
+		writer.write("tags", value.tags);
+	}
+
+	inline luco::expected<settings, luco::error> try_parse_settings(std::string_view text)
+	{
+		luco::typed_reader reader(text);
+		settings		   out;
+		auto		   end = luco_read(reader, luco::scanner::incomplete, out);
+		if (not end)
+		{
+			return luco::unexpected(end.error());
+		}
+
+		return out;
+	}
+
+	inline settings parse_settings(std::string_view text)
+	{
+		luco::expected<settings, luco::error> ok = try_parse_settings(text);
+		if (not ok)
+		{
+			luco::raise_error(ok.error());
+		}
+
+		return ok.value();
+	}
+
+	inline luco::expected<std::string, luco::error> try_dump_settings(const settings& value,
+								const std::pair<char, size_t>& indent_conf = {' ', 4})
+	{
+		luco::typed_writer writer(indent_conf);
+		luco_write(writer, value);
+		if (not writer.status())
+		{
+			return luco::unexpected(writer.status().error());
+		}
+
+		return writer.text();
+	}
+
+	inline std::string dump_settings(const settings& value, const std::pair<char, size_t>& indent_conf = {' ', 4})
+	{
+		luco::expected<std::string, luco::error> ok = try_dump_settings(value, indent_conf);
+		if (not ok)
+		{
+			luco::raise_error(ok.error());
+		}
+
+		return ok.value();
+	}
+}
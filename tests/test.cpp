@@ -1,11 +1,25 @@
+#include <condition_variable>
+#include <coroutine>
+#include <deque>
 #include <functional>
 #include <initializer_list>
 #include <iostream>
 #include <list>
+#include <mutex>
+#include <sstream>
+#include <optional>
+#include <set>
 #include <string>
 #include <array>
+#include <atomic>
+#include <thread>
 #include <luco.hpp>
 #include <gtest/gtest.h>
+#include "generated_settings.hpp"
+
+#if not defined(_WIN32)
+#include <unistd.h>
+#endif
 
 template<typename... args_t>
 void println(std::format_string<args_t...> fmt, args_t&&... args)
@@ -318,6 +332,21 @@ TEST_F(luco_test, invalid_luco)
 	EXPECT_TRUE(not parser.try_parse(R"""({"smol":tru e})"""));
 	EXPECT_TRUE(not parser.try_parse(R"""({""key":nu ll})"""));
 
+	// a '}' closing the root, a '}' after an element on its line, a '{' never closed and a continuation at the end
+	for (const char* invalid : {"}\n", "a = 1\n}\n", "k { 1 }\n", "k {\n\ta = 1\n", "k = 1 \\\n"})
+	{
+		EXPECT_FALSE(parser.try_parse(invalid)) << invalid;
+	}
+	EXPECT_EQ(parser.parse("k {\n\t1 \\\n\t2\n}\n").at("k").at(0).as_string(), "1 2");
+	EXPECT_EQ(parser.parse("a = 1").at("a").as_integer(), 1);
+
+	// brackets the parser can't match are errors, not failed assertions, and a text reads like the same file
+	for (const char* invalid : {"a=c{1\n}a=4{", "b=y{'=a{b=y\n}}", "c=q{ {2\n}}b=c{"})
+	{
+		EXPECT_FALSE(parser.try_parse(invalid)) << invalid;
+	}
+	EXPECT_EQ(parser.parse("a = x}}y\n").at("a").as_string(), "x}y");
+
 #if defined(_WIN32) || defined(_WIN64)
 #else
 // 	luco::node node = parser.parse(
@@ -755,6 +784,1426 @@ TEST_F(luco_test, setting_values_set_method)
 	EXPECT_EQ(node.at("key3").as_boolean(), true);
 }
 
+TEST_F(luco_test, include_directive)
+{
+	std::filesystem::path dir = std::filesystem::temp_directory_path() / "luco_include_test";
+	std::filesystem::create_directories(dir);
+
+	auto write_file = [&dir](const std::string& name, const std::string& content)
+	{
+		std::ofstream file(dir / name);
+		file << content;
+	};
+
+	write_file("shared.luco", "host = localhost\nport = 8080\nnested = @include \"leaf.luco\"\n");
+	write_file("leaf.luco", "leaf = true\n");
+	write_file("main.luco", "primary = @include \"shared.luco\"\nservers {\n\t@include shared.luco\n\t5\n}\n");
+	write_file("cycle_a.luco", "b = @include \"cycle_b.luco\"\n");
+	write_file("cycle_b.luco", "a = @include \"cycle_a.luco\"\n");
+	write_file("missing.luco", "a = @include \"does_not_exist.luco\"\n");
+	write_file("quoted.luco", "a = \"@include shared.luco\"\n");
+	write_file("outside.luco", "a = @include \"../luco_include_secret.luco\"\n");
+
+	// includes are off unless asked for, the directive is then a plain value
+	luco::expected<luco::node, luco::error> plain = luco::parser::try_parse(dir / "main.luco");
+	ASSERT_TRUE(plain);
+	EXPECT_EQ(plain.value().at("primary").as_string(), "@include \"shared.luco\"");
+
+	luco::parse_options options;
+	options.allow_includes	= true;
+	options.include_threads = 1;
+
+	luco::expected<luco::node, luco::error> node = luco::parser::try_parse(dir / "main.luco", options);
+	ASSERT_TRUE(node);
+	EXPECT_EQ(node.value().at("primary").at("host").as_string(), "localhost");
+	EXPECT_EQ(node.value().at("primary").at("port").as_integer(), 8080);
+	EXPECT_TRUE(node.value().at("primary").at("nested").at("leaf").as_boolean());
+	EXPECT_TRUE(node.value().at("servers").is_array());
+	EXPECT_EQ(node.value().at("servers").at(0).at("port").as_integer(), 8080);
+	EXPECT_EQ(node.value().at("servers").at(1).as_integer(), 5);
+
+	// a file included twice is parsed once, but each place gets its own copy
+	EXPECT_NE(node.value().at("primary").as_object(), node.value().at("servers").at(0).as_object());
+	EXPECT_NE(node.value().at("primary").at("nested").as_object(), node.value().at("servers").at(0).at("nested").as_object());
+	node.value().at("primary").at("port") = 9090;
+	node.value().at("primary").at("nested").at("leaf") = false;
+	EXPECT_EQ(node.value().at("servers").at(0).at("port").as_integer(), 8080);
+	EXPECT_TRUE(node.value().at("servers").at(0).at("nested").at("leaf").as_boolean());
+
+	// the files requested before an error are dropped, the ones nobody started aren't parsed
+	write_file("broken.luco", "a = @include \"leaf.luco\"\nb = @include \"shared.luco\"\nc = @include \"main.luco\"\n}\n");
+	luco::expected<luco::node, luco::error> broken = luco::parser::try_parse(dir / "broken.luco", options);
+	EXPECT_FALSE(broken);
+
+	luco::expected<luco::node, luco::error> cycle = luco::parser::try_parse(dir / "cycle_a.luco", options);
+	ASSERT_FALSE(cycle);
+	EXPECT_NE(cycle.error().message().find("include cycle"), std::string::npos);
+
+	luco::expected<luco::node, luco::error> missing = luco::parser::try_parse(dir / "missing.luco", options);
+	ASSERT_FALSE(missing);
+	EXPECT_NE(missing.error().message().find("does_not_exist.luco"), std::string::npos);
+
+	luco::expected<luco::node, luco::error> quoted = luco::parser::try_parse(dir / "quoted.luco", options);
+	ASSERT_TRUE(quoted);
+	EXPECT_EQ(quoted.value().at("a").as_string(), "@include shared.luco");
+
+	// a file can't include anything outside of the root, the directory of the parsed file by default
+	std::ofstream(dir.parent_path() / "luco_include_secret.luco") << "secret = 1\n";
+	luco::expected<luco::node, luco::error> outside = luco::parser::try_parse(dir / "outside.luco", options);
+	ASSERT_FALSE(outside);
+	EXPECT_NE(outside.error().message().find("outside of"), std::string::npos);
+
+	// a relative path is resolved from the current directory, which is then the root
+	std::filesystem::path cwd = std::filesystem::current_path();
+	std::filesystem::current_path(dir);
+	luco::expected<luco::node, luco::error> relative = luco::parser::try_parse(std::filesystem::path("main.luco"), options);
+	std::filesystem::current_path(cwd);
+	ASSERT_TRUE(relative);
+	EXPECT_EQ(relative.value().at("primary").at("port").as_integer(), 8080);
+
+	options.include_root = dir.parent_path();
+	EXPECT_TRUE(luco::parser::try_parse(dir / "outside.luco", options));
+	std::filesystem::remove(dir.parent_path() / "luco_include_secret.luco");
+
+	std::filesystem::remove_all(dir);
+}
+
+TEST_F(luco_test, incremental_reparse)
+{
+	std::string text = "name = luco\n"
+			   "server {\n"
+			   "\thost = localhost\n"
+			   "\tlimits {\n"
+			   "\t\tmax = 10\n"
+			   "\t}\n"
+			   "\tports {\n"
+			   "\t\t80\n"
+			   "\t\t443\n"
+			   "\t}\n"
+			   "}\n"
+			   "other {\n"
+			   "\ta = 1\n"
+			   "}\n";
+
+	auto check_spans = [](const luco::document& doc)
+	{
+		for (const luco::source_span& span : doc.spans())
+		{
+			EXPECT_EQ(doc.text()[span.begin], '{');
+			EXPECT_EQ(doc.text()[span.end], '}');
+		}
+	};
+
+	luco::expected<luco::document, luco::error> doc = luco::document::try_parse(text);
+	ASSERT_TRUE(doc);
+	EXPECT_EQ(doc.value().spans().size(), 4);
+	check_spans(doc.value());
+
+	luco::node root	  = doc.value().root();
+	auto	   server = root.at("server").as_object();
+	auto	   limits = root.at("server").at("limits").as_object();
+	auto	   ports  = root.at("server").at("ports").as_array();
+	auto	   other  = root.at("other").as_object();
+
+	size_t at = doc.value().text().find("10");
+	ASSERT_TRUE(doc.value().try_edit({at, at + 2, "2000\n\t\tmin = 1"}));
+	check_spans(doc.value());
+	EXPECT_EQ(root.at("server").at("limits").at("max").as_integer(), 2000);
+	EXPECT_EQ(root.at("server").at("limits").at("min").as_integer(), 1);
+	EXPECT_EQ(root.at("server").as_object(), server);
+	EXPECT_EQ(root.at("server").at("limits").as_object(), limits);
+	EXPECT_EQ(root.at("server").at("ports").as_array(), ports);
+	EXPECT_EQ(root.at("other").as_object(), other);
+	EXPECT_EQ(root.dump_to_string(), luco::parser::parse(doc.value().text()).dump_to_string());
+
+	// the entries of the reparsed object the edit didn't change are kept, and their spans still edit the tree
+	at = doc.value().text().find("localhost");
+	ASSERT_TRUE(doc.value().try_edit({at, at + 9, "example.org"}));
+	check_spans(doc.value());
+	EXPECT_EQ(root.at("server").at("host").as_string(), "example.org");
+	EXPECT_EQ(root.at("server").at("limits").as_object(), limits);
+	EXPECT_EQ(root.at("server").at("ports").as_array(), ports);
+	at = doc.value().text().find("2000");
+	ASSERT_TRUE(doc.value().try_edit({at, at + 4, "30"}));
+	EXPECT_EQ(limits->at("max").as_integer(), 30);
+
+	// so are the elements of an array before and after the edited ones
+	auto first_port = root.at("server").at("ports").at(0).as_value();
+	at		= doc.value().text().find("443");
+	ASSERT_TRUE(doc.value().try_edit({at, at + 3, "8443\n\t\t9443"}));
+	check_spans(doc.value());
+	EXPECT_EQ(root.at("server").at("ports").as_array(), ports);
+	EXPECT_EQ(ports->size(), 3);
+	EXPECT_EQ(root.at("server").at("ports").at(0).as_value(), first_port);
+	EXPECT_EQ(root.dump_to_string(), luco::parser::parse(doc.value().text()).dump_to_string());
+
+	// an edit that closes the enclosing object early falls back to reparsing everything
+	at = doc.value().text().find("min = 1");
+	ASSERT_TRUE(doc.value().try_edit({at, at + 7, "min = 1\n\t}\n\textra {\n\t\tb = 2"}));
+	check_spans(doc.value());
+	EXPECT_EQ(doc.value().root().at("server").at("extra").at("b").as_integer(), 2);
+	EXPECT_EQ(doc.value().root().dump_to_string(), luco::parser::parse(doc.value().text()).dump_to_string());
+
+	std::string before = doc.value().text();
+	EXPECT_FALSE(doc.value().try_edit({before.size(), before.size() + 1, ""}));
+	at = before.find("b = 2");
+	EXPECT_FALSE(doc.value().try_edit({at, at + 5, "b = = 2"}));
+	EXPECT_EQ(doc.value().text(), before);
+}
+
+TEST_F(luco_test, projection_parsing)
+{
+	std::string text = "# a comment {with brackets}\n"
+			   "name = \"luco # not a key\"\n"
+			   "server {\n"
+			   "\thost = localhost\n"
+			   "\tlimits {\n"
+			   "\t\tmax = 10\n"
+			   "\t}\n"
+			   "\tports {\n"
+			   "\t\t80\n"
+			   "\t\t443\n"
+			   "\t}\n"
+			   "}\n"
+			   "skipped {\n"
+			   "\tnot = = valid\n"
+			   "\t#{ { } }\n"
+			   "\tnested {\n"
+			   "\t\tport = 1\n"
+			   "\t}\n"
+			   "}\n"
+			   "last = 5\n";
+
+	luco::projection paths = {{"server", "limits"}, {"server", "ports"}, {"last"}, {"missing", "key"}};
+	luco::expected<luco::node, luco::error> node = luco::parser::try_parse(text, paths);
+	ASSERT_TRUE(node);
+	EXPECT_EQ(node.value().as_object()->size(), 2);
+	EXPECT_FALSE(node.value().contains("skipped"));
+	EXPECT_FALSE(node.value().at("server").contains("host"));
+	EXPECT_EQ(node.value().at("server").at("limits").at("max").as_integer(), 10);
+	EXPECT_EQ(node.value().at("server").at("ports").at(1).as_integer(), 443);
+	EXPECT_EQ(node.value().at("last").as_integer(), 5);
+
+	// a predicate descends into every object but only parses the selected keys
+	luco::projection ports([](const luco::projection::key_path& path) { return path.back() == "port"; });
+	node = luco::parser::try_parse(text, ports);
+	ASSERT_TRUE(node);
+	EXPECT_EQ(node.value().at("skipped").at("nested").at("port").as_integer(), 1);
+	EXPECT_FALSE(node.value().at("skipped").contains("not"));
+	EXPECT_FALSE(node.value().contains("server"));
+
+	// selected subtrees are parsed with their line numbers in the text
+	luco::expected<luco::node, luco::error> invalid = luco::parser::try_parse("a = 1\nb {\n\tc = = 2\n}\n", {{"b"}});
+	ASSERT_FALSE(invalid);
+	EXPECT_NE(invalid.error().message().find("3:"), std::string::npos);
+	EXPECT_FALSE(luco::parser::try_parse("a {\n\tb = 1\n", {{"b"}}));
+
+	// a '#' inside quotes is part of the key or value, as in parser::parse()
+	std::string quoted = "k = \"a#b\" # a comment\n\"x#y\" = 'c # d'\nlast = 1\n";
+	node		   = luco::parser::try_parse(quoted, {{"k"}, {"x#y"}, {"last"}});
+	ASSERT_TRUE(node);
+	EXPECT_EQ(node.value().at("k").as_string(), "a#b");
+	EXPECT_EQ(node.value().at("x#y").as_string(), "c # d");
+	EXPECT_EQ(node.value().at("last").as_integer(), 1);
+
+	luco::node parsed = luco::parser::parse(quoted);
+	EXPECT_EQ(parsed.at("k").as_string(), "a#b");
+	EXPECT_EQ(parsed.at("x#y").as_string(), "c # d");
+	EXPECT_EQ(luco::parser::parse("k = a#b\n").at("k").as_string(), "a");
+
+	// every top-level key reads the same as in parser::parse(), however the text around it is written
+	std::vector<std::string> texts = {"\\port=x1\n",
+					  "a=1\n\\port=x1",
+					  "a = 1\na = 2\n",
+					  "k {\n\ta = 1\n}\nk {\n\tb = 2\n}\n",
+					  "a = 1 # c\n\"b\" = 'x y'\nc=d",
+					  "k {\n\t1\n\t2\n}\nv = w\n",
+					  "a = \\\n\t1\nb = 2\n",
+					  "a {{b = 1\nc = }}\n",
+					  quoted};
+	for (const std::string& differential : texts)
+	{
+		luco::node whole = luco::parser::parse(differential);
+		for (const auto& [key, value] : *whole.as_object())
+		{
+			luco::node projected = luco::parser::parse(differential, {{key}});
+			ASSERT_EQ(projected.as_object()->size(), 1) << differential;
+			EXPECT_EQ(projected.at(key).dump_to_string(), value.dump_to_string()) << differential;
+		}
+	}
+	EXPECT_FALSE(luco::parser::parse("k {\n\ta = 1\n}\nk {\n\tb = 2\n}\n", {{"k", "a"}}).contains("k"));
+
+	// a file is scanned block by block, a selected item longer than a block stays whole
+	std::filesystem::path path = std::filesystem::temp_directory_path() / "luco_projection_test.luco";
+	{
+		std::ofstream file(path);
+		file << "skipped {\n";
+		for (int i = 0; i < 5000; i++)
+		{
+			file << "\tkey" << i << " = \"# not a comment\" # a comment\n";
+		}
+		file << "}\nselected {\n";
+		for (int i = 0; i < 5000; i++)
+		{
+			file << "\tkey" << i << " = " << i << "\n";
+		}
+		file << "}\n";
+	}
+	for (bool plain : {true, false})
+	{
+		if (not plain)
+		{
+			std::ofstream(path, std::ios::app) << "\\port=x1\n";
+		}
+		node = luco::parser::try_parse(path, {{"selected"}, {"port"}});
+		ASSERT_TRUE(node);
+		EXPECT_FALSE(node.value().contains("skipped"));
+		EXPECT_EQ(node.value().at("selected").as_object()->size(), 5000);
+		EXPECT_EQ(node.value().at("selected").at("key4999").as_integer(), 4999);
+		EXPECT_EQ(node.value().contains("port"), not plain);
+	}
+	EXPECT_EQ(node.value().at("port").as_string(), "x1");
+	std::filesystem::remove(path);
+}
+
+TEST_F(luco_test, stream_array)
+{
+	std::filesystem::path path = std::filesystem::temp_directory_path() / "luco_stream_array_test.luco";
+	{
+		std::ofstream file(path);
+		// a sibling spanning many blocks, skipped without keeping it in memory
+		file << "meta {\n\tskipped = \"{ not a bracket\"\n";
+		for (int i = 0; i < 20000; i++)
+		{
+			file << "\tnested" << i << " {\n\t\tquoted = \"# { }\"\n\t\t#{ { } }\n\t}\n";
+		}
+		file << "}\nevents {\n";
+		for (int i = 0; i < 20000; i++)
+		{
+			file << "\t{\n\t\tid = " << i << "\n\t}\n";
+		}
+		file << "\tlast\n}\n";
+	}
+
+	size_t	count = 0;
+	int64_t sum   = 0;
+	auto	ok    = luco::parser::try_stream_array(path, {"events"},
+						       [&](luco::node& element)
+						       {
+							       if (element.is_object())
+							       {
+								       sum += element.at("id").as_integer();
+							       }
+							       else
+							       {
+								       EXPECT_EQ(element.as_string(), "last");
+							       }
+							       count++;
+							       return true;
+						       });
+	ASSERT_TRUE(ok);
+	EXPECT_EQ(count, 20001);
+	EXPECT_EQ(sum, int64_t(20000) * 19999 / 2);
+
+	// the consumer can stop early
+	count = 0;
+	luco::parser::stream_array(path, {"events"}, [&](luco::node&) { return ++count < 3; });
+	EXPECT_EQ(count, 3);
+
+	EXPECT_FALSE(luco::parser::try_stream_array(path, {"meta"}, [](luco::node&) { return true; }));
+	EXPECT_FALSE(luco::parser::try_stream_array(path, {"missing"}, [](luco::node&) { return true; }));
+	EXPECT_THROW(luco::parser::stream_array("a {\n\t1\n", {"a"}, [](luco::node&) { return true; }), luco::error);
+
+	// a last element cut short by a continuation at the end of the file is an error, it doesn't hang
+	{
+		std::ofstream file(path);
+		file << "k {\n\t0\n\t1 \\\n";
+	}
+	count	= 0;
+	auto cut = luco::parser::try_stream_array(path, {"k"}, [&](luco::node&) { return ++count != 0; });
+	EXPECT_FALSE(cut);
+	EXPECT_EQ(count, 1);
+	EXPECT_FALSE(luco::parser::try_stream_array("k {\n\t1 \\\n", {"k"}, [](luco::node&) { return true; }));
+
+	std::filesystem::remove(path);
+}
+
+TEST_F(luco_test, parse_json)
+{
+	luco::expected<luco::node, luco::error> node = luco::parser::try_parse_json(R"""(
+		{
+			"name": "luco \"json\" \u00e9\ud83d\ude00\n",
+			"count": 9007199254740993,
+			"ratio": -2.5e3,
+			"flags": [true, false, null, [], {}],
+			"nested": {"deep": {"deeper": [1, 2.0, "three"]}}
+		}
+	)""");
+	ASSERT_TRUE(node);
+	EXPECT_EQ(node.value().at("name").as_string(), "luco \"json\" \u00e9\U0001F600\n");
+	EXPECT_EQ(node.value().at("count").as_integer(), 9007199254740993);
+	EXPECT_EQ(node.value().at("ratio").as_double(), -2500.0);
+	EXPECT_TRUE(node.value().at("flags").at(0).as_boolean());
+	EXPECT_TRUE(node.value().at("flags").at(2).is_null());
+	EXPECT_TRUE(node.value().at("flags").at(3).is_array());
+	EXPECT_TRUE(node.value().at("flags").at(4).is_object());
+	EXPECT_EQ(node.value().at("nested").at("deep").at("deeper").at(1).as_double(), 2.0);
+	EXPECT_EQ(node.value().at("nested").at("deep").at("deeper").at(2).as_string(), "three");
+
+	// a string long enough to go through the vector loops
+	std::string long_string(100, 'x');
+	long_string[77] = '"';
+	EXPECT_EQ(luco::parser::parse_json("[\"" + long_string.substr(0, 77) + "\\" + long_string.substr(77) + "\"]").at(0).as_string(),
+		  long_string);
+
+	for (const char* invalid : {"[1,]", "{\"a\" 1}", "\"abc", "01", "-", "[\"\x01\"]", "\"\\ud800\"", "[] x", "tru", "{\"a\":}"})
+	{
+		EXPECT_FALSE(luco::parser::try_parse_json(invalid)) << invalid;
+	}
+
+	luco::expected<luco::node, luco::error> invalid = luco::parser::try_parse_json("{\n\t\"a\": [1,\n\t2 3]\n}");
+	ASSERT_FALSE(invalid);
+	EXPECT_NE(invalid.error().message().find("3:4"), std::string::npos);
+
+	// doubles of any magnitude are dumped in a form the luco parser reads back as the same double
+	luco::node magnitudes = luco::parser::parse_json("{\"big\": 1e20, \"huge\": 1.7976931348623157e308, \"small\": 1e-7, "
+							 "\"tiny\": 5e-324, \"pi\": 3.141592653589793}");
+	luco::node reparsed   = luco::parser::parse(magnitudes.dump_to_string());
+	for (const char* key : {"big", "huge", "small", "tiny", "pi"})
+	{
+		ASSERT_TRUE(reparsed.at(key).is_double()) << key;
+		EXPECT_EQ(reparsed.at(key).as_double(), magnitudes.at(key).as_double()) << key;
+	}
+	EXPECT_EQ(luco::value(1e20).stringify(), "100000000000000000000.0");
+	EXPECT_EQ(luco::value(1e-7).stringify(), "0.0000001");
+}
+
+TEST_F(luco_test, transcoder)
+{
+	// the layout is the same as dump_to_json() when the keys are already sorted
+	std::string raw_luco = "a = 1\nb = 2.5\nc {\n\t1\n\ttwo\n\t{\n\t\tx = on\n\t}\n}\nd {\n}\ne = 'it''s'\n";
+	std::string json, expected_json;
+	luco::transcoder::luco_to_json(raw_luco, [&](std::string out) { json += out; });
+	luco::parser::parse(raw_luco).dump_to_json([&](std::string out) { expected_json += out; });
+	EXPECT_EQ(json, expected_json);
+
+	std::string raw_luco_out;
+	luco::transcoder::json_to_luco(R"""({"b": [1, "x y"], "a": {"q\"uote": "back\\slash", "n": null}})""",
+				       [&](std::string out) { raw_luco_out += out; });
+	EXPECT_EQ(raw_luco_out, "b {\n        1\n        \"x y\"\n    }\na {\n        'q\"uote' = \"back\\\\slash\"\n        n = null\n    }\n");
+
+	// JSON -> luco -> parser::parse() keeps every string the parser can read, the others are errors
+	std::string tricky_json =
+	    R"""({"a": "x # y", "b": "", "c": "it's \"quoted\"", "d": "{{ open", "k=ey": "back\\slash", "e": ["", "#", "a{b"], "f": "5"})""";
+	raw_luco_out.clear();
+	luco::transcoder::json_to_luco(tricky_json, [&](std::string out) { raw_luco_out += out; });
+	luco::node from_json = luco::parser::parse_json(tricky_json);
+	luco::node reparsed  = luco::parser::parse(raw_luco_out);
+	for (const char* key : {"a", "b", "c", "d", "k=ey"})
+	{
+		EXPECT_EQ(reparsed.at(key).as_string(), from_json.at(key).as_string()) << key;
+	}
+	EXPECT_EQ(reparsed.at("e").at(0).as_string(), "");
+	EXPECT_EQ(reparsed.at("e").at(1).as_string(), "#");
+	EXPECT_EQ(reparsed.at("e").at(2).as_string(), "a{b");
+	EXPECT_EQ(reparsed.at("f").as_integer(), 5); // like dump_to_luco(), a string that reads as a number becomes one
+
+	for (const char* unrepresentable : {R"""({"a": "x = y"})""", R"""({"a": "a}b"})""", R"""({"a}": 1})""", R"""({"a": "99999999999999999999"})"""})
+	{
+		EXPECT_FALSE(luco::transcoder::try_json_to_luco(unrepresentable, [](std::string) {})) << unrepresentable;
+	}
+
+	// luco -> JSON rejects and unescapes what the parser does
+	EXPECT_FALSE(luco::transcoder::try_luco_to_json("d = \"x = y\"\n", [](std::string) {}));
+	json.clear();
+	luco::transcoder::luco_to_json("k = \"a#b\" # comment\n'q\"uote' = 'it''s'\n", [&](std::string out) { json += out; });
+	EXPECT_EQ(luco::parser::parse_json(json).at("k").as_string(), "a#b");
+	EXPECT_EQ(luco::parser::parse_json(json).at("q\"uote").as_string(), "it's");
+
+	EXPECT_FALSE(luco::transcoder::try_json_to_luco("[1, 2]", [](std::string) {}));
+	EXPECT_FALSE(luco::transcoder::try_json_to_luco(R"""({"a": "two\nlines"})""", [](std::string) {}));
+	EXPECT_FALSE(luco::transcoder::try_json_to_luco(R"""({"a": [1,]})""", [](std::string) {}));
+	EXPECT_FALSE(luco::transcoder::try_luco_to_json("a {\n\t1\n\tb = 2\n}\n", [](std::string) {}));
+	EXPECT_THROW(luco::transcoder::luco_to_json("a {\n", [](std::string) {}), luco::error);
+
+	// a continuation the text ends in stops the transcoder with an error like the parser, instead of looping
+	for (const char* truncated : {"y{\t{3\n}}2{y\\\n", "k {\n\t1 \\\n", "k = 1 \\\n"})
+	{
+		EXPECT_FALSE(luco::parser::try_parse(truncated)) << truncated;
+		EXPECT_FALSE(luco::transcoder::try_luco_to_json(truncated, [](std::string) {})) << truncated;
+	}
+	json.clear();
+	luco::transcoder::luco_to_json("k {\n\t1 \\\n\t2\n}\n", [&](std::string out) { json += out; });
+	EXPECT_EQ(luco::parser::parse_json(json).at("k").at(0).as_string(), "1 2");
+
+	// a file spanning many blocks goes JSON -> luco -> JSON without changing
+	std::filesystem::path dir = std::filesystem::temp_directory_path() / "luco_transcoder_test";
+	std::filesystem::create_directories(dir);
+	{
+		std::ofstream file(dir / "in.json");
+		file << "{";
+		for (int i = 0; i < 5000; i++)
+		{
+			file << (i == 0 ? "" : ",") << "\n\"key" << i << "\": {\"s\": \"\\\"q\\\" \\u00e9 {x\", \"v\": [" << i
+			     << ", 0.5, true]}";
+		}
+		file << "\n}\n";
+	}
+
+	std::ofstream luco_file(dir / "out.luco");
+	luco::transcoder::json_to_luco(dir / "in.json", [&](std::string out) { luco_file << out; });
+	luco_file.close();
+
+	std::ofstream json_file(dir / "out.json");
+	luco::transcoder::luco_to_json(dir / "out.luco", [&](std::string out) { json_file << out; });
+	json_file.close();
+
+	luco::node original  = luco::parser::parse_json(dir / "in.json");
+	luco::node converted = luco::parser::parse_json(dir / "out.json");
+	EXPECT_EQ(converted.at("key4999").at("s").as_string(), "\"q\" \u00e9 {x");
+	EXPECT_EQ(converted.dump_to_string(), original.dump_to_string());
+
+	std::filesystem::remove_all(dir);
+}
+
+TEST_F(luco_test, async_parse)
+{
+	struct detached_task {
+			struct promise_type {
+					detached_task get_return_object()
+					{
+						return {};
+					}
+
+					std::suspend_never initial_suspend() noexcept
+					{
+						return {};
+					}
+
+					std::suspend_never final_suspend() noexcept
+					{
+						return {};
+					}
+
+					void return_void()
+					{
+					}
+
+					void unhandled_exception()
+					{
+						std::terminate();
+					}
+			};
+	};
+
+	// stands in for an event loop, the coroutine has to be resumed on the thread running it
+	struct event_loop : public luco::executor {
+			std::mutex			  mutex;
+			std::condition_variable		  ready;
+			std::deque<std::function<void()>> jobs;
+
+			void post(std::function<void()> job) override
+			{
+				std::lock_guard lock(mutex);
+				jobs.push_back(std::move(job));
+				ready.notify_one();
+			}
+
+			void run_one()
+			{
+				std::unique_lock lock(mutex);
+				ready.wait(lock, [this]() { return not jobs.empty(); });
+				auto job = std::move(jobs.front());
+				jobs.pop_front();
+				lock.unlock();
+				job();
+			}
+	};
+
+	std::filesystem::path path = std::filesystem::temp_directory_path() / "luco_async_parse_test.luco";
+	{
+		std::ofstream file(path);
+		for (int i = 0; i < 100000; i++)
+		{
+			file << "key" << i << " {\n\tvalue = " << i << "\n}\n";
+		}
+		file << "last = true";
+	}
+
+	event_loop					       loop;
+	std::optional<luco::expected<luco::node, luco::error>> result;
+	std::thread::id					       resumed_on;
+	auto reload = [&](std::filesystem::path file) -> detached_task
+	{
+		result.emplace(co_await luco::async_parse(file, loop));
+		resumed_on = std::this_thread::get_id();
+	};
+
+	reload(path);
+	loop.run_one();
+	ASSERT_TRUE(result.has_value() && result->has_value());
+	EXPECT_EQ(resumed_on, std::this_thread::get_id());
+	EXPECT_EQ(result->value().at("key99999").at("value").as_integer(), 99999);
+	EXPECT_TRUE(result->value().at("last").as_boolean());
+
+	reload(path.string() + ".missing");
+	loop.run_one();
+	ASSERT_TRUE(result.has_value());
+	EXPECT_FALSE(result->has_value());
+
+	// without an executor the coroutine resumes on the I/O thread
+	std::promise<std::thread::id> done;
+	auto reload_anywhere = [&]() -> detached_task
+	{
+		auto node = co_await luco::async_parse(path);
+		EXPECT_TRUE(node);
+		done.set_value(std::this_thread::get_id());
+	};
+	reload_anywhere();
+	EXPECT_NE(done.get_future().get(), std::this_thread::get_id());
+
+	std::filesystem::remove(path);
+}
+
+TEST_F(luco_test, parse_streams)
+{
+	std::string raw_luco;
+	for (int i = 0; i < 300; i++)
+	{
+		raw_luco += std::format("key{} {{\n\tvalue = {}\n\tname = \"n{}\" # comment\n}}\n", i, i, i);
+	}
+	raw_luco += "last = true\n";
+	luco::node expected = luco::parser::parse(raw_luco);
+
+	// odd block sizes split lines and tokens between reads
+	for (size_t block_size : {size_t(1), size_t(7), luco::parser::default_block_size})
+	{
+		std::istringstream stream(raw_luco);
+		auto		   node = luco::parser::try_parse(stream, block_size);
+		ASSERT_TRUE(node) << node.error().message();
+		EXPECT_EQ(node.value().dump_to_string(), expected.dump_to_string());
+	}
+
+	std::FILE* file = std::tmpfile();
+	ASSERT_NE(file, nullptr);
+	std::fwrite(raw_luco.data(), 1, raw_luco.size(), file);
+	std::rewind(file);
+	EXPECT_EQ(luco::parser::parse(file, 100).dump_to_string(), expected.dump_to_string());
+	std::fclose(file);
+
+	std::istringstream invalid("a = 1\nb = = 2\n");
+	luco::expected<luco::node, luco::error> error = luco::parser::try_parse(invalid, 3);
+	ASSERT_FALSE(error);
+	EXPECT_NE(error.error().message().find("2:"), std::string::npos);
+
+#if not defined(_WIN32)
+	int fds[2];
+	ASSERT_EQ(pipe(fds), 0);
+	std::thread writer(
+	    [&]()
+	    {
+		    // written in small pieces so the reader sees short reads
+		    for (size_t i = 0; i < raw_luco.size(); i += 1000)
+		    {
+			    size_t size = std::min<size_t>(1000, raw_luco.size() - i);
+			    EXPECT_EQ(write(fds[1], raw_luco.data() + i, size), static_cast<ssize_t>(size));
+		    }
+		    close(fds[1]);
+	    });
+	auto node = luco::parser::try_parse_fd(fds[0]);
+	writer.join();
+	close(fds[0]);
+	ASSERT_TRUE(node);
+	EXPECT_EQ(node.value().dump_to_string(), expected.dump_to_string());
+#endif
+}
+
+TEST_F(luco_test, validate_utf8)
+{
+	const std::string valid = "name = \"caf\xC3\xA9 \xE2\x82\xAC \xF0\x9F\x98\x80\"\n"
+				  "plain = just ascii, long enough to go through the vector loop\n";
+	luco::parse_options options;
+	options.validate_utf8 = true;
+
+	auto node = luco::parser::try_parse(valid, options);
+	ASSERT_TRUE(node) << node.error().message();
+	EXPECT_EQ(node.value().at("name").as_string(), "caf\xC3\xA9 \xE2\x82\xAC \xF0\x9F\x98\x80");
+
+	const std::vector<std::string> invalid = {
+	    "\x80",		 // stray continuation byte
+	    "\xC3",		 // cut short
+	    "\xC0\xAF",	 // overlong '/'
+	    "\xED\xA0\x80",	 // surrogate
+	    "\xF4\x90\x80\x80", // above U+10FFFF
+	    "\xFF",
+	};
+	for (const std::string& bytes : invalid)
+	{
+		std::string text = "a = 1\nkey = \"0123456789012345678901234567890123456789" + bytes + "\"\n";
+		EXPECT_TRUE(luco::parser::try_parse(text)) << "validation is off by default";
+
+		auto error = luco::parser::try_parse(text, options);
+		ASSERT_FALSE(error);
+		EXPECT_NE(error.error().message().find("2:48"), std::string::npos) << error.error().message();
+		EXPECT_NE(error.error().message().find("invalid UTF-8"), std::string::npos);
+	}
+
+	std::ofstream file("utf8.luco");
+	file << "a {\n\tb = \"\xC3\x28\"\n}\n";
+	file.close();
+	auto from_file = luco::parser::try_parse(std::filesystem::path("utf8.luco"), options);
+	ASSERT_FALSE(from_file);
+	EXPECT_NE(from_file.error().message().find("2:7"), std::string::npos) << from_file.error().message();
+	std::filesystem::remove("utf8.luco");
+}
+
+TEST_F(luco_test, skip_comments)
+{
+	std::string padding(100, 'x');
+	std::string raw_luco = "# " + padding + " # another # on the same line\n"
+			       "a = 1 # " + padding + "\n"
+			       "#{ " + padding + "\n"
+			       "\tinner {\n\t\tb = 2\n\t}\n"
+			       "\t{{ escaped " + padding + "\n"
+			       "}\n"
+			       "c = 3 #{ one line " + padding + " }\n"
+			       "# a line comment turned nested by { " + padding + "\n"
+			       "d = 4\n"
+			       "}\n"
+			       "e {\n\t# " + padding + "\n\tf = 5\n}\n";
+
+	for (const luco::node& node : {luco::parser::parse(raw_luco), luco::parser::parse(raw_luco, luco::projection{{"a"}, {"c"}, {"e"}})})
+	{
+		EXPECT_EQ(node.at("a").as_integer(), 1);
+		EXPECT_EQ(node.at("c").as_integer(), 3);
+		EXPECT_EQ(node.at("e").at("f").as_integer(), 5);
+		EXPECT_FALSE(node.contains("inner"));
+		EXPECT_FALSE(node.contains("b"));
+		EXPECT_FALSE(node.contains("d"));
+		EXPECT_EQ(node.as_object()->size(), 3);
+	}
+}
+
+TEST_F(luco_test, long_strings)
+{
+	std::string certificate;
+	for (int i = 0; i < 64; i++)
+	{
+		certificate += "MIIDdzCCAl+gAwIBAgIEAgAAuTANBgkqhkiG9w0BAQUFADBaMQswCQYDVQQGEwJJ";
+	}
+
+	std::string raw_luco = "quoted = \"" + certificate + "\"\n"
+			       "single = '" + certificate + "'\n"
+			       "unquoted = " + certificate + "   \n"
+			       "escaped = \"" + certificate + "\"\"quote\"\" {{ " + certificate + "\"\n"
+			       "multi_line = \"" + certificate + "\" \\\n"
+			       "\t\"" + certificate + "\"\n"
+			       "long_key_" + certificate + " = 1\n"
+			       "comment = " + certificate + " # " + certificate + "\n";
+
+	luco::node node = luco::parser::parse(raw_luco);
+	EXPECT_EQ(node.at("quoted").as_string(), certificate);
+	EXPECT_EQ(node.at("single").as_string(), certificate);
+	EXPECT_EQ(node.at("unquoted").as_string(), certificate);
+	EXPECT_EQ(node.at("escaped").as_string(), certificate + "\"quote\" { " + certificate);
+	EXPECT_EQ(node.at("multi_line").as_string(), certificate + certificate);
+	EXPECT_EQ(node.at("long_key_" + certificate).as_integer(), 1);
+	EXPECT_EQ(node.at("comment").as_string(), certificate);
+}
+
+TEST_F(luco_test, schema_directed_parsing)
+{
+	luco::schema types = {
+	    {{"server", "port"}, luco::value_type::integer},
+	    {{"server", "name"}, luco::value_type::string},
+	    {{"server", "ratio"}, luco::value_type::double_t},
+	    {{"server", "offset"}, luco::value_type::integer},
+	    {{"server", "debug"}, luco::value_type::boolean},
+	    {{"replicas", luco::schema::element, "weight"}, luco::value_type::number},
+	    {{"tags", luco::schema::element}, luco::value_type::string},
+	};
+	EXPECT_EQ(types.type_of({"server", "port"}), luco::value_type::integer);
+	EXPECT_EQ(types.type_of({"server"}), std::nullopt);
+
+	const std::string raw_luco = "server {\n"
+				     "\tport = 8080\n"
+				     "\tname = \"5\"\n"
+				     "\tratio = 2\n"
+				     "\toffset = -5\n"
+				     "\tdebug = off\n"
+				     "\tother = 12\n"
+				     "}\n"
+				     "replicas {\n"
+				     "\t{\n\t\tweight = 1\n\t}\n"
+				     "\t{\n\t\tweight = 0.5\n\t}\n"
+				     "}\n"
+				     "tags {\n\ttrue\n\t12\n}\n";
+
+	luco::parse_options options;
+	options.schema = &types;
+	auto node = luco::parser::try_parse(raw_luco, options);
+	ASSERT_TRUE(node) << node.error().message();
+
+	luco::node& server = node.value().at("server");
+	EXPECT_EQ(server.at("port").as_integer(), 8080);
+	EXPECT_EQ(server.at("name").as_string(), "5");
+	EXPECT_EQ(server.at("ratio").as_value()->type(), luco::value_type::double_t);
+	EXPECT_EQ(server.at("offset").as_integer(), -5);
+	EXPECT_FALSE(server.at("debug").as_boolean());
+	EXPECT_EQ(server.at("other").as_integer(), 12); // not declared, still inferred
+	EXPECT_EQ(node.value().at("replicas").at(0).at("weight").as_integer(), 1);
+	EXPECT_EQ(node.value().at("replicas").at(1).at("weight").as_value()->type(), luco::value_type::double_t);
+	EXPECT_EQ(node.value().at("tags").at(0).as_string(), "true");
+	EXPECT_EQ(node.value().at("tags").at(1).as_string(), "12");
+
+	EXPECT_FALSE(luco::parser::try_parse(raw_luco).value().at("server").at("name").is_string());
+
+	auto mismatch = luco::parser::try_parse("server {\n\tport = eighty\n}\n", options);
+	ASSERT_FALSE(mismatch);
+	EXPECT_EQ(mismatch.error().value(), luco::error_type::parsing_error_wrong_type);
+	EXPECT_NE(mismatch.error().message().find("2:"), std::string::npos);
+	EXPECT_NE(mismatch.error().message().find("expected an integer but found 'eighty'"), std::string::npos);
+
+	auto container = luco::parser::try_parse("server {\n\tport {\n\t\ta = 1\n\t}\n}\n", options);
+	ASSERT_FALSE(container);
+	EXPECT_EQ(container.error().value(), luco::error_type::parsing_error_wrong_type);
+
+	std::ofstream file("schema.luco");
+	file << raw_luco;
+	file.close();
+	auto from_file = luco::parser::try_parse(std::filesystem::path("schema.luco"), options);
+	ASSERT_TRUE(from_file);
+	EXPECT_EQ(from_file.value().dump_to_string(), node.value().dump_to_string());
+	std::filesystem::remove("schema.luco");
+}
+
+TEST_F(luco_test, schema_validation)
+{
+	const std::string definition = "keys {\n"
+				       "\tserver {\n"
+				       "\t\trequired = true\n"
+				       "\t\tclosed = true\n"
+				       "\t\tkeys {\n"
+				       "\t\t\tport {\n\t\t\t\ttype = integer\n\t\t\t\trequired = true\n\t\t\t\tmin = 1\n\t\t\t\tmax = 65535\n\t\t\t}\n"
+				       "\t\t\tmode {\n\t\t\t\tenum {\n\t\t\t\t\tfast\n\t\t\t\t\tsafe\n\t\t\t\t}\n\t\t\t}\n"
+				       "\t\t\tname {\n\t\t\t\tpattern = \"^[a-z][a-z0-9-]*$\"\n\t\t\t}\n"
+				       "\t\t}\n"
+				       "\t}\n"
+				       "\treplicas {\n"
+				       "\t\tmax = 2\n"
+				       "\t\telements {\n\t\t\tkeys {\n\t\t\t\tweight {\n\t\t\t\t\ttype = number\n\t\t\t\t\tmin = 0\n\t\t\t\t}\n\t\t\t}\n\t\t}\n"
+				       "\t}\n"
+				       "}\n";
+	auto rules = luco::schema::try_parse(definition);
+	ASSERT_TRUE(rules) << rules.error().message();
+	EXPECT_EQ(rules.value().type_of({"server", "port"}), luco::value_type::integer);
+
+	luco::parse_options options;
+	options.schema = &rules.value();
+	auto valid = [&](const std::string& raw_luco) -> std::pair<std::string, std::string>
+	{
+		auto parsed = luco::parser::try_parse(raw_luco, options);
+		auto tree   = luco::parser::try_parse(raw_luco);
+		EXPECT_TRUE(tree) << raw_luco;
+		auto validated = rules.value().try_validate(tree.value());
+		return {parsed ? "" : parsed.error().message(), validated ? "" : validated.error().message()};
+	};
+
+	auto ok = valid("server {\n\tport = 8080\n\tmode = fast\n\tname = web-1\n}\n"
+			"replicas {\n\t{\n\t\tweight = 1\n\t}\n\t{\n\t\tweight = 0.5\n\t}\n}\n");
+	EXPECT_EQ(ok.first, "");
+	EXPECT_EQ(ok.second, "");
+
+	const std::vector<std::pair<std::string, std::string>> broken = {
+	    {"server {\n\tport = 70000\n}\n", "server.port: expected at most 65535 but found 70000"},
+	    {"server {\n\tport = 80\n\tmode = slow\n}\n", "server.mode: expected one of fast, safe but found 'slow'"},
+	    {"server {\n\tport = 80\n\tname = Web\n}\n", "server.name: 'Web' doesn't match the pattern '^[a-z][a-z0-9-]*$'"},
+	    {"server {\n\tmode = fast\n}\n", "server: missing the required key 'port'"},
+	    {"server {\n\tport = 80\n\tother = 1\n}\n", "server: the key 'other' isn't allowed"},
+	    {"other = 1\n", "the root: missing the required key 'server'"},
+	    {"server = 5\n", "server: expected an object but found an integer '5'"},
+	    {"server {\n\tport = 80\n}\nreplicas {\n\t{\n\t\tweight = 1\n\t}\n\t{\n\t\tweight = heavy\n\t}\n}\n",
+	     "replicas[1].weight: expected a number but found a string 'heavy'"},
+	    {"server {\n\tport = 80\n}\nreplicas {\n\t{\n\t\tweight = 1\n\t}\n\t{\n\t\tweight = 2\n\t}\n\t{\n\t\tweight = 3\n\t}\n}\n",
+	     "replicas: expected at most 2 elements but found 3"},
+	};
+	for (const auto& [raw_luco, why] : broken)
+	{
+		auto [parsing, validating] = valid(raw_luco);
+		EXPECT_EQ(validating, why);
+		EXPECT_NE(parsing, "");
+		// while parsing, a value is checked before it's converted to a string
+		const std::string reason = why.find("weight") == std::string::npos ? why.substr(why.find(": ") + 2)
+										     : "expected a number but found 'heavy'";
+		EXPECT_NE(parsing.find(reason), std::string::npos) << parsing;
+	}
+
+	// std::regex recurses once per character, a long string is reported instead of overflowing the stack
+	auto long_name = rules.value().try_validate(
+	    luco::parser::parse("server {\n\tport = 80\n\tname = " + std::string(50000, 'a') + "\n}\n"));
+	ASSERT_FALSE(long_name);
+	EXPECT_EQ(long_name.error().message(),
+		  "server.name: a string of 50000 characters is too long to match the pattern '^[a-z][a-z0-9-]*$'");
+	EXPECT_TRUE(rules.value().try_validate(luco::parser::parse(
+	    "server {\n\tport = 80\n\tname = " + std::string(luco::schema::pattern_limit, 'a') + "\n}\n")));
+
+	auto null_rule = luco::schema::try_parse("keys {\n\ta {\n\t\ttype = null\n\t}\n}\n");
+	ASSERT_TRUE(null_rule) << null_rule.error().message();
+	EXPECT_EQ(null_rule.value().type_of({"a"}), luco::value_type::null);
+	EXPECT_TRUE(null_rule.value().try_validate(luco::parser::parse("a = null\n")));
+	EXPECT_FALSE(null_rule.value().try_validate(luco::parser::parse("a = 1\n")));
+
+	auto located = luco::parser::try_parse("server {\n\tport = 0\n}\n", options);
+	ASSERT_FALSE(located);
+	EXPECT_EQ(located.error().value(), luco::error_type::schema_violation);
+	EXPECT_NE(located.error().message().find("2:"), std::string::npos);
+
+	EXPECT_FALSE(luco::schema::try_parse("keys {\n\ta {\n\t\tminimum = 1\n\t}\n}\n"));
+	EXPECT_FALSE(luco::schema::try_parse("keys {\n\ta {\n\t\ttype = text\n\t}\n}\n"));
+	EXPECT_FALSE(luco::schema::try_parse("keys {\n\ta {\n\t\tpattern = \"[a-\"\n\t}\n}\n"));
+	EXPECT_THROW(luco::schema::parse("keys {\n\ta {\n\t\ttype = integer\n\t\tkeys {\n\t\t\tb {\n\t\t\t}\n\t\t}\n\t}\n}\n"),
+		     luco::error);
+}
+
+TEST_F(luco_test, codegen)
+{
+	auto sample = luco::parser::try_parse("server {\n\tport = 80\n\tmode = fast\n\tname = x\n\tdebug = on\n}\nweights {\n\t1\n\t2.5\n}\n"
+					      "\"a key\" = x\n");
+	ASSERT_TRUE(sample);
+	luco::schema inferred = luco::schema::infer(sample.value());
+	EXPECT_EQ(inferred.type_of({"server", "port"}), luco::value_type::integer);
+	EXPECT_EQ(inferred.type_of({"weights", luco::schema::element}), luco::value_type::number);
+
+	std::string header = luco::codegen(inferred, "settings", "app").generate();
+	EXPECT_NE(header.find("namespace app\n"), std::string::npos);
+	EXPECT_NE(header.find("\tstruct settings_server {\n\t\tbool debug = false;\n\t\tstd::string mode;\n\t\tstd::string name;\n\t\tint64_t port = 0;\n\t};"),
+		  std::string::npos);
+	EXPECT_NE(header.find("\t\tstd::string a_key;\n"), std::string::npos);
+	EXPECT_NE(header.find("\t\tstd::vector<double> weights;\n"), std::string::npos);
+	EXPECT_NE(header.find("switch (key[0])"), std::string::npos); // mode, name and port differ in their first character
+	EXPECT_NE(header.find("luco::expected<settings, luco::error> try_parse_settings(std::string_view text)"), std::string::npos);
+	EXPECT_NE(header.find("inline std::string dump_settings(const settings& value"), std::string::npos);
+
+	luco::typed_reader reader("ports {\n\t80\n\t443\n}\nflags {\n\ton\n\toops\n}\n");
+	auto		   item = reader.next(0, luco::scanner::incomplete, true);
+	ASSERT_TRUE(item);
+	EXPECT_EQ(reader.key(item.value()), "ports");
+	std::vector<int64_t> ports;
+	auto		     end = reader.read(item.value(), ports);
+	ASSERT_TRUE(end);
+	EXPECT_EQ(ports, std::vector<int64_t>({80, 443}));
+
+	item = reader.next(end.value(), luco::scanner::incomplete, true);
+	ASSERT_TRUE(item);
+	std::vector<std::string> texts;
+	EXPECT_TRUE(reader.read(item.value(), texts));
+	std::vector<int64_t> integers;
+	auto		     broken = reader.read(item.value(), integers);
+	ASSERT_FALSE(broken);
+	EXPECT_EQ(broken.error().message(), "line 6: expected an integer but found 'on'");
+
+	luco::typed_writer writer({'\t', 1});
+	writer.write("ports", ports);
+	writer.write("name", std::string("a \"b\""));
+	EXPECT_EQ(writer.text(), "ports {\n\t80\n\t443\n}\nname = 'a \"b\"'\n");
+	EXPECT_TRUE(writer.status());
+	writer.write("broken", std::string("a\nb"));
+	EXPECT_FALSE(writer.status());
+
+	// generated_settings.hpp is this schema's header, compiled into the tests
+	luco::schema settings_rules = luco::schema::parse("keys {\n"
+							  "\tserver {\n"
+							  "\t\tkeys {\n"
+							  "\t\t\tname {\n\t\t\t\ttype = string\n\t\t\t}\n"
+							  "\t\t\tport {\n\t\t\t\ttype = integer\n\t\t\t}\n"
+							  "\t\t\tratio {\n\t\t\t\ttype = double\n\t\t\t}\n"
+							  "\t\t\tdebug {\n\t\t\t\ttype = boolean\n\t\t\t}\n"
+							  "\t\t}\n"
+							  "\t}\n"
+							  "\ttags {\n\t\telements {\n\t\t\ttype = string\n\t\t}\n\t}\n"
+							  "\t\"a key\" {\n\t\ttype = string\n\t}\n"
+							  "}\n");
+	std::ifstream	  generated_file(std::filesystem::path(__FILE__).parent_path() / "generated_settings.hpp");
+	std::stringstream generated_text;
+	generated_text << generated_file.rdbuf();
+	EXPECT_EQ(generated_text.str(), luco::codegen(settings_rules, "settings", "generated").generate());
+
+	generated::settings settings;
+	settings.a_key	      = "it's \"quoted\" {open # not a comment \\ slash";
+	settings.server.name  = "web one";
+	settings.server.port  = 8080;
+	settings.server.ratio = 0.1;
+	settings.server.debug = true;
+	settings.tags	      = {"", "#", "a{b", "5"};
+	std::string dumped = generated::dump_settings(settings);
+	luco::node  tree   = luco::parser::parse(dumped);
+	EXPECT_EQ(tree.at("a key").as_string(), settings.a_key);
+	EXPECT_EQ(tree.at("server").at("name").as_string(), "web one");
+	EXPECT_EQ(tree.at("server").at("ratio").as_double(), 0.1);
+	EXPECT_EQ(tree.at("tags").at(2).as_string(), "a{b");
+	EXPECT_EQ(tree.at("tags").at(3).as_integer(), 5); // the parser doesn't know the schema, "5" reads as a number
+
+	generated::settings read = generated::parse_settings(dumped);
+	EXPECT_EQ(read.a_key, settings.a_key);
+	EXPECT_EQ(read.server.name, settings.server.name);
+	EXPECT_EQ(read.server.port, settings.server.port);
+	EXPECT_EQ(read.server.ratio, settings.server.ratio);
+	EXPECT_EQ(read.server.debug, settings.server.debug);
+	EXPECT_EQ(read.tags, settings.tags);
+
+	settings.server.name = "x = y";
+	auto unwritable	     = generated::try_dump_settings(settings);
+	ASSERT_FALSE(unwritable);
+	EXPECT_EQ(unwritable.error().message(), "the string 'x = y' can't be written in luco");
+	EXPECT_THROW(generated::dump_settings(settings), luco::error);
+}
+
+TEST_F(luco_test, static_document)
+{
+	using namespace luco::literals;
+	using defaults = luco::static_document<"server {\n\tport = 8080\n\tname = \"web one\"\n\tratio = 0.25\n\tdebug = on\n}\n"
+					       "ports {\n\t80\n\t443\n\tnull\n}\n">;
+	static_assert(defaults::root().at("server").at("port").as_integer() == 8080);
+	static_assert(defaults::root().at("server").at("name").as_string() == "web one");
+	static_assert(defaults::root().at("server").at("ratio").as_double() == 0.25);
+	static_assert(defaults::root().at("server").at("debug").as_boolean());
+	static_assert(defaults::root().at("ports").size() == 3 && defaults::root().at("ports").at(2).is_null());
+
+	constexpr luco::static_node limits = "b {\n\tc = x\n}\na = 1\n"_luco;
+	static_assert(limits.contains("a") && not limits.contains("z"));
+	static_assert(limits.begin() != limits.end() && (*limits.begin()).key() == "a"); // members are sorted by key
+	EXPECT_THROW(limits.at("z"), luco::error);
+	EXPECT_THROW(limits.at("a").as_string(), luco::error);
+
+	std::string text = "ports {\n\t80\n\t443\n\tnull\n}\nserver {\n\tdebug = true\n\tname = \"web one\"\n\tport = 8080\n\tratio = "
+			   "0.25\n}\n";
+	EXPECT_EQ(defaults::root().to_node().dump_to_string(), luco::parser::parse(text).dump_to_string());
+
+	// doubles are rounded once, to the nearest like std::from_chars()
+	constexpr luco::static_node numbers = "pi = 3.14159265358979323846\ntenth = 0.1\nbig = 123456789012345678.5\n"
+					      "tie = 9007199254740993.0\nsmall = 0.00000000000000000000000000123\n"_luco;
+	static_assert(numbers.at("pi").as_double() == 3.14159265358979323846);
+	static_assert(numbers.at("tenth").as_double() == 0.1);
+	static_assert(numbers.at("big").as_double() == 123456789012345678.5);
+	static_assert(numbers.at("tie").as_double() == 9007199254740992.0); // halfway, to the even mantissa
+	static_assert(numbers.at("small").as_double() == 1.23e-27);
+
+	luco::static_parsing parsing;
+	ASSERT_TRUE(parsing.parse("max = " + std::format("{:.1f}", std::numeric_limits<double>::max()) + "\ntiny = 0." + std::string(323, '0') +
+				  "5\n"));
+	EXPECT_EQ(parsing.entries[parsing.entries.front().first].number, std::numeric_limits<double>::max());
+	EXPECT_EQ(parsing.entries[parsing.entries.front().first + 1].number, std::numeric_limits<double>::denorm_min());
+}
+
+TEST_F(luco_test, embed)
+{
+	std::string text = "server {\n\tport = 8080\n\tname = web\n}\nratios {\n\t0.5\n\t2\n}\n";
+	luco::embed defaults(text, "defaults", "app");
+	std::string header = defaults.generate();
+	EXPECT_NE(header.find("namespace app\n"), std::string::npos);
+	EXPECT_NE(header.find("inline constexpr luco::static_entry defaults_entries[] = {\n"
+			      "\t\t{luco::node_type::object, luco::value_type::none, 0, 0, 1, 2, 0, 0.0},\n"),
+		  std::string::npos);
+	EXPECT_NE(header.find("{luco::node_type::value, luco::value_type::double_t, 0, 0, 0, 0, 0, 0.5},"), std::string::npos);
+	EXPECT_NE(header.find("inline constexpr char defaults_chars[] = \"serverportnamewebratios\";"), std::string::npos);
+	EXPECT_NE(header.find("constexpr luco::static_node defaults() noexcept"), std::string::npos);
+	EXPECT_NE(defaults.generate_embed("defaults.img").find("#embed \"defaults.img\"\n"), std::string::npos);
+
+	std::string			image = defaults.image();
+	std::vector<luco::static_entry> aligned(image.size() / sizeof(luco::static_entry) + 1);
+	std::memcpy(aligned.data(), image.data(), image.size());
+	std::span<const unsigned char> bytes(reinterpret_cast<const unsigned char*>(aligned.data()), image.size());
+	luco::static_node		root = luco::static_image::open(bytes);
+	EXPECT_EQ(root.at("server").at("port").as_integer(), 8080);
+	EXPECT_EQ(root.at("ratios").at(0).as_double(), 0.5);
+#ifdef LUCO_ORDERED_OBJECTS
+	// the keys of a static document are stored sorted
+	EXPECT_EQ(root.to_node().dump_to_string(),
+		  luco::parser::parse("ratios {\n\t0.5\n\t2\n}\nserver {\n\tname = web\n\tport = 8080\n}\n").dump_to_string());
+#else
+	EXPECT_EQ(root.to_node().dump_to_string(), luco::parser::parse(text).dump_to_string());
+#endif
+
+	EXPECT_FALSE(luco::static_image::try_open(bytes.first(bytes.size() - 1)));
+	reinterpret_cast<unsigned char*>(aligned.data())[sizeof(luco::static_image::header) + 16] = 0xff; // the first child
+	EXPECT_FALSE(luco::static_image::try_open(bytes));
+	EXPECT_FALSE(luco::embed("a = 1\na = 2\n", "defaults").try_image());
+	EXPECT_FALSE(luco::embed(text, "2nd").try_generate());
+}
+
+TEST_F(luco_test, at_key_literal)
+{
+	luco::node node = luco::parser::parse("server {\n\tport = 8080\n\ta_rather_long_key_name = x\n}\nlist {\n\t1\n}\n");
+	EXPECT_EQ(node.at<"server">().at<"port">().as_integer(), 8080);
+	EXPECT_EQ(&node.at<"server">().at<"a_rather_long_key_name">(), &node.at("server").at("a_rather_long_key_name"));
+
+	node.at<"server">().at<"port">() = 9090;
+	EXPECT_EQ(node.at("server").at("port").as_integer(), 9090);
+
+	auto missing = node.try_at<"missing">();
+	ASSERT_FALSE(missing);
+	EXPECT_EQ(missing.error().message(), "key: 'missing' not found");
+	EXPECT_EQ(node.at<"list">().try_at<"x">().error().value(), luco::error_type::wrong_type);
+	EXPECT_THROW(node.at<"nope">(), luco::error);
+
+	using namespace luco::literals;
+	constexpr luco::static_node defaults = "server {\n\tport = 80\n}\n"_luco;
+	static_assert(defaults.at<"server">().at<"port">().as_integer() == 80);
+}
+
+TEST_F(luco_test, deferred_error_messages)
+{
+	luco::node node = luco::parser::parse("name = web\nratio = 2.0\ncount = 12\nlist {\n\t1\n}\n");
+	auto	   as_integer = node.at("name").try_as_integer();
+	ASSERT_FALSE(as_integer);
+	EXPECT_EQ(as_integer.error().value(), luco::error_type::wrong_type);
+	luco::error copy = as_integer.error();
+	EXPECT_EQ(copy.message(), "wrong type: trying to cast the value 'web' which is a 'string' to 'integer'");
+	EXPECT_STREQ(as_integer.error().what(), copy.message().c_str());
+	EXPECT_EQ(node.at("ratio").try_as_integer().error().message(),
+		  "wrong type: trying to cast the value '2.0' which is a 'double' to 'integer'");
+	EXPECT_EQ(node.at("count").try_as_boolean().error().message(),
+		  "wrong type: trying to cast the value '12' which is a 'integer' to 'boolean'");
+
+	// a double reads the same in the error as in stringify()
+	for (double number : {2.0, 0.1, 1e20, 1e-7, -2.5e15, 1.7976931348623157e308, 5e-324})
+	{
+		luco::value value(number);
+		EXPECT_EQ(value.try_as_string().error().message(),
+			  std::format("wrong type: trying to cast the value '{}' which is a 'double' to 'string'", value.stringify()));
+	}
+
+	std::string long_value(100, 'x');
+	luco::node  text(long_value);
+	EXPECT_EQ(text.try_as_double().error().message(),
+		  std::format("wrong type: trying to cast the value '{}' which is a 'string' to 'double'", long_value));
+
+	EXPECT_EQ(node.try_at("missing").error().message(), "key: 'missing' not found");
+	EXPECT_EQ(node.try_at(std::string(64, 'k')).error().message(), std::format("key: '{}' not found", std::string(64, 'k')));
+	EXPECT_EQ(node.at("list").try_at(5).error().message(), "index: '5' not found");
+	EXPECT_EQ(node.at("list").try_at(5).error().value(), luco::error_type::key_not_found);
+	EXPECT_EQ(node.try_as_array().error().message(), "wrong type: trying to cast a 'node object' node to an array");
+	EXPECT_EQ(node.at("list").try_as_value().error().message(), "wrong type: trying to cast a 'node array' node to a value");
+
+	// the first reader formats the message once, the others wait for it
+	const luco::error	 shared = node.try_at("missing").error();
+	std::vector<std::thread> readers;
+	std::vector<std::string> read(8);
+	for (size_t i = 0; i < read.size(); i++)
+	{
+		readers.emplace_back([&shared, &read, i]() { read[i] = i % 2 == 0 ? shared.message() : shared.what(); });
+	}
+	for (std::thread& reader : readers)
+	{
+		reader.join();
+	}
+	EXPECT_EQ(std::count(read.begin(), read.end(), "key: 'missing' not found"), 8);
+	EXPECT_EQ(luco::error(shared).message(), "key: 'missing' not found");
+}
+
+TEST_F(luco_test, no_throw_conversions)
+{
+	auto huge = luco::parser::try_parse(std::string("a = 1\nb = 99999999999999999999\n"));
+	ASSERT_FALSE(huge);
+	EXPECT_NE(huge.error().message().find("the number '99999999999999999999' is out of range"), std::string::npos);
+
+	luco::value value;
+	EXPECT_TRUE(value.set_value_type("12", luco::value_type::integer));
+	EXPECT_EQ(value.as_integer(), 12);
+	auto broken = value.set_value_type("12x", luco::value_type::integer);
+	ASSERT_FALSE(broken);
+	EXPECT_EQ(broken.error().message(), "'12x' isn't an integer");
+	EXPECT_TRUE(value.set_value_type("0.5", luco::value_type::double_t));
+	EXPECT_EQ(value.as_double(), 0.5);
+
+	luco::node node = luco::parser::parse(std::string("list {\n\t1\n}\n"));
+	EXPECT_THROW(node.as_object()->at("missing"), luco::error);
+	EXPECT_THROW(node.at("list").as_array()->at(3), luco::error);
+}
+
+TEST_F(luco_test, template_sinks_and_accessors)
+{
+	luco::node node = luco::parser::parse(std::string("count = 3\nlist {\n\t1\n}\n"));
+	struct counter {
+			size_t* bytes;
+
+			void operator()(const std::string& piece) const
+			{
+				*bytes += piece.size();
+			}
+	};
+	size_t bytes = 0;
+	node.dump_to_luco(counter{&bytes});
+	EXPECT_EQ(bytes, node.dump_to_string().size());
+
+	std::string json;
+	node.dump_to_json([&json](std::string piece) { json += piece; }, {' ', 2});
+	EXPECT_EQ(json, "{\n  \"count\": 3,\n  \"list\": [\n    1\n  ]\n}");
+
+	EXPECT_EQ(node.at("count").as_integer(), 3);
+	EXPECT_EQ(node.at("count").try_as_number().value(), 3.0);
+	EXPECT_EQ(node.at("list").try_as_integer().error().message(), "wrong type: trying to cast a 'node array' node to a value");
+}
+
+TEST_F(luco_test, visit)
+{
+	luco::node node = luco::parser::parse(std::string("name = web\nport = 80\nratio = 0.5\ndebug = on\nnothing = null\nlist {\n\t1\n\tx\n}\n"));
+	struct counter {
+			size_t objects = 0, arrays = 0, strings = 0, integers = 0, doubles = 0, booleans = 0, nulls = 0;
+
+			void operator()(luco::object& object)
+			{
+				objects++;
+				for (auto& [key, child] : object)
+				{
+					luco::visit(*this, child);
+				}
+			}
+
+			void operator()(luco::array& array)
+			{
+				arrays++;
+				for (auto& child : array)
+				{
+					luco::visit(*this, child);
+				}
+			}
+
+			void operator()(std::string& text)
+			{
+				strings++;
+				text += "!";
+			}
+
+			void operator()(int64_t& integer)
+			{
+				integers++;
+				integer *= 2;
+			}
+
+			void operator()(double)
+			{
+				doubles++;
+			}
+
+			void operator()(bool)
+			{
+				booleans++;
+			}
+
+			void operator()(luco::null_type)
+			{
+				nulls++;
+			}
+	};
+
+	counter count;
+	luco::visit(count, node);
+	EXPECT_EQ(count.objects, 1);
+	EXPECT_EQ(count.arrays, 1);
+	EXPECT_EQ(count.strings, 2);
+	EXPECT_EQ(count.integers, 2);
+	EXPECT_EQ(count.doubles, 1);
+	EXPECT_EQ(count.booleans, 1);
+	EXPECT_EQ(count.nulls, 1);
+	EXPECT_EQ(node.at("name").as_string(), "web!");
+	EXPECT_EQ(node.at("port").as_integer(), 160);
+	EXPECT_EQ(node.at("list").at(1).as_string(), "x!");
+
+	auto kind = [](auto& held) -> std::string
+	{
+		using held_t = std::decay_t<decltype(held)>;
+		if constexpr (std::is_same_v<held_t, luco::object>)
+		{
+			return "object";
+		}
+		else if constexpr (std::is_same_v<held_t, luco::array>)
+		{
+			return "array";
+		}
+		else if constexpr (std::is_same_v<held_t, luco::monostate>)
+		{
+			return "empty";
+		}
+		else
+		{
+			return "scalar";
+		}
+	};
+	EXPECT_EQ(luco::visit(kind, node), "object");
+	EXPECT_EQ(luco::visit(kind, node.at("list")), "array");
+	EXPECT_EQ(luco::visit(kind, node.at("ratio")), "scalar");
+	EXPECT_EQ(luco::visit(kind, luco::node(luco::node_type::value)), "empty");
+}
+
+TEST_F(luco_test, parallel_algorithms)
+{
+	auto inventory = []()
+	{
+		luco::node root;
+		luco::node hosts(luco::node_type::array);
+		for (int64_t i = 0; i < 5000; i++)
+		{
+			luco::node host;
+			host.insert("port", i);
+			host.insert("url", std::string("http://old.") + std::to_string(i));
+			hosts.push_back(host);
+		}
+		root.insert("hosts", hosts);
+
+		luco::node names;
+		for (int64_t i = 0; i < 2000; i++)
+		{
+			names.insert("n" + std::to_string(i), i);
+		}
+		root.insert("names", names);
+		return root;
+	};
+
+	luco::execution::parallel_policy par{.threads = 4, .grain = 64};
+	luco::node			 sequenced = inventory();
+	luco::node			 parallel  = inventory();
+	auto				 repoint   = [](luco::value& value) -> luco::value
+	{
+		if (value.is_string() && value.as_string().starts_with("http://old."))
+		{
+			return "http://new." + value.as_string().substr(11);
+		}
+		return value;
+	};
+
+	luco::transform_values(luco::execution::seq, sequenced, repoint);
+	luco::transform_values(par, parallel, repoint);
+	EXPECT_EQ(parallel.dump_to_string(), sequenced.dump_to_string());
+	EXPECT_EQ(parallel.at("hosts").at(4999).at("url").as_string(), "http://new.4999");
+
+	auto even = [](luco::value& value) { return value.is_integer() && value.as_integer() % 2 == 0; };
+	EXPECT_EQ(luco::count_if(par, parallel, even), 3500);
+	EXPECT_EQ(luco::count_if(luco::execution::seq, parallel, even), 3500);
+
+	std::atomic<size_t>	 values = 0;
+	std::vector<std::string> order;
+	luco::for_each(par, parallel, [&](luco::value&) { values++; });
+	luco::for_each(luco::execution::seq, parallel.at("names"), [&](luco::value& value) { order.push_back(std::to_string(value.as_integer())); });
+	EXPECT_EQ(values, 12000);
+	EXPECT_EQ(order[1], "1");
+#ifdef LUCO_ORDERED_OBJECTS
+	EXPECT_EQ(order[2], "2");
+#else
+	EXPECT_EQ(order[2], "10");
+#endif
+
+	EXPECT_THROW(luco::for_each(par, parallel, [](luco::value& value) { value.as_boolean(); }), luco::error);
+
+	// no container reaches the grain, the siblings of a big enough subtree are still shared with idle threads
+	luco::node nested(luco::node_type::array);
+	for (int64_t i = 0; i < 64; i++)
+	{
+		luco::node row(luco::node_type::array);
+		for (int64_t j = 0; j < 64; j++)
+		{
+			row.push_back(luco::node(i * 64 + j));
+		}
+		nested.push_back(row);
+	}
+	std::mutex		  mutex;
+	std::set<std::thread::id> walkers;
+	auto			  walked = [&](luco::value&)
+	{
+		std::this_thread::sleep_for(std::chrono::microseconds(10));
+		std::lock_guard lock(mutex);
+		walkers.insert(std::this_thread::get_id());
+	};
+	luco::for_each(luco::execution::parallel_policy{.threads = 4}, nested, walked);
+	EXPECT_GT(walkers.size(), 1);
+	EXPECT_EQ(luco::count_if(luco::execution::parallel_policy{.threads = 4}, nested, even), 2048);
+}
+
+TEST_F(luco_test, ordered_map)
+{
+	luco::ordered_map<int> map;
+	for (int i = 0; i < 100; i++)
+	{
+		map[std::to_string(99 - i)] = i;
+	}
+	map["50"] = -1;
+
+	EXPECT_EQ(map.size(), 100);
+	EXPECT_EQ(map.begin()->first, "99");
+	EXPECT_EQ(map.find("50")->second, -1);
+	EXPECT_EQ(map.find("50") - map.begin(), 49);
+	EXPECT_EQ(map.find("100"), map.end());
+
+	EXPECT_EQ(map.erase("99"), 1);
+	EXPECT_EQ(map.erase("99"), 0);
+	auto next = map.erase(map.find("0"));
+	EXPECT_EQ(next, map.end());
+	EXPECT_EQ(map.size(), 98);
+	EXPECT_EQ(map.begin()->first, "98");
+	for (int i = 1; i < 99; i++)
+	{
+		EXPECT_TRUE(map.contains(std::to_string(i)));
+	}
+
+	map.erase(map.begin() + 4, map.end());
+	std::string keys;
+	for (auto& [key, value] : map)
+	{
+		keys += key + ",";
+	}
+	EXPECT_EQ(keys, "98,97,96,95,");
+	EXPECT_EQ(map.find("95")->second, 4);
+
+	// references stay valid while the map grows and other keys are erased
+	int& kept = map["95"];
+	for (int i = 0; i < 1000; i++)
+	{
+		map[std::to_string(i + 1000)] = i;
+	}
+	map.erase(map.begin(), map.begin() + 3);
+	EXPECT_EQ(kept, 4);
+	EXPECT_EQ(&kept, &map.find("95")->second);
+
+	luco::ordered_map<int> copy = map;
+	EXPECT_EQ(copy.size(), 1001);
+	EXPECT_NE(&copy.find("95")->second, &kept);
+	luco::ordered_map<int> moved = std::move(map);
+	EXPECT_EQ(&moved.find("95")->second, &kept);
+	EXPECT_TRUE(map.empty());
+}
+
+TEST_F(luco_test, inline_storage)
+{
+	using arena_t = luco::inline_arena<4 * sizeof(int), 1>;
+	arena_t	    arena;
+	auto	    inside = [&arena](const int* data)
+	{ return data >= reinterpret_cast<const int*>(&arena) && data < reinterpret_cast<const int*>(&arena + 1); };
+
+	std::vector<int, luco::inline_allocator<int, arena_t>> small{luco::inline_allocator<int, arena_t>(&arena)};
+	small.reserve(4);
+	small.insert(small.end(), {1, 2, 3, 4});
+	EXPECT_TRUE(inside(small.data()));
+
+	std::vector<int, luco::inline_allocator<int, arena_t>> other{luco::inline_allocator<int, arena_t>(&arena)};
+	other.reserve(4);
+	EXPECT_FALSE(inside(other.data()));
+
+	// growing past the arena moves to the heap and frees the arena for the next container
+	small.push_back(5);
+	EXPECT_FALSE(inside(small.data()));
+	EXPECT_EQ(small[4], 5);
+	std::vector<int, luco::inline_allocator<int, arena_t>> last{luco::inline_allocator<int, arena_t>(&arena)};
+	last.reserve(2);
+	EXPECT_TRUE(inside(last.data()));
+
+	luco::node node = luco::parser::parse(std::string("a {\n\tb = 1\n}\nlist {\n\t1\n\t2\n}\n"));
+	luco::object copy = *node.as_object();
+	copy.insert("c", luco::node(luco::node_type::array));
+	EXPECT_EQ(copy.size(), 3);
+	EXPECT_EQ(node.as_object()->size(), 2);
+	EXPECT_EQ(copy.at("list").as_array()->at(1).as_integer(), 2);
+}
+
 int main(int argc, char** argv)
 {
 	::testing::InitGoogleTest(&argc, argv);
@@ -0,0 +1,905 @@
+/*
+ * Copyright: 2025 nodeluna
+ * SPDX-License-Identifier: Apache-2.0
+ * repository: https://github.com/nodeluna/luco
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <charconv>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <optional>
+#include <random>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <variant>
+#include <vector>
+#include <luco.hpp>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/resource.h>
+#include <unistd.h>
+#endif
+
+template<typename... args_t>
+void println(std::format_string<args_t...> fmt, args_t&&... args)
+{
+	std::string output = std::format(fmt, std::forward<args_t>(args)...);
+	std::cout << output << "\n";
+}
+
+template<typename... args_t>
+void eprintln(std::format_string<args_t...> fmt, args_t&&... args)
+{
+	std::string output = std::format(fmt, std::forward<args_t>(args)...);
+	std::cerr << output << "\n";
+}
+
+const char* usage = R"(usage: luco <command> [options]
+
+commands:
+  validate [-j N] [--utf8] <file>...        parse every file, N at a time (all cores by default). --utf8 also
+                                            rejects keys and values that aren't valid UTF-8
+  fmt [-j N] [--indent tab|N] [--check] <file>...
+                                            rewrite every file in place, formatted. each file is written to a
+                                            temporary file next to it first and renamed over it. files with
+                                            comments or @include are left alone since formatting would drop them
+  get <path> <file>...                      print the value at a path such as: server.ports[0] or "a.b".c. only
+                                            the branch on the path is parsed unless it goes through @include
+  convert --to json|luco [-o out] <file>    convert luco to json or json to luco without loading the whole file
+  bench [-n iterations] <file>              report parse and dump throughput and peak memory
+  codegen [--schema] [--name N] [--namespace NS] [-o out] <file>
+                                            write a C++ header with typed structs, a parser and a serializer for
+                                            a config like file, or for the luco schema in file with --schema
+  embed [--image path] [--name N] [--namespace NS] [-o out] <file>
+                                            compile file into a C++ header holding it as constant data, read
+                                            without parsing. with --image the data is written to path instead
+                                            and the header pulls it in with #embed
+
+validate and get read stdin when the file is -
+)";
+
+struct options {
+		std::vector<std::string> files;
+		size_t			 jobs	    = std::max(1u, std::thread::hardware_concurrency());
+		std::pair<char, size_t>	 indent	    = {' ', 4};
+		bool			 check	    = false;
+		bool			 utf8	    = false;
+		bool			 schema	    = false;
+		std::string		 to;
+		std::string		 output;
+		std::string		 image;
+		std::string		 name	    = "config";
+		std::string		 name_space;
+		size_t			 iterations = 5;
+};
+
+/**
+ * @brief reads the options shared by the commands, everything that isn't an option is a file
+ * @return false if an option is invalid
+ */
+bool parse_options(const std::vector<std::string>& args, options& opts)
+{
+	for (size_t i = 0; i < args.size(); i++)
+	{
+		const std::string& arg	 = args[i];
+		bool		   value = i + 1 < args.size();
+		if ((arg == "-j" || arg == "-n") && value)
+		{
+			char* end    = nullptr;
+			long  number = std::strtol(args[++i].c_str(), &end, 10);
+			if (*end != '\0' || number <= 0)
+			{
+				eprintln("luco: '{}' isn't a positive number", args[i]);
+				return false;
+			}
+			(arg == "-j" ? opts.jobs : opts.iterations) = static_cast<size_t>(number);
+		}
+		else if (arg == "--indent" && value)
+		{
+			const std::string& indent = args[++i];
+			if (indent == "tab")
+			{
+				opts.indent = {'\t', 1};
+			}
+			else if (not indent.empty() && std::all_of(indent.begin(), indent.end(), ::isdigit))
+			{
+				opts.indent = {' ', std::stoul(indent)};
+			}
+			else
+			{
+				eprintln("luco: --indent expects 'tab' or a number of spaces, not '{}'", indent);
+				return false;
+			}
+		}
+		else if (arg == "--to" && value)
+		{
+			opts.to = args[++i];
+		}
+		else if (arg == "-o" && value)
+		{
+			opts.output = args[++i];
+		}
+		else if (arg == "--image" && value)
+		{
+			opts.image = args[++i];
+		}
+		else if (arg == "--name" && value)
+		{
+			opts.name = args[++i];
+		}
+		else if (arg == "--namespace" && value)
+		{
+			opts.name_space = args[++i];
+		}
+		else if (arg == "--schema")
+		{
+			opts.schema = true;
+		}
+		else if (arg == "--check")
+		{
+			opts.check = true;
+		}
+		else if (arg == "--utf8")
+		{
+			opts.utf8 = true;
+		}
+		else if (arg.starts_with("-") && arg != "-")
+		{
+			eprintln("luco: unknown option '{}'", arg);
+			return false;
+		}
+		else
+		{
+			opts.files.push_back(arg);
+		}
+	}
+
+	return true;
+}
+
+/**
+ * @brief runs job(i) for every i in [0, count) on up to jobs threads
+ */
+void parallel_for(size_t count, size_t jobs, const std::function<void(size_t)>& job)
+{
+	std::atomic<size_t>	 next = 0;
+	std::vector<std::thread> threads;
+	for (size_t t = 0; t < std::min(jobs, count); t++)
+	{
+		threads.emplace_back(
+		    [&]()
+		    {
+			    for (size_t i = next++; i < count; i = next++)
+			    {
+				    job(i);
+			    }
+		    });
+	}
+
+	for (auto& thread : threads)
+	{
+		thread.join();
+	}
+}
+
+luco::expected<std::string, luco::error> read_file(const std::filesystem::path& path)
+{
+	std::ifstream file(path, std::ios::binary);
+	if (not file.is_open())
+	{
+		return luco::unexpected(luco::error(luco::error_type::filesystem_error, "couldn't open '{}'", path.string()));
+	}
+
+	return std::string((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+}
+
+/**
+ * @brief writes a file through a temporary file in the same directory, so readers see either the old or the new
+ * content and never a partial one. the temporary file is created exclusively under a random name, and flushed to
+ * disk before it's renamed so a crash can't leave the file empty
+ */
+luco::expected<luco::monostate, luco::error> write_atomically(const std::filesystem::path&			      path,
+							      const std::function<void(const luco::transcoder::output&)>& write)
+{
+	std::random_device    random;
+	std::filesystem::path temp;
+	std::error_code	      ec;
+
+#if defined(__unix__) || defined(__APPLE__)
+	int fd = -1;
+	for (int attempt = 0; fd < 0 && attempt < 16; attempt++)
+	{
+		temp = path;
+		temp += std::format(".{}.{:08x}.tmp", ::getpid(), random());
+		fd = ::open(temp.c_str(), O_WRONLY | O_CREAT | O_EXCL | O_CLOEXEC, 0666);
+		if (fd < 0 && errno != EEXIST)
+		{
+			break;
+		}
+	}
+	if (fd < 0)
+	{
+		return luco::unexpected(luco::error(luco::error_type::filesystem_error, "couldn't create '{}', {}", temp.string(),
+						    std::error_code(errno, std::generic_category()).message()));
+	}
+
+	int  failed = 0;
+	auto output = [&fd, &failed](std::string text)
+	{
+		const char* data = text.data();
+		size_t	    left = text.size();
+		while (left != 0 && failed == 0)
+		{
+			ssize_t written = ::write(fd, data, left);
+			if (written < 0)
+			{
+				failed = errno == EINTR ? 0 : errno;
+				continue;
+			}
+			data += written;
+			left -= static_cast<size_t>(written);
+		}
+	};
+
+	try
+	{
+		write(output);
+	}
+	catch (const luco::error& error)
+	{
+		::close(fd);
+		std::filesystem::remove(temp, ec);
+		return luco::unexpected(error);
+	}
+
+	if (failed == 0 && ::fsync(fd) != 0)
+	{
+		failed = errno;
+	}
+	if (::close(fd) != 0 && failed == 0)
+	{
+		failed = errno;
+	}
+	if (failed != 0)
+	{
+		std::filesystem::remove(temp, ec);
+		return luco::unexpected(luco::error(luco::error_type::filesystem_error, "couldn't write '{}', {}", temp.string(),
+						    std::error_code(failed, std::generic_category()).message()));
+	}
+#else
+	temp = path;
+	temp += std::format(".{:08x}{:08x}.tmp", random(), random());
+
+	std::ofstream file(temp, std::ios::binary | std::ios::trunc);
+	if (not file.is_open())
+	{
+		return luco::unexpected(luco::error(luco::error_type::filesystem_error, "couldn't create '{}'", temp.string()));
+	}
+
+	try
+	{
+		write([&file](std::string text) { file << text; });
+	}
+	catch (const luco::error& error)
+	{
+		file.close();
+		std::filesystem::remove(temp, ec);
+		return luco::unexpected(error);
+	}
+
+	file.close();
+	if (not file)
+	{
+		std::filesystem::remove(temp, ec);
+		return luco::unexpected(luco::error(luco::error_type::filesystem_error, "couldn't write '{}'", temp.string()));
+	}
+#endif
+
+	if (std::filesystem::exists(path, ec))
+	{
+		std::filesystem::permissions(temp, std::filesystem::status(path, ec).permissions(), ec);
+	}
+	std::filesystem::rename(temp, path, ec);
+	if (ec)
+	{
+		std::filesystem::remove(temp, ec);
+		return luco::unexpected(luco::error(luco::error_type::filesystem_error, "couldn't replace '{}', {}", path.string(), ec.message()));
+	}
+
+#if defined(__unix__) || defined(__APPLE__)
+	// the rename itself only survives a crash once the directory is flushed too
+	std::filesystem::path directory = path.parent_path().empty() ? std::filesystem::path(".") : path.parent_path();
+	if (int dir = ::open(directory.c_str(), O_RDONLY | O_CLOEXEC); dir >= 0)
+	{
+		::fsync(dir);
+		::close(dir);
+	}
+#endif
+
+	return luco::monostate();
+}
+
+/**
+ * @brief parses a file given on the command line, "-" is read from stdin. the user picked the file so its @include
+ * values are resolved, within the directory of the file
+ */
+luco::expected<luco::node, luco::error> parse_input(const std::string& file, luco::parse_options options = luco::parse_options())
+{
+	options.allow_includes = true;
+	if (file == "-")
+	{
+		return luco::parser::try_parse_fd(0, luco::parser::default_block_size, options);
+	}
+
+	return luco::parser::try_parse(std::filesystem::path(file), options);
+}
+
+int command_validate(const options& opts)
+{
+	luco::parse_options options;
+	options.validate_utf8 = opts.utf8;
+
+	std::vector<std::string> errors(opts.files.size());
+	parallel_for(opts.files.size(), opts.jobs,
+		     [&](size_t i)
+		     {
+			     auto node = parse_input(opts.files[i], options);
+			     if (not node)
+			     {
+				     errors[i] = node.error().message();
+			     }
+		     });
+
+	int status = 0;
+	for (size_t i = 0; i < opts.files.size(); i++)
+	{
+		if (not errors[i].empty())
+		{
+			eprintln("{}: {}", opts.files[i], errors[i]);
+			status = 1;
+		}
+	}
+
+	return status;
+}
+
+int command_fmt(const options& opts)
+{
+	std::vector<std::string> messages(opts.files.size());
+	std::vector<char>	 failed(opts.files.size(), false);
+	parallel_for(opts.files.size(), opts.jobs,
+		     [&](size_t i)
+		     {
+			     std::filesystem::path path = opts.files[i];
+			     auto		   text = read_file(path);
+			     if (not text)
+			     {
+				     messages[i] = text.error().message();
+				     failed[i]	 = true;
+				     return;
+			     }
+			     else if (text.value().find('#') != std::string::npos || text.value().find("@include") != std::string::npos)
+			     {
+				     messages[i] = "skipped, formatting would drop its comments or inline its @include values";
+				     return;
+			     }
+
+			     auto node = luco::parser::try_parse(text.value());
+			     if (not node)
+			     {
+				     messages[i] = node.error().message();
+				     failed[i]	 = true;
+				     return;
+			     }
+
+			     std::string formatted = node.value().dump_to_string(opts.indent);
+			     if (formatted == text.value())
+			     {
+				     return;
+			     }
+			     else if (opts.check)
+			     {
+				     messages[i] = "isn't formatted";
+				     failed[i]	 = true;
+				     return;
+			     }
+
+			     auto ok = write_atomically(path, [&](const luco::transcoder::output& out) { out(formatted); });
+			     if (not ok)
+			     {
+				     messages[i] = ok.error().message();
+				     failed[i]	 = true;
+			     }
+		     });
+
+	int status = 0;
+	for (size_t i = 0; i < opts.files.size(); i++)
+	{
+		if (not messages[i].empty())
+		{
+			eprintln("{}: {}", opts.files[i], messages[i]);
+		}
+		status |= failed[i];
+	}
+
+	return status;
+}
+
+using path_step = std::variant<std::string, size_t>;
+
+/**
+ * @brief compiles a path such as: server.ports[0] or "a.b".c into its keys and indexes, once for all the files
+ */
+luco::expected<std::vector<path_step>, luco::error> compile_path(std::string_view path)
+{
+	std::vector<path_step> steps;
+	auto		       invalid = [&](std::string_view why)
+	{ return luco::unexpected(luco::error(luco::error_type::key_not_found, "invalid path '{}', {}", path, why)); };
+
+	size_t i = 0;
+	while (i < path.size())
+	{
+		if (path[i] == '[')
+		{
+			size_t closing = path.find(']', i);
+			size_t index   = 0;
+			auto [ptr, ec] = std::from_chars(path.data() + i + 1, path.data() + std::min(closing, path.size()), index);
+			if (closing == std::string_view::npos || ec != std::errc() || ptr != path.data() + closing)
+			{
+				return invalid("expected a number between '[' and ']'");
+			}
+			steps.emplace_back(index);
+			i = closing + 1;
+		}
+		else if (path[i] == '"')
+		{
+			size_t closing = path.find('"', i + 1);
+			if (closing == std::string_view::npos)
+			{
+				return invalid("a quoted key isn't closed");
+			}
+			steps.emplace_back(std::string(path.substr(i + 1, closing - i - 1)));
+			i = closing + 1;
+		}
+		else
+		{
+			size_t end = std::min(path.find_first_of(".[", i), path.size());
+			if (end == i)
+			{
+				return invalid("expected a key");
+			}
+			steps.emplace_back(std::string(path.substr(i, end - i)));
+			i = end;
+		}
+
+		if (i < path.size() && path[i] == '.')
+		{
+			i++;
+			if (i == path.size())
+			{
+				return invalid("expected a key after '.'");
+			}
+		}
+		else if (i < path.size() && path[i] != '[')
+		{
+			return invalid("expected '.' or '[' after a key");
+		}
+	}
+
+	return steps;
+}
+
+/**
+ * @return true if a value in node could be an @include the projection left unresolved
+ */
+bool mentions_include(const luco::node& node)
+{
+	if (node.is_object())
+	{
+		return std::any_of(node.as_object()->begin(), node.as_object()->end(),
+				   [](const auto& pair) { return mentions_include(pair.second); });
+	}
+	else if (node.is_array())
+	{
+		return std::any_of(node.as_array()->begin(), node.as_array()->end(), mentions_include);
+	}
+
+	return node.is_string() && node.as_string().starts_with("@include");
+}
+
+int command_get(const std::vector<std::string>& args)
+{
+	if (args.size() < 2)
+	{
+		eprintln("{}", usage);
+		return 2;
+	}
+
+	auto steps = compile_path(args[0]);
+	if (not steps)
+	{
+		eprintln("luco: {}", steps.error().message());
+		return 2;
+	}
+
+	// only the keys before the first index are parsed, everything else in the file is skipped. a projection doesn't
+	// resolve @include, so when the path isn't found or its branch may hold one, the file is parsed whole the way
+	// validate reads it
+	luco::projection::key_path keys;
+	for (const path_step& step : steps.value())
+	{
+		if (not std::holds_alternative<std::string>(step))
+		{
+			break;
+		}
+		keys.push_back(std::get<std::string>(step));
+	}
+	const luco::projection projection = {keys};
+
+	auto walk = [&steps](luco::node node) -> std::optional<luco::node>
+	{
+		for (const path_step& step : steps.value())
+		{
+			auto next = std::holds_alternative<std::string>(step) ? node.try_at(std::get<std::string>(step))
+									      : node.try_at(std::get<size_t>(step));
+			if (not next)
+			{
+				return std::nullopt;
+			}
+			node = next.value().get();
+		}
+		return node;
+	};
+
+	int status = 0;
+	for (size_t f = 1; f < args.size(); f++)
+	{
+		bool projected = not keys.empty() && args[f] != "-";
+		auto parsed    = projected ? luco::parser::try_parse(std::filesystem::path(args[f]), projection) : parse_input(args[f]);
+		std::optional<luco::node> found;
+		if (parsed)
+		{
+			found = walk(parsed.value());
+		}
+		if (projected && (not parsed || not found || mentions_include(parsed.value())))
+		{
+			parsed = parse_input(args[f]);
+			found  = parsed ? walk(parsed.value()) : std::nullopt;
+		}
+
+		if (not parsed)
+		{
+			eprintln("{}: {}", args[f], parsed.error().message());
+			status = 1;
+		}
+		else if (not found)
+		{
+			eprintln("{}: '{}' wasn't found", args[f], args[0]);
+			status = 1;
+		}
+		else if (found->is_value())
+		{
+			println("{}", found->as_value()->stringify());
+		}
+		else
+		{
+			println("{}", found->dump_to_string());
+		}
+	}
+
+	return status;
+}
+
+int command_convert(const options& opts)
+{
+	if (opts.files.size() != 1)
+	{
+		eprintln("{}", usage);
+		return 2;
+	}
+	else if (opts.to == "binary")
+	{
+		eprintln("luco: the library doesn't have a binary encoding yet, only --to json and --to luco are supported");
+		return 2;
+	}
+	else if (opts.to != "json" && opts.to != "luco")
+	{
+		eprintln("luco: --to expects 'json' or 'luco'");
+		return 2;
+	}
+
+	std::filesystem::path input = opts.files[0];
+	auto		      write = [&](const luco::transcoder::output& out)
+	{
+		if (opts.to == "json")
+		{
+			luco::transcoder::luco_to_json(input, out, opts.indent);
+			out("\n");
+		}
+		else
+		{
+			luco::transcoder::json_to_luco(input, out, opts.indent);
+		}
+	};
+
+	if (not opts.output.empty())
+	{
+		auto ok = write_atomically(opts.output, write);
+		if (not ok)
+		{
+			eprintln("{}: {}", input.string(), ok.error().message());
+			return 1;
+		}
+		return 0;
+	}
+
+	try
+	{
+		write([](std::string text) { std::cout << text; });
+	}
+	catch (const luco::error& error)
+	{
+		std::cout.flush();
+		eprintln("\n{}: {}", input.string(), error.message());
+		return 1;
+	}
+
+	return 0;
+}
+
+int command_codegen(const options& opts)
+{
+	if (opts.files.size() != 1)
+	{
+		eprintln("{}", usage);
+		return 2;
+	}
+
+	luco::expected<luco::schema, luco::error> rules = luco::unexpected(luco::error(luco::error_type::none, ""));
+	if (opts.schema)
+	{
+		rules = luco::schema::try_parse(std::filesystem::path(opts.files[0]));
+	}
+	else if (auto sample = parse_input(opts.files[0]); sample)
+	{
+		rules = luco::schema::infer(sample.value());
+	}
+	else
+	{
+		rules = luco::unexpected(sample.error());
+	}
+
+	if (not rules)
+	{
+		eprintln("{}: {}", opts.files[0], rules.error().message());
+		return 1;
+	}
+
+	auto header = luco::codegen(rules.value(), opts.name, opts.name_space).try_generate();
+	if (not header)
+	{
+		eprintln("{}: {}", opts.files[0], header.error().message());
+		return 1;
+	}
+	else if (opts.output.empty())
+	{
+		std::cout << header.value();
+		return 0;
+	}
+
+	auto ok = write_atomically(opts.output, [&header](const luco::transcoder::output& out) { out(header.value()); });
+	if (not ok)
+	{
+		eprintln("{}: {}", opts.output, ok.error().message());
+		return 1;
+	}
+
+	return 0;
+}
+
+int command_embed(const options& opts)
+{
+	if (opts.files.size() != 1)
+	{
+		eprintln("{}", usage);
+		return 2;
+	}
+
+	auto text = read_file(opts.files[0]);
+	if (not text)
+	{
+		eprintln("{}: {}", opts.files[0], text.error().message());
+		return 1;
+	}
+
+	luco::embed				 embed(text.value(), opts.name, opts.name_space);
+	luco::expected<std::string, luco::error> header =
+	    opts.image.empty() ? embed.try_generate() : embed.try_generate_embed(opts.image);
+	if (header && not opts.image.empty())
+	{
+		auto image = embed.try_image();
+		if (not image)
+		{
+			eprintln("{}: {}", opts.files[0], image.error().message());
+			return 1;
+		}
+
+		auto ok = write_atomically(opts.image, [&image](const luco::transcoder::output& out) { out(image.value()); });
+		if (not ok)
+		{
+			eprintln("{}: {}", opts.image, ok.error().message());
+			return 1;
+		}
+	}
+
+	if (not header)
+	{
+		eprintln("{}: {}", opts.files[0], header.error().message());
+		return 1;
+	}
+	else if (opts.output.empty())
+	{
+		std::cout << header.value();
+		return 0;
+	}
+
+	auto ok = write_atomically(opts.output, [&header](const luco::transcoder::output& out) { out(header.value()); });
+	if (not ok)
+	{
+		eprintln("{}: {}", opts.output, ok.error().message());
+		return 1;
+	}
+
+	return 0;
+}
+
+/**
+ * @return the peak resident memory of the process in bytes, 0 where it isn't available
+ */
+size_t peak_memory()
+{
+#if defined(__unix__) || defined(__APPLE__)
+	struct rusage usage;
+	getrusage(RUSAGE_SELF, &usage);
+#if defined(__APPLE__)
+	return static_cast<size_t>(usage.ru_maxrss);
+#else
+	return static_cast<size_t>(usage.ru_maxrss) * 1024;
+#endif
+#else
+	return 0;
+#endif
+}
+
+int command_bench(const options& opts)
+{
+	if (opts.files.size() != 1)
+	{
+		eprintln("{}", usage);
+		return 2;
+	}
+
+	auto text = read_file(opts.files[0]);
+	if (not text)
+	{
+		eprintln("luco: {}", text.error().message());
+		return 1;
+	}
+
+	using clock	 = std::chrono::steady_clock;
+	double	   bytes = static_cast<double>(text.value().size());
+	size_t	   base	 = peak_memory();
+	luco::node node;
+	auto	   throughput = [&](const std::function<void()>& run)
+	{
+		auto start = clock::now();
+		for (size_t i = 0; i < opts.iterations; i++)
+		{
+			run();
+		}
+		std::chrono::duration<double> elapsed = clock::now() - start;
+		return bytes * static_cast<double>(opts.iterations) / elapsed.count() / (1024 * 1024);
+	};
+
+	auto first = luco::parser::try_parse(text.value());
+	if (not first)
+	{
+		eprintln("{}: {}", opts.files[0], first.error().message());
+		return 1;
+	}
+	size_t tree = peak_memory();
+
+	double parse   = throughput([&]() { node = luco::parser::parse(text.value()); });
+	double dump    = throughput(
+		   [&]()
+		   {
+			   size_t size = 0;
+			   node.dump_to_luco([&size](std::string out) { size += out.size(); });
+		   });
+	double to_json = throughput([&]() { luco::transcoder::luco_to_json(text.value(), [](std::string) {}); });
+
+	println("file:                  {} ({:.2f} MiB, {} iterations)", opts.files[0], bytes / (1024 * 1024), opts.iterations);
+	println("parse:                 {:.2f} MiB/s", parse);
+	println("dump:                  {:.2f} MiB/s", dump);
+	println("streaming to json:     {:.2f} MiB/s", to_json);
+	if (tree != 0)
+	{
+		println("peak memory:           {:.2f} MiB", static_cast<double>(peak_memory()) / (1024 * 1024));
+		println("parsed tree:           {:.2f} MiB ({:.1f}x the file)", static_cast<double>(tree - base) / (1024 * 1024),
+			static_cast<double>(tree - base) / bytes);
+	}
+
+	return 0;
+}
+
+int main(int argc, char* argv[])
+{
+	if (argc < 2)
+	{
+		std::cerr << usage;
+		return 2;
+	}
+
+	std::string		 command = argv[1];
+	std::vector<std::string> args(argv + 2, argv + argc);
+	if (command == "get")
+	{
+		return command_get(args);
+	}
+	else if (command == "help" || command == "--help" || command == "-h")
+	{
+		std::cout << usage;
+		return 0;
+	}
+
+	options opts;
+	if (not parse_options(args, opts))
+	{
+		return 2;
+	}
+	else if (opts.files.empty())
+	{
+		std::cerr << usage;
+		return 2;
+	}
+
+	if (command == "validate")
+	{
+		return command_validate(opts);
+	}
+	else if (command == "fmt")
+	{
+		return command_fmt(opts);
+	}
+	else if (command == "convert")
+	{
+		return command_convert(opts);
+	}
+	else if (command == "bench")
+	{
+		return command_bench(opts);
+	}
+	else if (command == "codegen")
+	{
+		return command_codegen(opts);
+	}
+	else if (command == "embed")
+	{
+		return command_embed(opts);
+	}
+
+	eprintln("luco: unknown command '{}'", command);
+	std::cerr << usage;
+	return 2;
+}
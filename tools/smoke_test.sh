@@ -0,0 +1,90 @@
+#!/bin/sh
+# runs every command of the luco tool once on small files. usage: smoke_test.sh [path to luco]
+
+luco=$(realpath "${1:-./luco}")
+dir=$(mktemp -d)
+trap 'rm -rf "$dir"' EXIT
+cd "$dir" || exit 1
+
+failures=0
+fail()
+{
+	echo "FAILED: $1"
+	failures=$((failures + 1))
+}
+
+# expect <description> <expected output> <command>...
+expect()
+{
+	description=$1
+	expected=$2
+	shift 2
+	actual=$("$@" 2>&1)
+	[ "$actual" = "$expected" ] || fail "$description, expected '$expected', got '$actual'"
+}
+
+# contains <description> <text> <command>...
+contains()
+{
+	description=$1
+	text=$2
+	shift 2
+	case $("$@" 2>&1) in
+		*"$text"*) ;;
+		*) fail "$description, the output doesn't contain '$text'" ;;
+	esac
+}
+
+printf 'name=app\nserver {\nport=80\nhosts {\na\nb\n}\n}\n' > app.luco
+printf 'host = db\nport = 5432\n' > db.luco
+printf 'database = @include "db.luco"\nreplicas {\n\t@include "db.luco"\n}\n' > main.luco
+printf 'a = 1\n}\n' > broken.luco
+printf '# settings\na=1\n' > commented.luco
+
+# validate
+"$luco" validate app.luco main.luco || fail "validate rejects valid files"
+"$luco" validate broken.luco 2> /dev/null && fail "validate accepts an unmatched '}'"
+printf 'a = 1\n' | "$luco" validate - || fail "validate rejects valid stdin"
+
+# fmt
+cp app.luco formatted.luco
+"$luco" fmt formatted.luco || fail "fmt fails"
+"$luco" fmt --check formatted.luco || fail "fmt output isn't formatted"
+"$luco" fmt --check app.luco 2> /dev/null && fail "fmt --check accepts an unformatted file"
+expect "fmt keeps the values" "80" "$luco" get server.port formatted.luco
+cp commented.luco kept.luco
+"$luco" fmt kept.luco 2> /dev/null
+cmp -s commented.luco kept.luco || fail "fmt rewrites a file with comments"
+ls ./*.tmp > /dev/null 2>&1 && fail "fmt leaves temporary files behind"
+
+# get
+expect "get a value" "80" "$luco" get server.port app.luco
+expect "get an index" "b" "$luco" get 'server.hosts[1]' app.luco
+expect "get through @include" "5432" "$luco" get database.port main.luco
+expect "get through @include in an array" "db" "$luco" get 'replicas[0].host' main.luco
+"$luco" get server.missing app.luco 2> /dev/null && fail "get finds a missing key"
+expect "get from stdin" "1" sh -c "printf 'a = 1\n' | '$luco' get a -"
+
+# convert
+contains "convert to json" '"port": 80' "$luco" convert --to json app.luco
+"$luco" convert --to json -o app.json app.luco || fail "convert -o fails"
+"$luco" convert --to luco -o back.luco app.json || fail "convert back to luco fails"
+expect "convert round trip" "80" "$luco" get server.port back.luco
+
+# bench
+contains "bench" "parse:" "$luco" bench -n 1 app.luco
+
+# codegen
+contains "codegen" "struct settings" "$luco" codegen --name settings app.luco
+"$luco" codegen --name settings -o settings.hpp app.luco && [ -s settings.hpp ] || fail "codegen -o writes nothing"
+
+# embed
+contains "embed" "defaults()" "$luco" embed --name defaults app.luco
+"$luco" embed --name defaults --image defaults.bin -o defaults.hpp app.luco && [ -s defaults.bin ] && [ -s defaults.hpp ] ||
+	fail "embed --image writes nothing"
+
+if [ "$failures" -ne 0 ]; then
+	echo "$failures smoke test(s) failed"
+	exit 1
+fi
+echo "all smoke tests passed"